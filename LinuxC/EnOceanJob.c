@@ -212,32 +212,16 @@ readTimeData(void *handle, const UA_NodeId nodeId, UA_Boolean sourceTimeStamp,
 
 static void
 writeVariable(UA_Server *server, double data, char *idName) {
-	UA_NodeId myDoubleNodeId = UA_NODEID_STRING(1, idName);
-
-	/* Write a different integer value */
+	/* Set the new value together with a good status code. Readers
+	 * never see an intermediate state of the variable. */
 	UA_Double myDouble = data;
-	UA_Variant myVar;
-	UA_Variant_init(&myVar);
-	UA_Variant_setScalar(&myVar, &myDouble, &UA_TYPES[UA_TYPES_DOUBLE]);
-	UA_Server_writeValue(server, myDoubleNodeId, myVar);
-
-	/* Set the status code of the value to an error code. The function
-	* UA_Server_write provides access to the raw service. The above
-	* UA_Server_writeValue is syntactic sugar for writing a specific node
-	* attribute with the write service. */
-	UA_WriteValue wv;
-	UA_WriteValue_init(&wv);
-	wv.nodeId = myDoubleNodeId;
-	wv.attributeId = UA_ATTRIBUTEID_VALUE;
-	wv.value.status = UA_STATUSCODE_BADNOTCONNECTED;
-	wv.value.hasStatus = true;
-	UA_Server_write(server, &wv);
-
-	/* Reset the variable to a good statuscode with a value */
-	wv.value.hasStatus = false;
-	wv.value.value = myVar;
-	wv.value.hasValue = true;
-	UA_Server_write(server, &wv);
+	UA_ValueUpdate update;
+	update.nodeId = UA_NODEID_STRING(1, idName);
+	update.handle = NULL;
+	UA_Variant_setScalar(&update.value, &myDouble, &UA_TYPES[UA_TYPES_DOUBLE]);
+	update.status = UA_STATUSCODE_GOOD;
+	update.sourceTimestamp = 0; /* now */
+	UA_Server_updateValues(server, 1, &update, NULL);
 }
 
 static void
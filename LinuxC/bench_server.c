@@ -0,0 +1,479 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+*  License, v. 2.0. If a copy of the MPL was not distributed with this
+*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
+
+/**
+ * Benchmarks of the server internals. The internal definitions are used to
+ * drive the server without a network connection. All benchmarks run if no
+ * name is given.
+ *
+ * Usage: make bench
+ *        ./bench_server [read] [nodestore] [range] */
+
+#include "open62541.c"
+
+static UA_Double
+elapsedNs(UA_DateTime start) {
+    return (UA_Double)(UA_DateTime_nowMonotonic() - start) * 100.0;
+}
+
+static UA_Server *
+newServer(void) {
+    UA_ServerConfig config = UA_ServerConfig_standard;
+    config.logger = NULL;
+    return UA_Server_new(config);
+}
+
+/* Pseudo-random numbers that are the same on every platform */
+static UA_UInt32 randomState = 1;
+
+static UA_UInt32
+nextRandom(void) {
+    randomState = randomState * 1103515245 + 12345;
+    return randomState >> 8;
+}
+
+/*****************/
+/* Read requests */
+/*****************/
+
+#define READ_ITEMS 10000
+#define READ_NODES 200000
+#define READ_ROUNDS 50
+
+/* Adds the variables with numeric NodeIds (1, 100000+i) or string NodeIds
+ * (1, "device<i>.value") */
+static UA_NodeId *
+addReadVariables(UA_Server *server, UA_Boolean stringIds) {
+    UA_NodeId *ids = (UA_NodeId*)UA_Array_new(READ_NODES, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_VariableAttributes attr;
+    UA_VariableAttributes_init(&attr);
+    char name[32];
+    for(UA_UInt32 i = 0; i < READ_NODES; ++i) {
+        UA_Int32 v = (UA_Int32)i;
+        UA_Variant_setScalar(&attr.value, &v, &UA_TYPES[UA_TYPES_INT32]);
+        snprintf(name, sizeof(name), "device%u.value", (unsigned)i);
+        if(stringIds)
+            ids[i] = UA_NODEID_STRING_ALLOC(1, name);
+        else
+            ids[i] = UA_NODEID_NUMERIC(1, 100000 + i);
+        UA_Server_addVariableNode(server, ids[i], UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                                  UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT),
+                                  UA_QUALIFIEDNAME(1, name), UA_NODEID_NULL,
+                                  attr, NULL, NULL);
+    }
+    return ids;
+}
+
+static void
+benchReadIds(UA_Boolean stringIds) {
+    UA_Server *server = newServer();
+    UA_NodeId *ids = addReadVariables(server, stringIds);
+
+    /* Read random items of the variables */
+    UA_ReadValueId *items = (UA_ReadValueId*)UA_malloc(READ_ITEMS * sizeof(UA_ReadValueId));
+    for(size_t i = 0; i < READ_ITEMS; ++i) {
+        UA_ReadValueId_init(&items[i]);
+        items[i].nodeId = ids[nextRandom() % READ_NODES];
+        items[i].attributeId = UA_ATTRIBUTEID_VALUE;
+    }
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    request.nodesToRead = items;
+    request.nodesToReadSize = READ_ITEMS;
+    request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+
+    /* The Read service looks up the nodes in prefetching batches */
+    size_t bad = 0;
+    UA_DateTime start = UA_DateTime_nowMonotonic();
+    for(size_t r = 0; r < READ_ROUNDS; ++r) {
+        UA_ReadResponse response;
+        UA_ReadResponse_init(&response);
+        UA_RCU_LOCK();
+        Service_Read(server, &adminSession, &request, &response);
+        UA_RCU_UNLOCK();
+        for(size_t i = 0; i < response.resultsSize; ++i)
+            bad += !response.results[i].hasValue;
+        UA_ReadResponse_deleteMembers(&response);
+    }
+    UA_Double batched = elapsedNs(start) / (READ_ROUNDS * READ_ITEMS);
+
+    /* One lookup after the other */
+    start = UA_DateTime_nowMonotonic();
+    for(size_t r = 0; r < READ_ROUNDS; ++r) {
+        UA_RCU_LOCK();
+        for(size_t i = 0; i < READ_ITEMS; ++i) {
+            UA_DataValue v;
+            UA_DataValue_init(&v);
+            Service_Read_single(server, &adminSession, UA_TIMESTAMPSTORETURN_NEITHER,
+                                0.0, &items[i], &v);
+            bad += !v.hasValue;
+            UA_DataValue_deleteMembers(&v);
+        }
+        UA_RCU_UNLOCK();
+    }
+    UA_Double single = elapsedNs(start) / (READ_ROUNDS * READ_ITEMS);
+
+    printf("read %s ids: %u of %u nodes, Read %.0f ns/item, "
+           "Read_single %.0f ns/item, bad %u\n", stringIds ? "string" : "numeric",
+           READ_ITEMS, READ_NODES, batched, single, (unsigned)bad);
+    UA_free(items); /* The NodeIds belong to ids */
+    UA_Array_delete(ids, READ_NODES, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_Server_delete(server);
+}
+
+static void
+benchRead(void) {
+    benchReadIds(false);
+    benchReadIds(true);
+}
+
+/*************/
+/* Nodestore */
+/*************/
+
+/* The hash map of the nodestore before the open-addressing table: double
+ * hashing over a prime-sized table with tombstones. Only the parts that are
+ * needed for the comparison. */
+
+typedef struct {
+    UA_Node **entries;
+    UA_UInt32 size;
+    UA_UInt32 count;
+} PrimeTable;
+
+#define PRIMETABLE_TOMBSTONE ((UA_Node*)0x01)
+
+static UA_UInt32 const primes[] = {
+    7,         13,         31,         61,         127,         251,
+    509,       1021,       2039,       4093,       8191,        16381,
+    32749,     65521,      131071,     262139,     524287,      1048573,
+    2097143,   4194301,    8388593,    16777213,   33554393,    67108859,
+    134217689, 268435399,  536870909,  1073741789, 2147483647,  4294967291
+};
+
+static UA_UInt32 mod(UA_UInt32 h, UA_UInt32 size) { return h % size; }
+static UA_UInt32 mod2(UA_UInt32 h, UA_UInt32 size) { return 1 + (h % (size - 2)); }
+
+static UA_UInt32
+higherPrime(UA_UInt32 n) {
+    size_t i = 0;
+    while(primes[i] < n)
+        ++i;
+    return primes[i];
+}
+
+static UA_Node **
+PrimeTable_findNode(const PrimeTable *t, const UA_NodeId *nodeid) {
+    UA_UInt32 h = UA_NodeId_hash(nodeid);
+    UA_UInt32 idx = mod(h, t->size);
+    UA_UInt32 hash2 = mod2(h, t->size);
+    while(true) {
+        UA_Node *e = t->entries[idx];
+        if(!e)
+            return NULL;
+        if(e > PRIMETABLE_TOMBSTONE && UA_NodeId_equal(&e->nodeId, nodeid))
+            return &t->entries[idx];
+        idx += hash2;
+        if(idx >= t->size)
+            idx -= t->size;
+    }
+}
+
+static UA_Node **
+PrimeTable_findSlot(const PrimeTable *t, const UA_NodeId *nodeid) {
+    UA_UInt32 h = UA_NodeId_hash(nodeid);
+    UA_UInt32 idx = mod(h, t->size);
+    UA_UInt32 hash2 = mod2(h, t->size);
+    while(true) {
+        UA_Node *e = t->entries[idx];
+        if(e > PRIMETABLE_TOMBSTONE && UA_NodeId_equal(&e->nodeId, nodeid))
+            return NULL;
+        if(e <= PRIMETABLE_TOMBSTONE)
+            return &t->entries[idx];
+        idx += hash2;
+        if(idx >= t->size)
+            idx -= t->size;
+    }
+}
+
+static void
+PrimeTable_expand(PrimeTable *t) {
+    UA_UInt32 count = t->count;
+    if(count * 2 < t->size && (count * 8 > t->size || t->size <= 64))
+        return;
+    UA_Node **oentries = t->entries;
+    UA_UInt32 osize = t->size;
+    t->size = higherPrime(count * 2);
+    t->entries = (UA_Node**)UA_calloc(t->size, sizeof(UA_Node*));
+    for(size_t i = 0, j = 0; i < osize && j < count; ++i) {
+        if(oentries[i] <= PRIMETABLE_TOMBSTONE)
+            continue;
+        *PrimeTable_findSlot(t, &oentries[i]->nodeId) = oentries[i];
+        ++j;
+    }
+    UA_free(oentries);
+}
+
+static void
+PrimeTable_init(PrimeTable *t) {
+    t->size = higherPrime(64);
+    t->count = 0;
+    t->entries = (UA_Node**)UA_calloc(t->size, sizeof(UA_Node*));
+}
+
+static void
+PrimeTable_insert(PrimeTable *t, UA_Node *node) {
+    if(t->size * 3 <= t->count * 4)
+        PrimeTable_expand(t);
+    UA_Node **slot = PrimeTable_findSlot(t, &node->nodeId);
+    if(!slot) {
+        UA_NodeStore_deleteNode(node);
+        return;
+    }
+    *slot = node;
+    ++t->count;
+}
+
+static const UA_Node *
+PrimeTable_get(PrimeTable *t, const UA_NodeId *nodeid) {
+    UA_Node **slot = PrimeTable_findNode(t, nodeid);
+    return slot ? *slot : NULL;
+}
+
+static void
+PrimeTable_remove(PrimeTable *t, const UA_NodeId *nodeid) {
+    UA_Node **slot = PrimeTable_findNode(t, nodeid);
+    if(!slot)
+        return;
+    UA_NodeStore_deleteNode(*slot);
+    *slot = PRIMETABLE_TOMBSTONE;
+    --t->count;
+    if(t->count * 8 < t->size && t->size > 32)
+        PrimeTable_expand(t);
+}
+
+static void
+PrimeTable_deleteMembers(PrimeTable *t) {
+    for(UA_UInt32 i = 0; i < t->size; ++i) {
+        if(t->entries[i] > PRIMETABLE_TOMBSTONE)
+            UA_NodeStore_deleteNode(t->entries[i]);
+    }
+    UA_free(t->entries);
+}
+
+#define NODESTORE_NODES 150000
+#define NODESTORE_LOOKUPS 1000000
+
+/* Node i has the numeric NodeId (1, i+1) for even i and the string NodeId
+ * (1, "node<i>") for odd i. Missing NodeIds use the same scheme shifted by
+ * the number of nodes. */
+static UA_NodeId
+nodestoreId(UA_UInt32 i) {
+    if(i % 2 == 0)
+        return UA_NODEID_NUMERIC(1, i + 1); /* (1, 0) is the null NodeId */
+    char name[32];
+    snprintf(name, sizeof(name), "node%u", (unsigned)i);
+    return UA_NODEID_STRING_ALLOC(1, name);
+}
+
+static UA_Node *
+nodestoreNode(const UA_NodeId *id) {
+    UA_Node *node = UA_NodeStore_newNode(UA_NODECLASS_OBJECT);
+    UA_NodeId_copy(id, &node->nodeId);
+    return node;
+}
+
+/* Runs the same operations on both tables. The other table is used when
+ * prime is set. */
+static void
+benchNodestoreTable(UA_Boolean prime, UA_NodeId *ids, UA_NodeId *missing,
+                    UA_UInt32 *order, UA_Double *ns) {
+    UA_NodeStore *store = NULL;
+    PrimeTable table;
+    if(prime)
+        PrimeTable_init(&table);
+    else
+        store = UA_NodeStore_new();
+
+    /* Insert */
+    UA_DateTime start = UA_DateTime_nowMonotonic();
+    for(UA_UInt32 i = 0; i < NODESTORE_NODES; ++i) {
+        UA_Node *node = nodestoreNode(&ids[i]);
+        if(prime)
+            PrimeTable_insert(&table, node);
+        else
+            UA_NodeStore_insert(store, node);
+    }
+    ns[0] = elapsedNs(start) / NODESTORE_NODES;
+
+    /* Churn: remove a node and insert it again. Leaves tombstones in the
+     * prime-sized table. */
+    start = UA_DateTime_nowMonotonic();
+    for(UA_UInt32 i = 0; i < NODESTORE_NODES; ++i) {
+        const UA_NodeId *id = &ids[order[i]];
+        if(prime) {
+            PrimeTable_remove(&table, id);
+            PrimeTable_insert(&table, nodestoreNode(id));
+        } else {
+            UA_NodeStore_remove(store, id);
+            UA_NodeStore_insert(store, nodestoreNode(id));
+        }
+    }
+    ns[1] = elapsedNs(start) / NODESTORE_NODES;
+
+    /* Lookups of existing numeric and string NodeIds and of missing ones */
+    size_t found[3] = {0, 0, 0};
+    for(size_t k = 0; k < 3; ++k) {
+        start = UA_DateTime_nowMonotonic();
+        for(UA_UInt32 i = 0; i < NODESTORE_LOOKUPS; ++i) {
+            UA_UInt32 j = order[i % NODESTORE_NODES];
+            if(k < 2)
+                j = (j & ~(UA_UInt32)1) | (UA_UInt32)k;
+            const UA_NodeId *id = (k < 2) ? &ids[j] : &missing[j];
+            const UA_Node *node = prime ? PrimeTable_get(&table, id) :
+                UA_NodeStore_get(store, id);
+            found[k] += (node != NULL);
+        }
+        ns[2 + k] = elapsedNs(start) / NODESTORE_LOOKUPS;
+    }
+    if(found[0] != NODESTORE_LOOKUPS || found[1] != NODESTORE_LOOKUPS || found[2] != 0)
+        printf("nodestore: unexpected lookup results\n");
+
+    if(prime)
+        PrimeTable_deleteMembers(&table);
+    else
+        UA_NodeStore_delete(store);
+}
+
+static void
+benchNodestore(void) {
+    UA_NodeId *ids = (UA_NodeId*)UA_Array_new(NODESTORE_NODES, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_NodeId *missing = (UA_NodeId*)UA_Array_new(NODESTORE_NODES, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_UInt32 *order = (UA_UInt32*)UA_malloc(NODESTORE_NODES * sizeof(UA_UInt32));
+    for(UA_UInt32 i = 0; i < NODESTORE_NODES; ++i) {
+        ids[i] = nodestoreId(i);
+        missing[i] = nodestoreId(NODESTORE_NODES + i);
+        order[i] = i;
+    }
+    for(UA_UInt32 i = NODESTORE_NODES - 1; i > 0; --i) {
+        UA_UInt32 j = nextRandom() % (i + 1);
+        UA_UInt32 tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    static const char *ops[] = {"insert", "remove+insert", "get numeric",
+                                "get string", "get missing"};
+    UA_Double current[5], prime[5];
+    benchNodestoreTable(false, ids, missing, order, current);
+    benchNodestoreTable(true, ids, missing, order, prime);
+    printf("nodestore: %u nodes, ns/op       open-addressing  prime-sized\n",
+           (unsigned)NODESTORE_NODES);
+    for(size_t i = 0; i < 5; ++i)
+        printf("  %-28s %15.0f %12.0f\n", ops[i], current[i], prime[i]);
+
+    UA_free(order);
+    UA_Array_delete(missing, NODESTORE_NODES, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_Array_delete(ids, NODESTORE_NODES, &UA_TYPES[UA_TYPES_NODEID]);
+}
+
+/******************/
+/* Variant ranges */
+/******************/
+
+#define RANGE_ROUNDS 20000
+
+/* A matrix of rows x columns elements. The data is not initialised. */
+static void
+rangeMatrix(UA_Variant *v, const UA_DataType *type, UA_UInt32 rows, UA_UInt32 columns) {
+    UA_Variant_setArray(v, UA_calloc((size_t)rows * columns, type->memSize),
+                        (size_t)rows * columns, type);
+    v->arrayDimensions = (UA_UInt32*)UA_Array_new(2, &UA_TYPES[UA_TYPES_UINT32]);
+    v->arrayDimensionsSize = 2;
+    v->arrayDimensions[0] = rows;
+    v->arrayDimensions[1] = columns;
+}
+
+static void
+benchRangeCase(const char *name, UA_Variant *v, UA_NumericRangeDimension *dims,
+               size_t dimsSize) {
+    UA_NumericRange range = {dimsSize, dims};
+
+    /* Read the range */
+    UA_Variant out;
+    UA_DateTime start = UA_DateTime_nowMonotonic();
+    for(size_t r = 0; r < RANGE_ROUNDS; ++r) {
+        UA_Variant_copyRange(v, &out, range);
+        UA_Variant_deleteMembers(&out);
+    }
+    UA_Double read = elapsedNs(start) / RANGE_ROUNDS;
+
+    /* Write the range back */
+    UA_Variant_copyRange(v, &out, range);
+    start = UA_DateTime_nowMonotonic();
+    for(size_t r = 0; r < RANGE_ROUNDS; ++r)
+        UA_Variant_setRangeCopy(v, out.data, out.arrayLength, range);
+    UA_Double write = elapsedNs(start) / RANGE_ROUNDS;
+    UA_Variant_deleteMembers(&out);
+
+    printf("  %-32s %10.0f %10.0f\n", name, read, write);
+}
+
+static void
+benchRange(void) {
+    printf("range: ns/call                    copyRange   setRange\n");
+
+    UA_Variant v;
+    UA_Variant_init(&v);
+    UA_Variant_setArray(&v, UA_calloc(100000, sizeof(UA_Double)), 100000,
+                        &UA_TYPES[UA_TYPES_DOUBLE]);
+    UA_NumericRangeDimension slice[1] = {{1000, 1999}};
+    benchRangeCase("1-D slice of 1000 Double", &v, slice, 1);
+    UA_Variant_deleteMembers(&v);
+
+    rangeMatrix(&v, &UA_TYPES[UA_TYPES_DOUBLE], 1000, 100);
+    UA_NumericRangeDimension rows[2] = {{100, 109}, {0, 99}};
+    benchRangeCase("10 full rows of 1000x100 Double", &v, rows, 2);
+    UA_NumericRangeDimension column[2] = {{0, 499}, {7, 7}};
+    benchRangeCase("column of 500 rows of 1000x100", &v, column, 2);
+    UA_Variant_deleteMembers(&v);
+
+    rangeMatrix(&v, &UA_TYPES[UA_TYPES_INT16], 1000, 8);
+    UA_NumericRangeDimension block[2] = {{0, 999}, {2, 3}};
+    benchRangeCase("1000x2 block of 1000x8 Int16", &v, block, 2);
+    UA_Variant_deleteMembers(&v);
+
+    /* The blocks are not evenly spaced */
+    UA_Variant_setArray(&v, UA_calloc(100000, sizeof(UA_Double)), 100000,
+                        &UA_TYPES[UA_TYPES_DOUBLE]);
+    v.arrayDimensions = (UA_UInt32*)UA_Array_new(3, &UA_TYPES[UA_TYPES_UINT32]);
+    v.arrayDimensionsSize = 3;
+    v.arrayDimensions[0] = 100;
+    v.arrayDimensions[1] = 100;
+    v.arrayDimensions[2] = 10;
+    UA_NumericRangeDimension cube[3] = {{0, 49}, {10, 19}, {2, 5}};
+    benchRangeCase("50x10x4 of 100x100x10 Double", &v, cube, 3);
+    UA_Variant_deleteMembers(&v);
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} benchmarks[] = {
+    {"read", benchRead},
+    {"nodestore", benchNodestore},
+    {"range", benchRange}
+};
+
+int main(int argc, char **argv) {
+    size_t count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+    for(size_t i = 0; i < count; ++i) {
+        UA_Boolean selected = (argc < 2);
+        for(int j = 1; j < argc; ++j)
+            selected |= (strcmp(argv[j], benchmarks[i].name) == 0);
+        if(selected)
+            benchmarks[i].run();
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,734 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+*  License, v. 2.0. If a copy of the MPL was not distributed with this
+*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
+
+/**
+ * Checks of server behaviour that is not covered by the examples. The
+ * internal definitions are used to drive the server without a network
+ * connection.
+ *
+ * Usage: make check */
+
+#include "open62541.c"
+
+static int failures = 0;
+
+#define CHECK(cond) do {                                                \
+        if(!(cond)) {                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++failures;                                                 \
+        }                                                               \
+    } while(0)
+
+static UA_Server *
+newServer(void) {
+    UA_ServerConfig config = UA_ServerConfig_standard;
+    config.logger = NULL;
+    return UA_Server_new(config);
+}
+
+static UA_NodeId
+addInt32Variable(UA_Server *server, UA_UInt32 id, const char *name, UA_Int32 v) {
+    UA_VariableAttributes attr;
+    UA_VariableAttributes_init(&attr);
+    UA_Variant_setScalar(&attr.value, &v, &UA_TYPES[UA_TYPES_INT32]);
+    attr.dataType = UA_TYPES[UA_TYPES_INT32].typeId;
+    attr.valueRank = -1;
+    attr.displayName = UA_LOCALIZEDTEXT("en_US", (char*)(uintptr_t)name);
+    UA_NodeId nodeId = UA_NODEID_NUMERIC(1, id);
+    UA_StatusCode retval =
+        UA_Server_addVariableNode(server, nodeId, UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                                  UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                                  UA_QUALIFIEDNAME(1, (char*)(uintptr_t)name),
+                                  UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                                  attr, NULL, NULL);
+    CHECK(retval == UA_STATUSCODE_GOOD);
+    return nodeId;
+}
+
+static UA_DataValue
+readValue(UA_Server *server, UA_NodeId nodeId) {
+    UA_ReadValueId rvi;
+    UA_ReadValueId_init(&rvi);
+    rvi.nodeId = nodeId;
+    rvi.attributeId = UA_ATTRIBUTEID_VALUE;
+    return UA_Server_read(server, &rvi, UA_TIMESTAMPSTORETURN_SOURCE);
+}
+
+/* A status-only update keeps the value of the variable */
+static void
+checkUpdateStatusOnly(void) {
+    UA_Server *server = newServer();
+    UA_NodeId nodeId = addInt32Variable(server, 1000, "status", 42);
+
+    UA_ValueUpdate update;
+    memset(&update, 0, sizeof(update));
+    update.nodeId = nodeId;
+    update.status = UA_STATUSCODE_BADCOMMUNICATIONERROR;
+    UA_StatusCode result;
+    CHECK(UA_Server_updateValues(server, 1, &update, &result) == UA_STATUSCODE_GOOD);
+    CHECK(result == UA_STATUSCODE_GOOD);
+
+    UA_DataValue dv = readValue(server, nodeId);
+    CHECK(dv.hasValue && dv.value.type == &UA_TYPES[UA_TYPES_INT32]);
+    CHECK(dv.hasValue && dv.value.data && *(UA_Int32*)dv.value.data == 42);
+    CHECK(dv.hasStatus && dv.status == UA_STATUSCODE_BADCOMMUNICATIONERROR);
+    CHECK(dv.hasSourceTimestamp);
+    UA_DataValue_deleteMembers(&dv);
+
+    UA_Server_delete(server);
+}
+
+/* Writing the BrowseName leaves the DisplayName unchanged. With
+ * UA_ENABLE_COMPACT_NODES, a DisplayName that equals the BrowseName is not
+ * stored separately. */
+static void
+checkWriteBrowseName(void) {
+    UA_Server *server = newServer();
+    UA_NodeId nodeId = addInt32Variable(server, 1001, "original", 1);
+
+    UA_QualifiedName renamed = UA_QUALIFIEDNAME(1, "renamed");
+    CHECK(UA_Server_writeBrowseName(server, nodeId, renamed) == UA_STATUSCODE_GOOD);
+
+    UA_QualifiedName browseName;
+    CHECK(UA_Server_readBrowseName(server, nodeId, &browseName) == UA_STATUSCODE_GOOD);
+    CHECK(UA_String_equal(&browseName.name, &renamed.name));
+    UA_QualifiedName_deleteMembers(&browseName);
+
+    UA_LocalizedText displayName;
+    UA_String original = UA_STRING("original");
+    UA_String locale = UA_STRING("en_US");
+    CHECK(UA_Server_readDisplayName(server, nodeId, &displayName) == UA_STATUSCODE_GOOD);
+    CHECK(UA_String_equal(&displayName.text, &original));
+    CHECK(UA_String_equal(&displayName.locale, &locale));
+    UA_LocalizedText_deleteMembers(&displayName);
+
+    /* Also for the nodes of namespace 0 */
+    UA_NodeId objects = UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER);
+    CHECK(UA_Server_writeBrowseName(server, objects, renamed) == UA_STATUSCODE_GOOD);
+    UA_String objectsName = UA_STRING("Objects");
+    CHECK(UA_Server_readDisplayName(server, objects, &displayName) == UA_STATUSCODE_GOOD);
+    CHECK(UA_String_equal(&displayName.text, &objectsName));
+    UA_LocalizedText_deleteMembers(&displayName);
+
+    UA_Server_delete(server);
+}
+
+/* Number of forward references from source to target */
+static size_t
+countReferences(UA_Server *server, UA_NodeId source, UA_NodeId target) {
+    size_t count = 0;
+    UA_RCU_LOCK();
+    const UA_Node *node = UA_NodeStore_get(server->nodestore, &source);
+    for(size_t i = 0; node && i < node->referencesSize; ++i) {
+        if(!node->references[i].isInverse &&
+           UA_NodeId_equal(&node->references[i].targetId.nodeId, &target))
+            ++count;
+    }
+    UA_RCU_UNLOCK();
+    return count;
+}
+
+static UA_StatusCode
+addObject(UA_Server *server, UA_NodeId nodeId, UA_NodeId typeDefinition) {
+    UA_ObjectAttributes attr;
+    UA_ObjectAttributes_init(&attr);
+    attr.displayName = UA_LOCALIZEDTEXT("en_US", "object");
+    return UA_Server_addObjectNode(server, nodeId, UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+                                   UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+                                   UA_QUALIFIEDNAME(1, "object"), typeDefinition,
+                                   attr, NULL, NULL);
+}
+
+/* A node deleted without its references can be added again. The reference
+ * left in the parent is reused. */
+static void
+checkReAddNode(void) {
+    UA_Server *server = newServer();
+    UA_NodeId objects = UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER);
+    UA_NodeId nodeId = UA_NODEID_NUMERIC(1, 2000);
+    CHECK(addObject(server, nodeId, UA_NODEID_NULL) == UA_STATUSCODE_GOOD);
+    CHECK(UA_Server_deleteNode(server, nodeId, false) == UA_STATUSCODE_GOOD);
+    CHECK(countReferences(server, objects, nodeId) == 1);
+    CHECK(addObject(server, nodeId, UA_NODEID_NULL) == UA_STATUSCODE_GOOD);
+    CHECK(countReferences(server, objects, nodeId) == 1);
+
+    /* The same with the services */
+    UA_DeleteNodesItem deleteItem;
+    UA_DeleteNodesItem_init(&deleteItem);
+    deleteItem.nodeId = nodeId;
+    deleteItem.deleteTargetReferences = false;
+    UA_DeleteNodesRequest deleteRequest;
+    UA_DeleteNodesRequest_init(&deleteRequest);
+    deleteRequest.nodesToDeleteSize = 1;
+    deleteRequest.nodesToDelete = &deleteItem;
+    UA_DeleteNodesResponse deleteResponse;
+    UA_DeleteNodesResponse_init(&deleteResponse);
+    UA_RCU_LOCK();
+    Service_DeleteNodes(server, &adminSession, &deleteRequest, &deleteResponse);
+    UA_RCU_UNLOCK();
+    CHECK(deleteResponse.resultsSize == 1 &&
+          deleteResponse.results[0] == UA_STATUSCODE_GOOD);
+    UA_DeleteNodesResponse_deleteMembers(&deleteResponse);
+
+    UA_ObjectAttributes attr;
+    UA_ObjectAttributes_init(&attr);
+    attr.displayName = UA_LOCALIZEDTEXT("en_US", "object");
+    UA_AddNodesItem addItem;
+    UA_AddNodesItem_init(&addItem);
+    addItem.parentNodeId.nodeId = objects;
+    addItem.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES);
+    addItem.requestedNewNodeId.nodeId = nodeId;
+    addItem.browseName = UA_QUALIFIEDNAME(1, "object");
+    addItem.nodeClass = UA_NODECLASS_OBJECT;
+    addItem.nodeAttributes.encoding = UA_EXTENSIONOBJECT_DECODED_NODELETE;
+    addItem.nodeAttributes.content.decoded.type = &UA_TYPES[UA_TYPES_OBJECTATTRIBUTES];
+    addItem.nodeAttributes.content.decoded.data = &attr;
+    UA_AddNodesRequest addRequest;
+    UA_AddNodesRequest_init(&addRequest);
+    addRequest.nodesToAddSize = 1;
+    addRequest.nodesToAdd = &addItem;
+    UA_AddNodesResponse addResponse;
+    UA_AddNodesResponse_init(&addResponse);
+    UA_RCU_LOCK();
+    Service_AddNodes(server, &adminSession, &addRequest, &addResponse);
+    UA_RCU_UNLOCK();
+    CHECK(addResponse.resultsSize == 1 &&
+          addResponse.results[0].statusCode == UA_STATUSCODE_GOOD);
+    UA_AddNodesResponse_deleteMembers(&addResponse);
+    CHECK(countReferences(server, objects, nodeId) == 1);
+
+    UA_Server_delete(server);
+}
+
+/* Aliases handed out by RegisterNodes are accepted by the node management
+ * services. The nodes store the original NodeIds. */
+static void
+checkRegisteredNodeManagement(void) {
+    UA_Server *server = newServer();
+    UA_NodeId parent = UA_NODEID_STRING(1, "parent");
+    UA_NodeId child = UA_NODEID_STRING(1, "child");
+    UA_NodeId grandChild = UA_NODEID_STRING(1, "grandchild");
+    CHECK(addObject(server, parent, UA_NODEID_NULL) == UA_STATUSCODE_GOOD);
+    CHECK(addObject(server, child, UA_NODEID_NULL) == UA_STATUSCODE_GOOD);
+
+    UA_Session session;
+    UA_Session_init(&session);
+    UA_NodeId parentAlias, childAlias;
+    CHECK(UA_Session_registerNode(&session, &parent, &parentAlias) == UA_STATUSCODE_GOOD);
+    CHECK(UA_Session_registerNode(&session, &child, &childAlias) == UA_STATUSCODE_GOOD);
+    CHECK(parentAlias.namespaceIndex == UA_REGISTEREDNODES_NAMESPACE);
+    CHECK(childAlias.namespaceIndex == UA_REGISTEREDNODES_NAMESPACE);
+
+    /* AddReferences */
+    UA_AddReferencesItem addRefItem;
+    UA_AddReferencesItem_init(&addRefItem);
+    addRefItem.sourceNodeId = parentAlias;
+    addRefItem.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT);
+    addRefItem.isForward = true;
+    addRefItem.targetNodeId.nodeId = childAlias;
+    addRefItem.targetNodeClass = UA_NODECLASS_OBJECT;
+    UA_AddReferencesRequest addRefRequest;
+    UA_AddReferencesRequest_init(&addRefRequest);
+    addRefRequest.referencesToAddSize = 1;
+    addRefRequest.referencesToAdd = &addRefItem;
+    UA_AddReferencesResponse addRefResponse;
+    UA_AddReferencesResponse_init(&addRefResponse);
+    UA_RCU_LOCK();
+    Service_AddReferences(server, &session, &addRefRequest, &addRefResponse);
+    UA_RCU_UNLOCK();
+    CHECK(addRefResponse.resultsSize == 1 &&
+          addRefResponse.results[0] == UA_STATUSCODE_GOOD);
+    UA_AddReferencesResponse_deleteMembers(&addRefResponse);
+    CHECK(countReferences(server, parent, child) == 1);
+    CHECK(countReferences(server, parent, childAlias) == 0);
+
+    /* DeleteReferences */
+    UA_DeleteReferencesItem deleteRefItem;
+    UA_DeleteReferencesItem_init(&deleteRefItem);
+    deleteRefItem.sourceNodeId = parentAlias;
+    deleteRefItem.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT);
+    deleteRefItem.isForward = true;
+    deleteRefItem.targetNodeId.nodeId = childAlias;
+    deleteRefItem.deleteBidirectional = true;
+    UA_DeleteReferencesRequest deleteRefRequest;
+    UA_DeleteReferencesRequest_init(&deleteRefRequest);
+    deleteRefRequest.referencesToDeleteSize = 1;
+    deleteRefRequest.referencesToDelete = &deleteRefItem;
+    UA_DeleteReferencesResponse deleteRefResponse;
+    UA_DeleteReferencesResponse_init(&deleteRefResponse);
+    UA_RCU_LOCK();
+    Service_DeleteReferences(server, &session, &deleteRefRequest, &deleteRefResponse);
+    UA_RCU_UNLOCK();
+    CHECK(deleteRefResponse.resultsSize == 1 &&
+          deleteRefResponse.results[0] == UA_STATUSCODE_GOOD);
+    UA_DeleteReferencesResponse_deleteMembers(&deleteRefResponse);
+    CHECK(countReferences(server, parent, child) == 0);
+
+    /* AddNodes below a registered parent */
+    UA_ObjectAttributes attr;
+    UA_ObjectAttributes_init(&attr);
+    attr.displayName = UA_LOCALIZEDTEXT("en_US", "grandchild");
+    UA_AddNodesItem addItem;
+    UA_AddNodesItem_init(&addItem);
+    addItem.parentNodeId.nodeId = parentAlias;
+    addItem.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES);
+    addItem.requestedNewNodeId.nodeId = grandChild;
+    addItem.browseName = UA_QUALIFIEDNAME(1, "grandchild");
+    addItem.nodeClass = UA_NODECLASS_OBJECT;
+    addItem.nodeAttributes.encoding = UA_EXTENSIONOBJECT_DECODED_NODELETE;
+    addItem.nodeAttributes.content.decoded.type = &UA_TYPES[UA_TYPES_OBJECTATTRIBUTES];
+    addItem.nodeAttributes.content.decoded.data = &attr;
+    UA_AddNodesRequest addRequest;
+    UA_AddNodesRequest_init(&addRequest);
+    addRequest.nodesToAddSize = 1;
+    addRequest.nodesToAdd = &addItem;
+    UA_AddNodesResponse addResponse;
+    UA_AddNodesResponse_init(&addResponse);
+    UA_RCU_LOCK();
+    Service_AddNodes(server, &session, &addRequest, &addResponse);
+    UA_RCU_UNLOCK();
+    CHECK(addResponse.resultsSize == 1 &&
+          addResponse.results[0].statusCode == UA_STATUSCODE_GOOD);
+    UA_AddNodesResponse_deleteMembers(&addResponse);
+    CHECK(countReferences(server, parent, grandChild) == 1);
+
+    /* DeleteNodes */
+    UA_DeleteNodesItem deleteItem;
+    UA_DeleteNodesItem_init(&deleteItem);
+    deleteItem.nodeId = childAlias;
+    deleteItem.deleteTargetReferences = true;
+    UA_DeleteNodesRequest deleteRequest;
+    UA_DeleteNodesRequest_init(&deleteRequest);
+    deleteRequest.nodesToDeleteSize = 1;
+    deleteRequest.nodesToDelete = &deleteItem;
+    UA_DeleteNodesResponse deleteResponse;
+    UA_DeleteNodesResponse_init(&deleteResponse);
+    UA_RCU_LOCK();
+    Service_DeleteNodes(server, &session, &deleteRequest, &deleteResponse);
+    UA_RCU_UNLOCK();
+    CHECK(deleteResponse.resultsSize == 1 &&
+          deleteResponse.results[0] == UA_STATUSCODE_GOOD);
+    UA_DeleteNodesResponse_deleteMembers(&deleteResponse);
+    UA_RCU_LOCK();
+    CHECK(UA_NodeStore_get(server->nodestore, &child) == NULL);
+    UA_RCU_UNLOCK();
+
+    UA_Session_deleteMembersCleanup(&session, server);
+    UA_Server_delete(server);
+}
+
+static void
+addMandatoryMember(UA_Server *server, UA_NodeId parent, UA_NodeId nodeId, char *name) {
+    UA_VariableAttributes attr;
+    UA_VariableAttributes_init(&attr);
+    UA_Int32 v = 0;
+    UA_Variant_setScalar(&attr.value, &v, &UA_TYPES[UA_TYPES_INT32]);
+    attr.displayName = UA_LOCALIZEDTEXT("en_US", name);
+    CHECK(UA_Server_addVariableNode(server, nodeId, parent,
+                                    UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT),
+                                    UA_QUALIFIEDNAME(1, name),
+                                    UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE),
+                                    attr, NULL, NULL) == UA_STATUSCODE_GOOD);
+    CHECK(UA_Server_addReference(server, nodeId, UA_NODEID_NUMERIC(0, UA_NS0ID_HASMODELLINGRULE),
+                                 UA_EXPANDEDNODEID_NUMERIC(0, UA_NS0ID_MODELLINGRULE_MANDATORY),
+                                 true) == UA_STATUSCODE_GOOD);
+}
+
+/* Number of forward HasComponent references of the node */
+static size_t
+countComponents(UA_Server *server, UA_NodeId nodeId) {
+    size_t count = 0;
+    UA_NodeId hasComponent = UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT);
+    UA_RCU_LOCK();
+    const UA_Node *node = UA_NodeStore_get(server->nodestore, &nodeId);
+    for(size_t i = 0; node && i < node->referencesSize; ++i) {
+        if(!node->references[i].isInverse &&
+           UA_NodeId_equal(&node->references[i].referenceTypeId, &hasComponent))
+            ++count;
+    }
+    UA_RCU_UNLOCK();
+    return count;
+}
+
+/* Deleting a member of a type without its references changes the members
+ * that are instantiated */
+static void
+checkInstantiateAfterDeleteMember(void) {
+    UA_Server *server = newServer();
+    UA_NodeId typeId = UA_NODEID_NUMERIC(1, 3000);
+    UA_ObjectTypeAttributes attr;
+    UA_ObjectTypeAttributes_init(&attr);
+    attr.displayName = UA_LOCALIZEDTEXT("en_US", "type");
+    CHECK(UA_Server_addObjectTypeNode(server, typeId,
+                                      UA_NODEID_NUMERIC(0, UA_NS0ID_BASEOBJECTTYPE),
+                                      UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE),
+                                      UA_QUALIFIEDNAME(1, "type"), attr,
+                                      NULL, NULL) == UA_STATUSCODE_GOOD);
+    addMandatoryMember(server, typeId, UA_NODEID_NUMERIC(1, 3001), "first");
+    addMandatoryMember(server, typeId, UA_NODEID_NUMERIC(1, 3002), "second");
+
+    UA_NodeId first = UA_NODEID_NUMERIC(1, 3010);
+    CHECK(addObject(server, first, typeId) == UA_STATUSCODE_GOOD);
+    CHECK(countComponents(server, first) == 2);
+
+    CHECK(UA_Server_deleteNode(server, UA_NODEID_NUMERIC(1, 3002), false) == UA_STATUSCODE_GOOD);
+    UA_NodeId second = UA_NODEID_NUMERIC(1, 3011);
+    CHECK(addObject(server, second, typeId) == UA_STATUSCODE_GOOD);
+    CHECK(countComponents(server, second) == 1);
+
+    UA_Server_delete(server);
+}
+
+static UA_UInt32 dataSourceReads = 0;
+
+static UA_StatusCode
+readCounter(void *handle, const UA_NodeId nodeid, UA_Boolean includeSourceTimeStamp,
+            const UA_NumericRange *range, UA_DataValue *value) {
+    UA_Int32 counter = (UA_Int32)++dataSourceReads;
+    value->hasValue = true;
+    return UA_Variant_setScalarCopy(&value->value, &counter, &UA_TYPES[UA_TYPES_INT32]);
+}
+
+static void
+waitMs(UA_Double ms) {
+    UA_DateTime until = UA_DateTime_nowMonotonic() + (UA_DateTime)(ms * UA_MSEC_TO_DATETIME);
+    while(UA_DateTime_nowMonotonic() < until) {}
+}
+
+/* A single monitored item on a data source with a value cache reads from the
+ * data source on every sample, also when the sample job fires a bit early */
+static void
+checkSampleCachedDataSource(void) {
+    UA_Server *server = newServer();
+    UA_NodeId nodeId = addInt32Variable(server, 1002, "counter", 0);
+    UA_DataSource ds = {NULL, readCounter, NULL};
+    CHECK(UA_Server_setVariableNode_dataSource(server, nodeId, ds) == UA_STATUSCODE_GOOD);
+    CHECK(UA_Server_setVariableNode_valueCache(server, nodeId, 10000.0) == UA_STATUSCODE_GOOD);
+
+    UA_Subscription *sub = UA_Subscription_new(&adminSession, 1);
+    UA_MonitoredItem *mon = UA_MonitoredItem_new();
+    mon->subscription = sub;
+    mon->itemId = 1;
+    mon->monitoredItemType = UA_MONITOREDITEMTYPE_CHANGENOTIFY;
+    mon->timestampsToReturn = UA_TIMESTAMPSTORETURN_SOURCE;
+    mon->monitoringMode = UA_MONITORINGMODE_REPORTING;
+    mon->trigger = UA_DATACHANGETRIGGER_STATUSVALUE;
+    mon->monitoredNodeId = nodeId;
+    mon->attributeID = UA_ATTRIBUTEID_VALUE;
+    mon->samplingInterval = 50.0;
+    mon->maxQueueSize = 10;
+    mon->discardOldest = true;
+    LIST_INSERT_HEAD(&sub->monitoredItems, mon, listEntry);
+
+    dataSourceReads = 0;
+    for(size_t i = 0; i < 5; ++i) {
+        if(i > 0)
+            waitMs(mon->samplingInterval * 0.8);
+        UA_RCU_LOCK();
+        UA_MoniteredItem_SampleCallback(server, mon);
+        UA_RCU_UNLOCK();
+    }
+    CHECK(dataSourceReads == 5);
+    CHECK(mon->currentQueueSize == 5);
+
+    UA_Subscription_deleteMembers(sub, server);
+    UA_free(sub);
+    UA_Server_delete(server);
+}
+
+/* Pseudo-random numbers that are the same on every platform */
+static UA_UInt32 randomState = 1;
+
+static UA_UInt32
+nextRandom(void) {
+    randomState = randomState * 1103515245 + 12345;
+    return randomState >> 8;
+}
+
+/* Fills the element with random content */
+static void
+randomElement(void *p, const UA_DataType *type) {
+    if(type == &UA_TYPES[UA_TYPES_STRING]) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "s%u", (unsigned)(nextRandom() % 1000));
+        *(UA_String*)p = UA_STRING_ALLOC(buf);
+        return;
+    }
+    for(size_t i = 0; i < type->memSize; ++i)
+        ((UA_Byte*)p)[i] = (UA_Byte)nextRandom();
+}
+
+static UA_Boolean
+equalElements(const void *a, const void *b, const UA_DataType *type) {
+    if(type == &UA_TYPES[UA_TYPES_STRING])
+        return UA_String_equal((const UA_String*)a, (const UA_String*)b);
+    return memcmp(a, b, type->memSize) == 0;
+}
+
+/* A random array with 1 to 3 dimensions and a random range inside */
+static void
+randomArrayAndRange(const UA_DataType *type, UA_Variant *v, UA_NumericRange *range) {
+    size_t dimsSize = 1 + nextRandom() % 3;
+    UA_UInt32 *dims = (UA_UInt32*)UA_Array_new(dimsSize, &UA_TYPES[UA_TYPES_UINT32]);
+    range->dimensionsSize = dimsSize;
+    range->dimensions = (UA_NumericRangeDimension*)
+        UA_malloc(dimsSize * sizeof(UA_NumericRangeDimension));
+    size_t length = 1;
+    for(size_t k = 0; k < dimsSize; ++k) {
+        dims[k] = 1 + nextRandom() % 7;
+        length *= dims[k];
+        UA_UInt32 a = nextRandom() % dims[k];
+        UA_UInt32 b = nextRandom() % dims[k];
+        /* Often take the full dimension for contiguous blocks */
+        if(nextRandom() % 3 == 0) {
+            a = 0;
+            b = dims[k] - 1;
+        }
+        range->dimensions[k].min = a < b ? a : b;
+        range->dimensions[k].max = a < b ? b : a;
+    }
+    void *data = UA_Array_new(length, type);
+    for(size_t i = 0; i < length; ++i)
+        randomElement((UA_Byte*)data + i * type->memSize, type);
+    UA_Variant_setArray(v, data, length, type);
+    /* A single dimension is also given without the array dimensions */
+    if(dimsSize > 1 || nextRandom() % 2) {
+        v->arrayDimensions = dims;
+        v->arrayDimensionsSize = dimsSize;
+    } else {
+        UA_Array_delete(dims, dimsSize, &UA_TYPES[UA_TYPES_UINT32]);
+    }
+}
+
+/* Positions of the elements in the range in the order of the flat array.
+ * Element by element without any block logic. */
+static size_t *
+rangePositions(const UA_Variant *v, const UA_NumericRange *range, size_t *count) {
+    UA_UInt32 length = (UA_UInt32)v->arrayLength;
+    const UA_UInt32 *dims = v->arrayDimensionsSize > 0 ? v->arrayDimensions : &length;
+    size_t dimsSize = range->dimensionsSize;
+    *count = 1;
+    for(size_t k = 0; k < dimsSize; ++k)
+        *count *= range->dimensions[k].max - range->dimensions[k].min + 1;
+    size_t *positions = (size_t*)UA_malloc(*count * sizeof(size_t));
+    UA_UInt32 index[3];
+    for(size_t k = 0; k < dimsSize; ++k)
+        index[k] = range->dimensions[k].min;
+    for(size_t n = 0; n < *count; ++n) {
+        size_t pos = 0;
+        for(size_t k = 0; k < dimsSize; ++k)
+            pos = pos * dims[k] + index[k];
+        positions[n] = pos;
+        /* The last dimension varies fastest */
+        for(size_t k = dimsSize; k > 0; --k) {
+            if(index[k-1] < range->dimensions[k-1].max) {
+                ++index[k-1];
+                break;
+            }
+            index[k-1] = range->dimensions[k-1].min;
+        }
+    }
+    return positions;
+}
+
+/* copyRange and setRange give the same results as copying element by
+ * element, for blocks of every size and for types with members */
+static void
+checkVariantRanges(void) {
+    const UA_DataType *types[] = {&UA_TYPES[UA_TYPES_BYTE], &UA_TYPES[UA_TYPES_INT16],
+                                  &UA_TYPES[UA_TYPES_INT32], &UA_TYPES[UA_TYPES_DOUBLE],
+                                  &UA_TYPES[UA_TYPES_GUID], &UA_TYPES[UA_TYPES_STRING]};
+    for(size_t round = 0; round < 2000; ++round) {
+        const UA_DataType *type = types[round % (sizeof(types) / sizeof(types[0]))];
+        UA_Variant v;
+        UA_NumericRange range;
+        randomArrayAndRange(type, &v, &range);
+        size_t count;
+        size_t *positions = rangePositions(&v, &range, &count);
+        size_t size = type->memSize;
+
+        /* copyRange */
+        UA_Variant out;
+        CHECK(UA_Variant_copyRange(&v, &out, range) == UA_STATUSCODE_GOOD);
+        CHECK(out.arrayLength == count);
+        for(size_t n = 0; n < count && n < out.arrayLength; ++n)
+            CHECK(equalElements((UA_Byte*)out.data + n * size,
+                                (UA_Byte*)v.data + positions[n] * size, type));
+        for(size_t k = 0; k < out.arrayDimensionsSize; ++k)
+            CHECK(out.arrayDimensions[k] ==
+                  range.dimensions[k].max - range.dimensions[k].min + 1);
+        UA_Variant_deleteMembers(&out);
+
+        /* setRangeCopy and setRange with new random elements */
+        void *values = UA_Array_new(count, type);
+        for(size_t n = 0; n < count; ++n)
+            randomElement((UA_Byte*)values + n * size, type);
+        UA_Variant expected;
+        UA_Variant_copy(&v, &expected);
+        for(size_t n = 0; n < count; ++n) {
+            void *e = (UA_Byte*)expected.data + positions[n] * size;
+            UA_deleteMembers(e, type);
+            UA_copy((UA_Byte*)values + n * size, e, type);
+        }
+        UA_Variant copied;
+        UA_Variant_copy(&v, &copied);
+        CHECK(UA_Variant_setRangeCopy(&copied, values, count, range) == UA_STATUSCODE_GOOD);
+        CHECK(UA_Variant_setRange(&v, values, count, range) == UA_STATUSCODE_GOOD);
+        for(size_t i = 0; i < v.arrayLength; ++i) {
+            CHECK(equalElements((UA_Byte*)v.data + i * size,
+                                (UA_Byte*)expected.data + i * size, type));
+            CHECK(equalElements((UA_Byte*)copied.data + i * size,
+                                (UA_Byte*)expected.data + i * size, type));
+        }
+
+        /* The moved elements were taken over by v */
+        UA_Array_delete(values, count, type);
+        UA_Variant_deleteMembers(&copied);
+        UA_Variant_deleteMembers(&expected);
+        UA_Variant_deleteMembers(&v);
+        UA_free(positions);
+        UA_free(range.dimensions);
+    }
+}
+
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+
+/* Encodes the results of the Read service after the ResponseHeader. With
+ * spliced, the cached encodings of the attributes are copied into the
+ * response. Returns the number of cached attributes that were used. */
+static size_t
+encodeReadBody(UA_Server *server, const UA_ReadRequest *request, UA_Boolean spliced,
+               UA_ByteString *body) {
+    UA_ReadResponse response;
+    UA_ReadResponse_init(&response);
+    const UA_ByteString **encoded = (const UA_ByteString**)
+        UA_calloc(request->nodesToReadSize, sizeof(const UA_ByteString*));
+    UA_RCU_LOCK();
+    readService(server, &adminSession, request, &response, spliced ? encoded : NULL);
+    UA_RCU_UNLOCK();
+
+    UA_ByteString buf;
+    UA_ByteString_allocBuffer(&buf, 1 << 16);
+    size_t offset = 0;
+    size_t used = 0;
+    if(spliced) {
+        for(size_t i = 0; i < response.resultsSize; ++i)
+            used += (encoded[i] != NULL);
+        UA_ReadResults results = {&response, encoded};
+        CHECK(encodeReadResults(&results, NULL, NULL, &buf, &offset) == UA_STATUSCODE_GOOD);
+    } else {
+        CHECK(UA_encodeBinary(&response, &UA_TYPES[UA_TYPES_READRESPONSE],
+                              NULL, NULL, &buf, &offset) == UA_STATUSCODE_GOOD);
+        /* Remove the ResponseHeader */
+        size_t header = UA_calcSizeBinary(&response.responseHeader,
+                                          &UA_TYPES[UA_TYPES_RESPONSEHEADER]);
+        memmove(buf.data, &buf.data[header], offset - header);
+        offset -= header;
+    }
+    body->data = buf.data;
+    body->length = offset;
+    UA_free(encoded);
+    UA_ReadResponse_deleteMembers(&response);
+    return used;
+}
+
+static UA_Boolean
+sameReadResponses(UA_Server *server, const UA_ReadRequest *request, size_t *used) {
+    UA_ByteString spliced, plain;
+    *used = encodeReadBody(server, request, true, &spliced);
+    encodeReadBody(server, request, false, &plain);
+    UA_Boolean same = UA_ByteString_equal(&spliced, &plain);
+    UA_ByteString_deleteMembers(&spliced);
+    UA_ByteString_deleteMembers(&plain);
+    return same;
+}
+
+static UA_StatusCode
+setDescription(UA_Server *server, UA_Session *session, UA_Node *node,
+               const UA_LocalizedText *description) {
+    UA_LocalizedText_deleteMembers(&node->description);
+    return UA_LocalizedText_copy(description, &node->description);
+}
+
+/* Read responses with the cached encodings of the attributes are the same as
+ * without. Also after the node was changed with a Write and with editNode. */
+static void
+checkAttributeCache(void) {
+    UA_Server *server = newServer();
+    UA_NodeId nodeId = addInt32Variable(server, 4000, "cached", 7);
+
+    const UA_UInt32 attributes[] = {
+        UA_ATTRIBUTEID_NODEID, UA_ATTRIBUTEID_NODECLASS, UA_ATTRIBUTEID_BROWSENAME,
+        UA_ATTRIBUTEID_DISPLAYNAME, UA_ATTRIBUTEID_DESCRIPTION, UA_ATTRIBUTEID_WRITEMASK,
+        UA_ATTRIBUTEID_VALUE, UA_ATTRIBUTEID_DATATYPE, UA_ATTRIBUTEID_VALUERANK,
+        UA_ATTRIBUTEID_ACCESSLEVEL};
+    const size_t attributesSize = sizeof(attributes) / sizeof(attributes[0]);
+    UA_ReadValueId items[sizeof(attributes) / sizeof(attributes[0])];
+    for(size_t i = 0; i < attributesSize; ++i) {
+        UA_ReadValueId_init(&items[i]);
+        items[i].nodeId = nodeId;
+        items[i].attributeId = attributes[i];
+    }
+    UA_ReadRequest request;
+    UA_ReadRequest_init(&request);
+    request.nodesToRead = items;
+    request.nodesToReadSize = attributesSize;
+    request.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+
+    /* The first Read fills the cache. The second uses it. */
+    size_t used;
+    CHECK(sameReadResponses(server, &request, &used));
+    CHECK(sameReadResponses(server, &request, &used));
+    CHECK(used == attributesSize - 1);
+
+    /* Write */
+    UA_LocalizedText displayName = UA_LOCALIZEDTEXT("en_US", "written");
+    CHECK(UA_Server_writeDisplayName(server, nodeId, displayName) == UA_STATUSCODE_GOOD);
+    CHECK(sameReadResponses(server, &request, &used));
+    CHECK(sameReadResponses(server, &request, &used));
+    CHECK(used == attributesSize - 1);
+    UA_LocalizedText out;
+    CHECK(UA_Server_readDisplayName(server, nodeId, &out) == UA_STATUSCODE_GOOD);
+    CHECK(UA_String_equal(&out.text, &displayName.text));
+    UA_LocalizedText_deleteMembers(&out);
+
+    /* editNode */
+    UA_LocalizedText description = UA_LOCALIZEDTEXT("en_US", "edited");
+    UA_RCU_LOCK();
+    CHECK(UA_Server_editNode(server, &adminSession, &nodeId,
+                             (UA_EditNodeCallback)setDescription,
+                             &description) == UA_STATUSCODE_GOOD);
+    UA_RCU_UNLOCK();
+    CHECK(sameReadResponses(server, &request, &used));
+    CHECK(sameReadResponses(server, &request, &used));
+    CHECK(used == attributesSize - 1);
+    CHECK(UA_Server_readDescription(server, nodeId, &out) == UA_STATUSCODE_GOOD);
+    CHECK(UA_String_equal(&out.text, &description.text));
+    UA_LocalizedText_deleteMembers(&out);
+
+    /* Free the replaced encodings in the delayed callbacks */
+    UA_Server_run_shutdown(server);
+    UA_Server_delete(server);
+}
+
+#endif
+
+int main(void) {
+    checkUpdateStatusOnly();
+    checkWriteBrowseName();
+    checkSampleCachedDataSource();
+    checkReAddNode();
+    checkRegisteredNodeManagement();
+    checkInstantiateAfterDeleteMember();
+    checkVariantRanges();
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    checkAttributeCache();
+#endif
+    if(failures > 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("all checks passed\n");
+    return EXIT_SUCCESS;
+}
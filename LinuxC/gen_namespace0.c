@@ -0,0 +1,730 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+*  License, v. 2.0. If a copy of the MPL was not distributed with this
+*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
+
+/**
+ * Generates ua_namespace0_static.c with the nodes of namespace 0 as constant
+ * data. The nodes are created once at build time as in UA_Server_new and
+ * written out as C initializers. With UA_ENABLE_STATIC_NAMESPACE0, the server
+ * uses these nodes in place instead of allocating them at startup.
+ *
+ * With -lazy, ua_namespace0_lazy.c is generated instead. It describes the
+ * nodes in a compact table. With UA_ENABLE_LAZY_NAMESPACE0, the nodestore
+ * creates a node from the table when it is first looked up.
+ *
+ * Usage: gen_namespace0 [-lazy] <outputfile> */
+
+/* The generator needs the internal node definitions */
+#include "open62541.c"
+
+#ifndef UA_ENABLE_TYPENAMES
+# error The generator requires UA_ENABLE_TYPENAMES
+#endif
+#if defined(UA_ENABLE_MULTITHREADING) || defined(UA_ENABLE_STATIC_NAMESPACE0) || \
+    defined(UA_ENABLE_GENERATE_NAMESPACE0) || defined(UA_ENABLE_LAZY_NAMESPACE0)
+# error The generator uses the single-threaded nodestore and the builtin namespace 0
+#endif
+
+static FILE *out;
+static unsigned int arrayCounter = 0;
+
+/* Growing buffer for the initializer of the current definition. Nested arrays
+ * are written to the output as separate definitions before the buffer. */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} Buffer;
+
+static void
+bprintf(Buffer *b, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if(len < 0)
+        exit(EXIT_FAILURE);
+    if(b->length + (size_t)len + 1 > b->capacity) {
+        size_t ncap = b->capacity > 0 ? b->capacity : 256;
+        while(b->length + (size_t)len + 1 > ncap)
+            ncap *= 2;
+        b->data = realloc(b->data, ncap);
+        if(!b->data)
+            exit(EXIT_FAILURE);
+        b->capacity = ncap;
+    }
+    va_start(args, format);
+    vsnprintf(&b->data[b->length], (size_t)len + 1, format, args);
+    va_end(args);
+    b->length += (size_t)len;
+}
+
+static void
+fail(const char *message) {
+    fprintf(stderr, "gen_namespace0: %s\n", message);
+    exit(EXIT_FAILURE);
+}
+
+static const UA_DataType *
+checkType(const UA_DataType *type) {
+    if(type < UA_TYPES || type >= &UA_TYPES[UA_TYPES_COUNT])
+        fail("only types from UA_TYPES are supported");
+    return type;
+}
+
+static void emitValue(Buffer *b, const void *p, const UA_DataType *type);
+
+/* Writes the array as a separate definition and prints the pointer to it */
+static void
+emitArray(Buffer *b, const void *p, size_t size, const UA_DataType *type) {
+    if(!p) {
+        bprintf(b, "NULL");
+        return;
+    }
+    if(p == UA_EMPTY_ARRAY_SENTINEL || size == 0) {
+        bprintf(b, "UA_EMPTY_ARRAY_SENTINEL");
+        return;
+    }
+    Buffer elements = {NULL, 0, 0};
+    for(size_t i = 0; i < size; ++i) {
+        bprintf(&elements, "    ");
+        emitValue(&elements, (const UA_Byte*)p + (i * type->memSize), type);
+        bprintf(&elements, ",\n");
+    }
+    unsigned int id = arrayCounter++;
+    fprintf(out, "static const UA_%s ns0_array%u[%lu] = {\n%s};\n\n",
+            type->typeName, id, (unsigned long)size, elements.data);
+    free(elements.data);
+    bprintf(b, "(UA_%s*)ns0_array%u", type->typeName, id);
+}
+
+/* Prints the characters of a string literal without the quotes */
+static void
+emitChars(Buffer *b, const UA_String *s) {
+    for(size_t i = 0; i < s->length; ++i) {
+        UA_Byte c = s->data[i];
+        if(c >= 0x20 && c < 0x7f && c != '"' && c != '\\' && c != '?')
+            bprintf(b, "%c", c);
+        else
+            bprintf(b, "\\%03o", c);
+    }
+}
+
+static void
+emitString(Buffer *b, const UA_String *s) {
+    if(s->data <= (UA_Byte*)UA_EMPTY_ARRAY_SENTINEL || s->length == 0) {
+        bprintf(b, "{0, %s}", s->data ? "UA_EMPTY_ARRAY_SENTINEL" : "NULL");
+        return;
+    }
+    bprintf(b, "{%lu, (UA_Byte*)\"", (unsigned long)s->length);
+    emitChars(b, s);
+    bprintf(b, "\"}");
+}
+
+static void
+emitGuid(Buffer *b, const UA_Guid *g) {
+    bprintf(b, "{%uu, %u, %u, {", g->data1, g->data2, g->data3);
+    for(size_t i = 0; i < 8; ++i)
+        bprintf(b, "%s%u", i > 0 ? ", " : "", g->data4[i]);
+    bprintf(b, "}}");
+}
+
+static const char *identifierTypes[] = {"UA_NODEIDTYPE_NUMERIC", NULL, NULL,
+                                        "UA_NODEIDTYPE_STRING", "UA_NODEIDTYPE_GUID",
+                                        "UA_NODEIDTYPE_BYTESTRING"};
+
+static void
+emitNodeId(Buffer *b, const UA_NodeId *id) {
+    if((size_t)id->identifierType >= sizeof(identifierTypes) / sizeof(char*) ||
+       !identifierTypes[id->identifierType])
+        fail("unknown nodeid type");
+    bprintf(b, "{.namespaceIndex = %u, .identifierType = %s, ",
+            id->namespaceIndex, identifierTypes[id->identifierType]);
+    switch(id->identifierType) {
+    case UA_NODEIDTYPE_NUMERIC:
+        bprintf(b, ".identifier.numeric = %uu}", id->identifier.numeric);
+        break;
+    case UA_NODEIDTYPE_GUID:
+        bprintf(b, ".identifier.guid = ");
+        emitGuid(b, &id->identifier.guid);
+        bprintf(b, "}");
+        break;
+    default:
+        bprintf(b, ".identifier.string = ");
+        emitString(b, &id->identifier.string);
+        bprintf(b, "}");
+        break;
+    }
+}
+
+static void
+emitLocalizedText(Buffer *b, const UA_LocalizedText *t) {
+    bprintf(b, "{");
+    emitString(b, &t->locale);
+    bprintf(b, ", ");
+    emitString(b, &t->text);
+    bprintf(b, "}");
+}
+
+/* The data is referenced as a scalar or array without being freed */
+static void
+emitVariant(Buffer *b, const UA_Variant *v) {
+    if(!v->type) {
+        bprintf(b, "{.type = NULL}");
+        return;
+    }
+    const UA_DataType *type = checkType(v->type);
+    size_t length = v->arrayLength;
+    if(length == 0 && v->data > UA_EMPTY_ARRAY_SENTINEL)
+        length = 1;
+    bprintf(b, "{.type = &UA_TYPES[%u], .storageType = UA_VARIANT_DATA_NODELETE, "
+            ".arrayLength = %lu, .data = (void*)", type->typeIndex,
+            (unsigned long)v->arrayLength);
+    emitArray(b, v->data, length, type);
+    bprintf(b, ", .arrayDimensionsSize = %lu, .arrayDimensions = ",
+            (unsigned long)v->arrayDimensionsSize);
+    emitArray(b, v->arrayDimensions, v->arrayDimensionsSize, &UA_TYPES[UA_TYPES_UINT32]);
+    bprintf(b, "}");
+}
+
+static void
+emitDataValue(Buffer *b, const UA_DataValue *v) {
+    bprintf(b, "{.hasValue = %d, .hasStatus = %d, .hasSourceTimestamp = %d, "
+            ".hasServerTimestamp = %d, .hasSourcePicoseconds = %d, "
+            ".hasServerPicoseconds = %d, .value = ", v->hasValue, v->hasStatus,
+            v->hasSourceTimestamp, v->hasServerTimestamp, v->hasSourcePicoseconds,
+            v->hasServerPicoseconds);
+    emitVariant(b, &v->value);
+    bprintf(b, ", .status = 0x%08xu, .sourceTimestamp = %lld, .sourcePicoseconds = %u, "
+            ".serverTimestamp = %lld, .serverPicoseconds = %u}", v->status,
+            (long long)v->sourceTimestamp, v->sourcePicoseconds,
+            (long long)v->serverTimestamp, v->serverPicoseconds);
+}
+
+static void
+emitExtensionObject(Buffer *b, const UA_ExtensionObject *e) {
+    if(e->encoding < UA_EXTENSIONOBJECT_DECODED) {
+        bprintf(b, "{.encoding = %d, .content.encoded = {", (int)e->encoding);
+        emitNodeId(b, &e->content.encoded.typeId);
+        bprintf(b, ", ");
+        emitString(b, &e->content.encoded.body);
+        bprintf(b, "}}");
+        return;
+    }
+    const UA_DataType *type = checkType(e->content.decoded.type);
+    bprintf(b, "{.encoding = UA_EXTENSIONOBJECT_DECODED_NODELETE, .content.decoded = "
+            "{.type = &UA_TYPES[%u], .data = (void*)", type->typeIndex);
+    emitArray(b, e->content.decoded.data, 1, type);
+    bprintf(b, "}}");
+}
+
+/* Prints the initializer of the value. Structured types are initialized
+ * positionally in the order of their members. */
+static void
+emitValue(Buffer *b, const void *p, const UA_DataType *type) {
+    switch(type->typeIndex) {
+    case UA_TYPES_BOOLEAN:
+        bprintf(b, "%s", *(const UA_Boolean*)p ? "true" : "false");
+        return;
+    case UA_TYPES_SBYTE:
+        bprintf(b, "%d", *(const UA_SByte*)p);
+        return;
+    case UA_TYPES_BYTE:
+        bprintf(b, "%u", *(const UA_Byte*)p);
+        return;
+    case UA_TYPES_INT16:
+        bprintf(b, "%d", *(const UA_Int16*)p);
+        return;
+    case UA_TYPES_UINT16:
+        bprintf(b, "%u", *(const UA_UInt16*)p);
+        return;
+    case UA_TYPES_INT32:
+        bprintf(b, "%d", *(const UA_Int32*)p);
+        return;
+    case UA_TYPES_UINT32:
+    case UA_TYPES_STATUSCODE:
+        bprintf(b, "%uu", *(const UA_UInt32*)p);
+        return;
+    case UA_TYPES_INT64:
+    case UA_TYPES_DATETIME:
+        bprintf(b, "%lldll", (long long)*(const UA_Int64*)p);
+        return;
+    case UA_TYPES_UINT64:
+        bprintf(b, "%lluull", (unsigned long long)*(const UA_UInt64*)p);
+        return;
+    case UA_TYPES_FLOAT:
+        bprintf(b, "%af", (double)*(const UA_Float*)p);
+        return;
+    case UA_TYPES_DOUBLE:
+        bprintf(b, "%a", *(const UA_Double*)p);
+        return;
+    case UA_TYPES_STRING:
+    case UA_TYPES_BYTESTRING:
+    case UA_TYPES_XMLELEMENT:
+        emitString(b, (const UA_String*)p);
+        return;
+    case UA_TYPES_GUID:
+        emitGuid(b, (const UA_Guid*)p);
+        return;
+    case UA_TYPES_NODEID:
+        emitNodeId(b, (const UA_NodeId*)p);
+        return;
+    case UA_TYPES_EXPANDEDNODEID: {
+        const UA_ExpandedNodeId *e = (const UA_ExpandedNodeId*)p;
+        bprintf(b, "{");
+        emitNodeId(b, &e->nodeId);
+        bprintf(b, ", ");
+        emitString(b, &e->namespaceUri);
+        bprintf(b, ", %uu}", e->serverIndex);
+        return;
+    }
+    case UA_TYPES_QUALIFIEDNAME: {
+        const UA_QualifiedName *q = (const UA_QualifiedName*)p;
+        bprintf(b, "{%u, ", q->namespaceIndex);
+        emitString(b, &q->name);
+        bprintf(b, "}");
+        return;
+    }
+    case UA_TYPES_LOCALIZEDTEXT:
+        emitLocalizedText(b, (const UA_LocalizedText*)p);
+        return;
+    case UA_TYPES_EXTENSIONOBJECT:
+        emitExtensionObject(b, (const UA_ExtensionObject*)p);
+        return;
+    case UA_TYPES_DATAVALUE:
+        emitDataValue(b, (const UA_DataValue*)p);
+        return;
+    case UA_TYPES_VARIANT:
+        emitVariant(b, (const UA_Variant*)p);
+        return;
+    case UA_TYPES_DIAGNOSTICINFO:
+        fail("DiagnosticInfo values are not supported");
+        return;
+    default:
+        break;
+    }
+
+    /* Enumerations have no members */
+    if(type->membersSize == 0) {
+        bprintf(b, "%d", *(const UA_Int32*)p);
+        return;
+    }
+
+    uintptr_t ptr = (uintptr_t)p;
+    bprintf(b, "{");
+    for(size_t i = 0; i < type->membersSize; ++i) {
+        const UA_DataTypeMember *m = &type->members[i];
+        if(!m->namespaceZero)
+            fail("only types from UA_TYPES are supported");
+        const UA_DataType *mt = &UA_TYPES[m->memberTypeIndex];
+        ptr += m->padding;
+        if(i > 0)
+            bprintf(b, ", ");
+        if(!m->isArray) {
+            emitValue(b, (const void*)ptr, mt);
+            ptr += mt->memSize;
+        } else {
+            size_t size = *(const size_t*)ptr;
+            ptr += sizeof(size_t);
+            bprintf(b, "%lu, ", (unsigned long)size);
+            emitArray(b, *(void* const*)ptr, size, mt);
+            ptr += sizeof(void*);
+        }
+    }
+    bprintf(b, "}");
+}
+
+static const char *
+nodeClassType(UA_NodeClass nodeClass) {
+    switch(nodeClass) {
+    case UA_NODECLASS_OBJECT: return "UA_ObjectNode";
+    case UA_NODECLASS_VARIABLE: return "UA_VariableNode";
+    case UA_NODECLASS_METHOD: return "UA_MethodNode";
+    case UA_NODECLASS_OBJECTTYPE: return "UA_ObjectTypeNode";
+    case UA_NODECLASS_VARIABLETYPE: return "UA_VariableTypeNode";
+    case UA_NODECLASS_REFERENCETYPE: return "UA_ReferenceTypeNode";
+    case UA_NODECLASS_DATATYPE: return "UA_DataTypeNode";
+    case UA_NODECLASS_VIEW: return "UA_ViewNode";
+    default: fail("unknown node class");
+    }
+    return NULL;
+}
+
+static const char *
+nodeClassName(UA_NodeClass nodeClass) {
+    switch(nodeClass) {
+    case UA_NODECLASS_OBJECT: return "UA_NODECLASS_OBJECT";
+    case UA_NODECLASS_VARIABLE: return "UA_NODECLASS_VARIABLE";
+    case UA_NODECLASS_METHOD: return "UA_NODECLASS_METHOD";
+    case UA_NODECLASS_OBJECTTYPE: return "UA_NODECLASS_OBJECTTYPE";
+    case UA_NODECLASS_VARIABLETYPE: return "UA_NODECLASS_VARIABLETYPE";
+    case UA_NODECLASS_REFERENCETYPE: return "UA_NODECLASS_REFERENCETYPE";
+    case UA_NODECLASS_DATATYPE: return "UA_NODECLASS_DATATYPE";
+    case UA_NODECLASS_VIEW: return "UA_NODECLASS_VIEW";
+    default: fail("unknown node class");
+    }
+    return NULL;
+}
+
+static void
+emitVariableAttributes(Buffer *b, const UA_VariableNode *vn) {
+    bprintf(b, ",\n        .dataType = ");
+    emitNodeId(b, &vn->dataType);
+    bprintf(b, ", .valueRank = %d, .arrayDimensionsSize = %lu, .arrayDimensions = ",
+            vn->valueRank, (unsigned long)vn->arrayDimensionsSize);
+    emitArray(b, vn->arrayDimensions, vn->arrayDimensionsSize, &UA_TYPES[UA_TYPES_UINT32]);
+    if(vn->valueSource != UA_VALUESOURCE_DATA || vn->value.data.callback.onRead ||
+       vn->value.data.callback.onWrite)
+        fail("variables with callbacks or data sources cannot be constant");
+    bprintf(b, ",\n        .valueSource = UA_VALUESOURCE_DATA, .value.data.value = ");
+    emitDataValue(b, &vn->value.data.value);
+}
+
+/* Prints the node as the initializer of a nodestore entry */
+static void
+emitNode(Buffer *b, const UA_Node *node) {
+    bprintf(b, "{NULL, {.nodeId = ");
+    emitNodeId(b, &node->nodeId);
+    bprintf(b, ", .nodeClass = %s,\n        .browseName = ", nodeClassName(node->nodeClass));
+    emitValue(b, &node->browseName, &UA_TYPES[UA_TYPES_QUALIFIEDNAME]);
+    bprintf(b, ",\n        .displayName = ");
+    emitLocalizedText(b, &node->displayName);
+    bprintf(b, ",\n        .description = ");
+    emitLocalizedText(b, &node->description);
+    bprintf(b, ",\n        .writeMask = %uu, .userWriteMask = %uu, .referencesSize = %lu, .references = ",
+            node->writeMask, node->userWriteMask, (unsigned long)node->referencesSize);
+    emitArray(b, node->references, node->referencesSize, &UA_TYPES[UA_TYPES_REFERENCENODE]);
+
+    switch(node->nodeClass) {
+    case UA_NODECLASS_OBJECT: {
+        const UA_ObjectNode *on = (const UA_ObjectNode*)node;
+        if(on->instanceHandle)
+            fail("objects with instance handles cannot be constant");
+        bprintf(b, ",\n        .eventNotifier = %u", on->eventNotifier);
+        break;
+    }
+    case UA_NODECLASS_VARIABLE: {
+        const UA_VariableNode *vn = (const UA_VariableNode*)node;
+        emitVariableAttributes(b, vn);
+        bprintf(b, ",\n        .accessLevel = %u, .userAccessLevel = %u, "
+                ".minimumSamplingInterval = %a, .historizing = %s", vn->accessLevel,
+                vn->userAccessLevel, vn->minimumSamplingInterval,
+                vn->historizing ? "true" : "false");
+        break;
+    }
+    case UA_NODECLASS_VARIABLETYPE: {
+        const UA_VariableTypeNode *vtn = (const UA_VariableTypeNode*)node;
+        emitVariableAttributes(b, (const UA_VariableNode*)node);
+        bprintf(b, ",\n        .isAbstract = %s", vtn->isAbstract ? "true" : "false");
+        break;
+    }
+    case UA_NODECLASS_METHOD:
+        fail("methods cannot be constant");
+        break;
+    case UA_NODECLASS_OBJECTTYPE: {
+        const UA_ObjectTypeNode *otn = (const UA_ObjectTypeNode*)node;
+        if(otn->lifecycleManagement.constructor || otn->lifecycleManagement.destructor)
+            fail("object types with lifecycle management cannot be constant");
+        bprintf(b, ",\n        .isAbstract = %s", otn->isAbstract ? "true" : "false");
+        break;
+    }
+    case UA_NODECLASS_REFERENCETYPE: {
+        const UA_ReferenceTypeNode *rtn = (const UA_ReferenceTypeNode*)node;
+        bprintf(b, ",\n        .isAbstract = %s, .symmetric = %s, .inverseName = ",
+                rtn->isAbstract ? "true" : "false", rtn->symmetric ? "true" : "false");
+        emitLocalizedText(b, &rtn->inverseName);
+        break;
+    }
+    case UA_NODECLASS_DATATYPE:
+        bprintf(b, ",\n        .isAbstract = %s",
+                ((const UA_DataTypeNode*)node)->isAbstract ? "true" : "false");
+        break;
+    case UA_NODECLASS_VIEW: {
+        const UA_ViewNode *vn = (const UA_ViewNode*)node;
+        bprintf(b, ",\n        .containsNoLoops = %s, .eventNotifier = %u",
+                vn->containsNoLoops ? "true" : "false", vn->eventNotifier);
+        break;
+    }
+    default:
+        break;
+    }
+    bprintf(b, "}}");
+}
+
+static const UA_Node **nodes = NULL;
+static size_t nodesSize = 0;
+
+static void
+collectNode(const UA_Node *node) {
+    if(node->nodeId.namespaceIndex != 0 ||
+       node->nodeId.identifierType != UA_NODEIDTYPE_NUMERIC)
+        fail("namespace 0 must only contain numeric nodeids");
+    nodes = realloc(nodes, (nodesSize + 1) * sizeof(UA_Node*));
+    if(!nodes)
+        exit(EXIT_FAILURE);
+    nodes[nodesSize++] = node;
+}
+
+static int
+compareNodes(const void *a, const void *b) {
+    UA_UInt32 ida = (*(const UA_Node* const*)a)->nodeId.identifier.numeric;
+    UA_UInt32 idb = (*(const UA_Node* const*)b)->nodeId.identifier.numeric;
+    return (ida > idb) - (ida < idb);
+}
+
+/* Writes the nodes as members of one struct, so that the nodestore can tell
+ * them apart by their address */
+static void
+emitConstNamespace(void) {
+    Buffer types = {NULL, 0, 0};
+    Buffer values = {NULL, 0, 0};
+    for(size_t i = 0; i < nodesSize; ++i) {
+        UA_UInt32 id = nodes[i]->nodeId.identifier.numeric;
+        bprintf(&types, "    struct { UA_NodeStoreEntry *orig; %s node; } n%u;\n",
+                nodeClassType(nodes[i]->nodeClass), id);
+        bprintf(&values, "    .n%u = ", id);
+        emitNode(&values, nodes[i]);
+        bprintf(&values, ",\n");
+    }
+    fprintf(out, "static const struct {\n%s} ns0Nodes = {\n%s};\n\n",
+            types.data, values.data);
+
+    fprintf(out, "static const UA_Node * const ns0NodeList[%lu] = {\n",
+            (unsigned long)nodesSize);
+    for(size_t i = 0; i < nodesSize; ++i)
+        fprintf(out, "    (const UA_Node*)&ns0Nodes.n%u.node,\n",
+                nodes[i]->nodeId.identifier.numeric);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static UA_StatusCode\n"
+            "addStaticNamespace0(UA_NodeStore *ns) {\n"
+            "    return UA_NodeStore_insertConst(ns, &ns0Nodes, sizeof(ns0Nodes),\n"
+            "                                    ns0NodeList, %lu);\n"
+            "}\n", (unsigned long)nodesSize);
+
+    free(types.data);
+    free(values.data);
+}
+
+/* The name pool of the lazy table. The strings point into the nodes. The first
+ * name is empty. */
+static UA_String *lazyNames = NULL;
+static size_t lazyNamesSize = 0;
+static const UA_String *lazyLocale = NULL;
+
+static UA_UInt16
+addLazyName(const UA_String *name) {
+    size_t offset = 0;
+    for(size_t i = 0; i < lazyNamesSize; ++i) {
+        if(UA_String_equal(&lazyNames[i], name))
+            return (UA_UInt16)offset;
+        offset += lazyNames[i].length + 1;
+    }
+    if(name->length > 0 && memchr(name->data, 0, name->length))
+        fail("names with zero bytes cannot be lazy");
+    if(offset + name->length + 1 > UA_UINT16_MAX)
+        fail("too many names for the lazy table");
+    lazyNames = realloc(lazyNames, (lazyNamesSize + 1) * sizeof(UA_String));
+    if(!lazyNames)
+        exit(EXIT_FAILURE);
+    lazyNames[lazyNamesSize++] = *name;
+    return (UA_UInt16)offset;
+}
+
+/* Texts of lazy nodes share one locale */
+static UA_UInt16
+addLazyText(const UA_LocalizedText *text) {
+    if(!lazyLocale)
+        lazyLocale = &text->locale;
+    if(!UA_String_equal(&text->locale, lazyLocale))
+        fail("lazy nodes must have the same locale");
+    return addLazyName(&text->text);
+}
+
+static UA_Boolean
+isLazyNodeId(const UA_NodeId *id, UA_UInt32 max) {
+    return id->namespaceIndex == 0 && id->identifierType == UA_NODEIDTYPE_NUMERIC &&
+        id->identifier.numeric <= max;
+}
+
+/* Prints the table entry and appends the references to refs. Fails for
+ * nodes that cannot be described by the table. */
+static void
+emitLazyNode(Buffer *b, Buffer *refs, size_t *refsSize, const UA_Node *node) {
+    if(node->browseName.namespaceIndex != 0 || node->browseName.name.length == 0 ||
+       !UA_String_equal(&node->browseName.name, &node->displayName.text) ||
+       !UA_String_equal(&node->browseName.name, &node->description.text))
+        fail("lazy nodes must have the same BrowseName, DisplayName and Description");
+    if(node->writeMask != 0 || node->userWriteMask != 0)
+        fail("lazy nodes cannot have a WriteMask");
+    UA_UInt16 name = addLazyText(&node->displayName);
+    addLazyText(&node->description);
+
+    if(node->referencesSize > UA_UINT16_MAX || *refsSize > UA_UINT16_MAX)
+        fail("too many references for the lazy table");
+    for(size_t i = 0; i < node->referencesSize; ++i) {
+        const UA_ReferenceNode *ref = &node->references[i];
+        if(!isLazyNodeId(&ref->referenceTypeId, UA_UINT16_MAX) ||
+           !isLazyNodeId(&ref->targetId.nodeId, UA_UINT32_MAX) ||
+           ref->targetId.namespaceUri.data || ref->targetId.serverIndex != 0)
+            fail("lazy nodes can only reference numeric nodes of namespace 0");
+        bprintf(refs, "    {%uu, %u, %s},\n", ref->targetId.nodeId.identifier.numeric,
+                ref->referenceTypeId.identifier.numeric,
+                ref->isInverse ? "true" : "false");
+    }
+
+    UA_UInt32 dataType = 0;
+    UA_Int32 valueRank = 0;
+    UA_UInt16 inverseName = 0;
+    UA_Boolean isAbstract = false;
+    UA_Byte flags = 0;
+    UA_Byte eventNotifier = 0;
+    switch(node->nodeClass) {
+    case UA_NODECLASS_OBJECT: {
+        const UA_ObjectNode *on = (const UA_ObjectNode*)node;
+        if(on->instanceHandle)
+            fail("objects with instance handles cannot be lazy");
+        eventNotifier = on->eventNotifier;
+        break;
+    }
+    case UA_NODECLASS_OBJECTTYPE: {
+        const UA_ObjectTypeNode *otn = (const UA_ObjectTypeNode*)node;
+        if(otn->lifecycleManagement.constructor || otn->lifecycleManagement.destructor)
+            fail("object types with lifecycle management cannot be lazy");
+        isAbstract = otn->isAbstract;
+        break;
+    }
+    case UA_NODECLASS_VARIABLETYPE: {
+        const UA_VariableTypeNode *vtn = (const UA_VariableTypeNode*)node;
+        if(vtn->valueSource != UA_VALUESOURCE_DATA || vtn->value.data.value.hasValue ||
+           vtn->value.data.callback.onRead || vtn->value.data.callback.onWrite ||
+           vtn->arrayDimensionsSize > 0)
+            fail("variable types with values or array dimensions cannot be lazy");
+        if(!isLazyNodeId(&vtn->dataType, UA_UINT32_MAX))
+            fail("the data type of lazy variable types must be in namespace 0");
+        dataType = vtn->dataType.identifier.numeric;
+        valueRank = vtn->valueRank;
+        isAbstract = vtn->isAbstract;
+        break;
+    }
+    case UA_NODECLASS_REFERENCETYPE: {
+        const UA_ReferenceTypeNode *rtn = (const UA_ReferenceTypeNode*)node;
+        if(rtn->inverseName.text.data || rtn->inverseName.locale.data) {
+            if(rtn->inverseName.text.length == 0)
+                fail("empty InverseNames cannot be lazy");
+            inverseName = addLazyText(&rtn->inverseName);
+        }
+        isAbstract = rtn->isAbstract;
+        if(rtn->symmetric)
+            flags |= UA_LAZYNODE_SYMMETRIC;
+        break;
+    }
+    case UA_NODECLASS_DATATYPE:
+        isAbstract = ((const UA_DataTypeNode*)node)->isAbstract;
+        break;
+    case UA_NODECLASS_VIEW: {
+        const UA_ViewNode *vn = (const UA_ViewNode*)node;
+        if(vn->containsNoLoops)
+            flags |= UA_LAZYNODE_CONTAINSNOLOOPS;
+        eventNotifier = vn->eventNotifier;
+        break;
+    }
+    default:
+        fail("only objects, views and types can be lazy");
+    }
+    if(isAbstract)
+        flags |= UA_LAZYNODE_ISABSTRACT;
+
+    bprintf(b, "    {%uu, %uu, %d, %u, %u, %lu, %lu, %s, 0x%02x, %u}, /* ",
+            node->nodeId.identifier.numeric, dataType, valueRank, name, inverseName,
+            (unsigned long)*refsSize, (unsigned long)node->referencesSize,
+            nodeClassName(node->nodeClass), flags, eventNotifier);
+    emitChars(b, &node->browseName.name);
+    bprintf(b, " */\n");
+    *refsSize += node->referencesSize;
+}
+
+static void
+emitLazyNamespace(void) {
+    const UA_String empty = UA_STRING_NULL;
+    addLazyName(&empty);
+    Buffer table = {NULL, 0, 0};
+    Buffer refs = {NULL, 0, 0};
+    size_t refsSize = 0;
+    for(size_t i = 0; i < nodesSize; ++i)
+        emitLazyNode(&table, &refs, &refsSize, nodes[i]);
+
+    Buffer names = {NULL, 0, 0};
+    for(size_t i = 0; i < lazyNamesSize; ++i) {
+        bprintf(&names, "\n    \"");
+        emitChars(&names, &lazyNames[i]);
+        bprintf(&names, "\\0\"");
+    }
+    fprintf(out, "static const char ns0LazyNames[] =%s;\n\n", names.data);
+
+    if(refsSize > 0)
+        fprintf(out, "static const UA_LazyReference ns0LazyReferences[%lu] = {\n"
+                "    /* target, reference type, inverse */\n%s};\n\n",
+                (unsigned long)refsSize, refs.data);
+
+    fprintf(out, "static const UA_LazyNode ns0LazyNodes[%lu] = {\n"
+            "    /* id, data type, value rank, name, inverse name, references,\n"
+            "     * number of references, node class, flags, event notifier */\n"
+            "%s};\n\n", (unsigned long)nodesSize, table.data);
+
+    Buffer locale = {NULL, 0, 0};
+    bprintf(&locale, "\"");
+    if(lazyLocale)
+        emitChars(&locale, lazyLocale);
+    bprintf(&locale, "\"");
+    fprintf(out, "static const UA_LazyNamespace ns0Lazy = {\n"
+            "    ns0LazyNodes, %lu, %s, ns0LazyNames, %s};\n\n",
+            (unsigned long)nodesSize, refsSize > 0 ? "ns0LazyReferences" : "NULL",
+            locale.data);
+
+    fprintf(out, "static UA_StatusCode\n"
+            "addLazyNamespace0(UA_NodeStore *ns) {\n"
+            "    return UA_NodeStore_insertLazy(ns, &ns0Lazy);\n"
+            "}\n");
+
+    free(table.data);
+    free(refs.data);
+    free(names.data);
+    free(locale.data);
+    free(lazyNames);
+}
+
+int main(int argc, char **argv) {
+    UA_Boolean lazy = (argc == 3 && strcmp(argv[1], "-lazy") == 0);
+    if(argc != 2 && !lazy) {
+        fprintf(stderr, "usage: %s [-lazy] <outputfile>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    UA_ServerConfig config = UA_ServerConfig_standard;
+    config.logger = NULL;
+    UA_Server *server = createServer(config);
+    if(!server)
+        return EXIT_FAILURE;
+    createNamespace0(server);
+    UA_NodeStore_iterate(server->nodestore, collectNode);
+    qsort(nodes, nodesSize, sizeof(UA_Node*), compareNodes);
+
+    out = fopen(argv[argc - 1], "w");
+    if(!out)
+        fail("cannot open the output file");
+    fprintf(out, "/* Generated by gen_namespace0.c. Do not edit. */\n\n");
+    fprintf(out, "#ifdef UA_ENABLE_MULTITHREADING\n"
+            "# error The %s namespace 0 requires the single-threaded nodestore\n"
+            "#endif\n\n", lazy ? "lazy" : "constant");
+    if(lazy)
+        emitLazyNamespace();
+    else
+        emitConstNamespace();
+
+    free(nodes);
+    UA_Server_delete(server);
+    if(fclose(out) != 0)
+        fail("cannot write the output file");
+    return EXIT_SUCCESS;
+}
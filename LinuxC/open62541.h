@@ -59,6 +59,10 @@ extern "C" {
 /* #undef UA_ENABLE_EMBEDDED_LIBC */
 /* #undef UA_ENABLE_DETERMINISTIC_RNG */
 /* #undef UA_ENABLE_GENERATE_NAMESPACE0 */
+/* #undef UA_ENABLE_STATIC_NAMESPACE0 */
+/* #undef UA_ENABLE_LAZY_NAMESPACE0 */
+/* #undef UA_ENABLE_COMPACT_NODES */
+/* #undef UA_ENABLE_ATTRIBUTE_CACHE */
 /* #undef UA_ENABLE_EXTERNAL_NAMESPACES */
 /* #undef UA_ENABLE_NONSTANDARD_STATELESS */
 /* #undef UA_ENABLE_NONSTANDARD_UDP */
@@ -9816,6 +9820,42 @@ UA_UInt16 UA_EXPORT UA_Server_addNamespace(UA_Server *server, const char* name);
 UA_Server UA_EXPORT * UA_Server_new(const UA_ServerConfig config);
 void UA_EXPORT UA_Server_delete(UA_Server *server);
 
+#ifndef UA_ENABLE_MULTITHREADING
+/* Stores all nodes of the server in an image file. The image can only be
+ * loaded by the same build of the library. Value callbacks, data sources,
+ * method callbacks and instance handles are not stored. */
+UA_StatusCode UA_EXPORT
+UA_Server_saveImage(UA_Server *server, const char *path);
+
+/* Creates a server with the nodes from an image file. The file is mapped into
+ * memory and the nodes are used in place. Edited nodes are copied to the heap.
+ * The callbacks of namespace 0 are attached. Callbacks of the application need
+ * to be attached again after loading. Returns NULL if the image cannot be
+ * loaded. */
+UA_Server UA_EXPORT *
+UA_Server_newFromImage(const UA_ServerConfig config, const char *path);
+#endif
+
+/* Memory used by the nodes of one node class. Nodes in an image or in
+ * constant memory are only counted in nodes and readOnlyNodes. Lazy nodes of
+ * namespace 0 (UA_ENABLE_LAZY_NAMESPACE0) are counted once they are used. */
+typedef struct {
+    size_t nodes;
+    size_t readOnlyNodes;
+    size_t nodeBytes;      /* node structures */
+    size_t referencesSize; /* number of references */
+    size_t referenceBytes; /* reference arrays and the NodeIds therein */
+    size_t attributeBytes; /* strings, arrays and values of the attributes */
+} UA_NodeMemoryReport;
+
+/* One entry per node class. Entry i covers the node class with the value
+ * 1 << i. */
+#define UA_NODEMEMORYREPORT_SIZE 8
+
+UA_StatusCode UA_EXPORT
+UA_Server_getNodeMemoryReport(UA_Server *server,
+                              UA_NodeMemoryReport report[UA_NODEMEMORYREPORT_SIZE]);
+
 /* Runs the main loop of the server. In each iteration, this calls into the
  * networklayers to see if jobs have arrived and checks if repeated jobs need to
  * be triggered.
@@ -10174,6 +10214,63 @@ UA_Server_writeExecutable(UA_Server *server, const UA_NodeId nodeId,
     return __UA_Server_write(server, &nodeId, UA_ATTRIBUTEID_EXECUTABLE,
                              &UA_TYPES[UA_TYPES_BOOLEAN], &executable); }
 
+/**
+ * Node Handles
+ * ^^^^^^^^^^^^
+ * Local applications that access the same nodes repeatedly can look them up
+ * once and keep a handle. Accesses with the handle do not hash the NodeId
+ * again. Without multithreading, the node itself is cached until a node of
+ * the server is replaced or deleted.
+ *
+ * The handle stays valid while the server exists. If the node is deleted,
+ * accesses with the handle return UA_STATUSCODE_BADNODEIDUNKNOWN. A new node
+ * with the same NodeId is found again. */
+typedef struct UA_NodeHandle UA_NodeHandle;
+
+/* Returns NULL if the node does not exist */
+UA_NodeHandle UA_EXPORT *
+UA_Server_getNodeHandle(UA_Server *server, const UA_NodeId nodeId);
+
+void UA_EXPORT
+UA_NodeHandle_delete(UA_NodeHandle *handle);
+
+UA_DataValue UA_EXPORT
+UA_Server_readByHandle(UA_Server *server, UA_NodeHandle *handle,
+                       const UA_AttributeId attributeId,
+                       UA_TimestampsToReturn timestamps);
+
+UA_StatusCode UA_EXPORT
+UA_Server_writeByHandle(UA_Server *server, UA_NodeHandle *handle,
+                        const UA_AttributeId attributeId, const UA_Variant value);
+
+/* Updates of the value attribute from the local application, e.g. a gateway
+ * that publishes sensor data. Value, status code and source timestamp of a
+ * variable are set together. So readers and monitored items see a single
+ * change per update. The value is copied. A value without type only sets the
+ * status. A sourceTimestamp of zero is replaced with the current time. If
+ * handle is not NULL, the nodeId is ignored.
+ *
+ * The local application is trusted. Values that have exactly the data type of
+ * the variable are not type-checked. Other values and variables with a data
+ * source take the path of UA_Server_write.
+ *
+ * @param server The server object.
+ * @param updatesSize The number of updates.
+ * @param updates The updates.
+ * @param results Optional array of updatesSize status codes for the updates.
+ * @return Returns the first bad status code or UA_STATUSCODE_GOOD. */
+typedef struct {
+    UA_NodeId nodeId;
+    UA_NodeHandle *handle;
+    UA_Variant value;
+    UA_StatusCode status;
+    UA_DateTime sourceTimestamp;
+} UA_ValueUpdate;
+
+UA_StatusCode UA_EXPORT
+UA_Server_updateValues(UA_Server *server, size_t updatesSize,
+                       const UA_ValueUpdate *updates, UA_StatusCode *results);
+
 /**
  * Browsing
  * -------- */
@@ -10285,6 +10382,24 @@ UA_StatusCode UA_EXPORT
 UA_Server_setVariableNode_dataSource(UA_Server *server, const UA_NodeId nodeId,
                                      const UA_DataSource dataSource);
 
+/* Values read from a data source can be cached. A Read with a maxAge is
+ * answered from the cache if the last value read from the data source is not
+ * older than the maxAge of the request and the maxAge [ms] of the cache. The
+ * cache is emptied when the value is written. A maxAge of zero removes the
+ * cache. */
+UA_StatusCode UA_EXPORT
+UA_Server_setVariableNode_valueCache(UA_Server *server, const UA_NodeId nodeId,
+                                     const UA_Double maxAge);
+
+typedef struct {
+    UA_UInt64 hits;   /* Reads answered from the cache */
+    UA_UInt64 misses; /* Reads with a maxAge that went to the data source */
+} UA_ValueCacheStatistics;
+
+UA_StatusCode UA_EXPORT
+UA_Server_getVariableNode_valueCacheStatistics(UA_Server *server, const UA_NodeId nodeId,
+                                               UA_ValueCacheStatistics *statistics);
+
 /**
  * .. _value-callback:
  *
@@ -10380,7 +10495,16 @@ UA_Server_setMethodNode_callback(UA_Server *server, const UA_NodeId methodNodeId
  * example `UA_Server_addVariablenode` with a value attribute (a :ref:`variant`)
  * pointing to a memory location on the stack. If you need changes to a variable
  * value to manifest at a specific memory location, please use a
- * :ref:`datasource` or a :ref:`value-callback`. */
+ * :ref:`datasource` or a :ref:`value-callback`.
+ *
+ * The variants ending in `Move` take over the strings and values of the node
+ * attributes instead of copying them. So large initial values are not copied
+ * twice when the address space is built up. All members of the attributes must
+ * be allocated on the heap, e.g. with `UA_LOCALIZEDTEXT_ALLOC` or with
+ * `UA_Variant_setArray` on an array from `UA_Array_new`. Afterwards, the
+ * attributes are empty. Members that cannot be moved (e.g. a value that is
+ * converted to the DataType of the node) are copied and deleted. The
+ * BrowseName and the NodeIds are always copied. */
 /* The instantiation callback is used to track the addition of new nodes. It is
  * also called for all sub-nodes contained in an object or variable type node
  * that is instantiated. */
@@ -10403,6 +10527,19 @@ __UA_Server_addNode(UA_Server *server, const UA_NodeClass nodeClass,
                     UA_InstantiationCallback *instantiationCallback,
                     UA_NodeId *outNewNodeId);
 
+/* Don't use this function. There are typed versions as inline functions. */
+UA_StatusCode UA_EXPORT
+__UA_Server_addNodeMove(UA_Server *server, const UA_NodeClass nodeClass,
+                        const UA_NodeId requestedNewNodeId,
+                        const UA_NodeId parentNodeId,
+                        const UA_NodeId referenceTypeId,
+                        const UA_QualifiedName browseName,
+                        const UA_NodeId typeDefinition,
+                        UA_NodeAttributes *attr,
+                        const UA_DataType *attributeType,
+                        UA_InstantiationCallback *instantiationCallback,
+                        UA_NodeId *outNewNodeId);
+
 static UA_INLINE UA_StatusCode
 UA_Server_addVariableNode(UA_Server *server, const UA_NodeId requestedNewNodeId,
                           const UA_NodeId parentNodeId,
@@ -10516,6 +10653,135 @@ UA_Server_addDataTypeNode(UA_Server *server,
                                instantiationCallback, outNewNodeId);
 }
 
+static UA_INLINE UA_StatusCode
+UA_Server_addVariableNodeMove(UA_Server *server, const UA_NodeId requestedNewNodeId,
+                              const UA_NodeId parentNodeId,
+                              const UA_NodeId referenceTypeId,
+                              const UA_QualifiedName browseName,
+                              const UA_NodeId typeDefinition,
+                              UA_VariableAttributes *attr,
+                              UA_InstantiationCallback *instantiationCallback,
+                              UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_VARIABLE, requestedNewNodeId,
+                                   parentNodeId, referenceTypeId, browseName,
+                                   typeDefinition, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_VARIABLEATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+static UA_INLINE UA_StatusCode
+UA_Server_addVariableTypeNodeMove(UA_Server *server,
+                                  const UA_NodeId requestedNewNodeId,
+                                  const UA_NodeId parentNodeId,
+                                  const UA_NodeId referenceTypeId,
+                                  const UA_QualifiedName browseName,
+                                  const UA_NodeId typeDefinition,
+                                  UA_VariableTypeAttributes *attr,
+                                  UA_InstantiationCallback *instantiationCallback,
+                                  UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_VARIABLETYPE,
+                                   requestedNewNodeId, parentNodeId, referenceTypeId,
+                                   browseName, typeDefinition, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_VARIABLETYPEATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+static UA_INLINE UA_StatusCode
+UA_Server_addObjectNodeMove(UA_Server *server, const UA_NodeId requestedNewNodeId,
+                            const UA_NodeId parentNodeId,
+                            const UA_NodeId referenceTypeId,
+                            const UA_QualifiedName browseName,
+                            const UA_NodeId typeDefinition,
+                            UA_ObjectAttributes *attr,
+                            UA_InstantiationCallback *instantiationCallback,
+                            UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_OBJECT, requestedNewNodeId,
+                                   parentNodeId, referenceTypeId, browseName,
+                                   typeDefinition, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_OBJECTATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+static UA_INLINE UA_StatusCode
+UA_Server_addObjectTypeNodeMove(UA_Server *server, const UA_NodeId requestedNewNodeId,
+                                const UA_NodeId parentNodeId,
+                                const UA_NodeId referenceTypeId,
+                                const UA_QualifiedName browseName,
+                                UA_ObjectTypeAttributes *attr,
+                                UA_InstantiationCallback *instantiationCallback,
+                                UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_OBJECTTYPE, requestedNewNodeId,
+                                   parentNodeId, referenceTypeId, browseName,
+                                   UA_NODEID_NULL, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_OBJECTTYPEATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+static UA_INLINE UA_StatusCode
+UA_Server_addViewNodeMove(UA_Server *server, const UA_NodeId requestedNewNodeId,
+                          const UA_NodeId parentNodeId,
+                          const UA_NodeId referenceTypeId,
+                          const UA_QualifiedName browseName,
+                          UA_ViewAttributes *attr,
+                          UA_InstantiationCallback *instantiationCallback,
+                          UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_VIEW, requestedNewNodeId,
+                                   parentNodeId, referenceTypeId, browseName,
+                                   UA_NODEID_NULL, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_VIEWATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+static UA_INLINE UA_StatusCode
+UA_Server_addReferenceTypeNodeMove(UA_Server *server,
+                                   const UA_NodeId requestedNewNodeId,
+                                   const UA_NodeId parentNodeId,
+                                   const UA_NodeId referenceTypeId,
+                                   const UA_QualifiedName browseName,
+                                   UA_ReferenceTypeAttributes *attr,
+                                   UA_InstantiationCallback *instantiationCallback,
+                                   UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_REFERENCETYPE,
+                                   requestedNewNodeId, parentNodeId, referenceTypeId,
+                                   browseName, UA_NODEID_NULL, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_REFERENCETYPEATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+static UA_INLINE UA_StatusCode
+UA_Server_addDataTypeNodeMove(UA_Server *server,
+                              const UA_NodeId requestedNewNodeId,
+                              const UA_NodeId parentNodeId,
+                              const UA_NodeId referenceTypeId,
+                              const UA_QualifiedName browseName,
+                              UA_DataTypeAttributes *attr,
+                              UA_InstantiationCallback *instantiationCallback,
+                              UA_NodeId *outNewNodeId) {
+    return __UA_Server_addNodeMove(server, UA_NODECLASS_DATATYPE, requestedNewNodeId,
+                                   parentNodeId, referenceTypeId, browseName,
+                                   UA_NODEID_NULL, (UA_NodeAttributes*)attr,
+                                   &UA_TYPES[UA_TYPES_DATATYPEATTRIBUTES],
+                                   instantiationCallback, outNewNodeId);
+}
+
+/* Add many nodes at once. The nodestore is presized for the batch, the
+ * reference to a parent (or type definition) shared by consecutive items is
+ * checked once and the references back to the new nodes are added with one
+ * edit of the parent. Parents must precede their children in the batch. The
+ * results array has itemsSize entries and receives the outcome for every
+ * item. The returned statuscode is bad only if the batch as a whole failed. */
+UA_StatusCode UA_EXPORT
+UA_Server_addNodes(UA_Server *server, const UA_AddNodesItem *items, size_t itemsSize,
+                   UA_InstantiationCallback *instantiationCallback,
+                   UA_AddNodesResult *results);
+
+/* Add many nodes at once and move the decoded attributes of the items into the
+ * nodes. The attributes of all items are empty afterwards. */
+UA_StatusCode UA_EXPORT
+UA_Server_addNodesMove(UA_Server *server, UA_AddNodesItem *items, size_t itemsSize,
+                       UA_InstantiationCallback *instantiationCallback,
+                       UA_AddNodesResult *results);
+
 UA_StatusCode UA_EXPORT
 UA_Server_addDataSourceVariableNode(UA_Server *server,
                                     const UA_NodeId requestedNewNodeId,
@@ -10560,6 +10826,13 @@ UA_Server_deleteReference(UA_Server *server, const UA_NodeId sourceNodeId,
                           const UA_ExpandedNodeId targetNodeId,
                           UA_Boolean deleteBidirectional);
 
+/* Reserves room for referencesSize more references in the node. Use this
+ * before many children are added to a node one by one. With multithreading,
+ * every edit copies the node and the reserved room is not retained. */
+UA_StatusCode UA_EXPORT
+UA_Server_reserveReferences(UA_Server *server, const UA_NodeId nodeId,
+                            size_t referencesSize);
+
 #ifdef __cplusplus
 }
 #endif
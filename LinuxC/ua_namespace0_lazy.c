@@ -0,0 +1,368 @@
+/* Generated by gen_namespace0.c. Do not edit. */
+
+#ifdef UA_ENABLE_MULTITHREADING
+# error The lazy namespace 0 requires the single-threaded nodestore
+#endif
+
+static const char ns0LazyNames[] =
+    "\0"
+    "Boolean\0"
+    "SByte\0"
+    "Byte\0"
+    "Int16\0"
+    "UInt16\0"
+    "Int32\0"
+    "UInt32\0"
+    "Int64\0"
+    "UInt64\0"
+    "Float\0"
+    "Double\0"
+    "String\0"
+    "DateTime\0"
+    "Guid\0"
+    "ByteString\0"
+    "XmlElement\0"
+    "NodeId\0"
+    "ExpandedNodeId\0"
+    "StatusCode\0"
+    "QualifiedName\0"
+    "LocalizedText\0"
+    "Structure\0"
+    "DataValue\0"
+    "BaseDataType\0"
+    "DiagnosticInfo\0"
+    "Number\0"
+    "Integer\0"
+    "UInteger\0"
+    "Enumeration\0"
+    "References\0"
+    "NonHierarchicalReferences\0"
+    "HierarchicalReferences\0"
+    "HasChild\0"
+    "Organizes\0"
+    "OrganizedBy\0"
+    "HasEventSource\0"
+    "EventSourceOf\0"
+    "HasModellingRule\0"
+    "ModellingRuleOf\0"
+    "HasEncoding\0"
+    "EncodingOf\0"
+    "HasDescription\0"
+    "DescriptionOf\0"
+    "HasTypeDefinition\0"
+    "TypeDefinitionOf\0"
+    "GeneratesEvent\0"
+    "GeneratedBy\0"
+    "Aggregates\0"
+    "AggregatedBy\0"
+    "HasSubtype\0"
+    "HasSupertype\0"
+    "HasProperty\0"
+    "PropertyOf\0"
+    "HasComponent\0"
+    "ComponentOf\0"
+    "HasNotifier\0"
+    "NotifierOf\0"
+    "HasOrderedComponent\0"
+    "OrderedComponentOf\0"
+    "HasModelParent\0"
+    "ModelParentOf\0"
+    "FromState\0"
+    "ToTransition\0"
+    "ToState\0"
+    "FromTransition\0"
+    "HasCause\0"
+    "MayBeCausedBy\0"
+    "HasEffect\0"
+    "MayBeEffectedBy\0"
+    "HasHistoricalConfiguration\0"
+    "HistoricalConfigurationOf\0"
+    "BaseObjectType\0"
+    "FolderType\0"
+    "BaseVariableType\0"
+    "BaseDataVariableType\0"
+    "PropertyType\0"
+    "ModellingRuleType\0"
+    "Mandatory\0"
+    "Optional\0"
+    "Root\0"
+    "Objects\0"
+    "Types\0"
+    "Views\0"
+    "ObjectTypes\0"
+    "VariableTypes\0"
+    "DataTypes\0"
+    "ReferenceTypes\0"
+    "BuildInfo\0"
+    "ServerState\0"
+    "ServerStatusDataType\0"
+    "ServerType\0"
+    "ServerCapatilitiesType\0"
+    "ServerDiagnosticsType\0"
+    "ServerStatusType\0"
+    "EventTypes\0"
+    "BuildInfoType\0";
+
+static const UA_LazyReference ns0LazyReferences[170] = {
+    /* target, reference type, inverse */
+    {24u, 45, true},
+    {27u, 45, true},
+    {28u, 45, true},
+    {27u, 45, true},
+    {28u, 45, true},
+    {27u, 45, true},
+    {28u, 45, true},
+    {27u, 45, true},
+    {28u, 45, true},
+    {26u, 45, true},
+    {26u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {862u, 45, false},
+    {338u, 45, false},
+    {24u, 45, true},
+    {1u, 45, false},
+    {26u, 45, false},
+    {12u, 45, false},
+    {13u, 45, false},
+    {14u, 45, false},
+    {15u, 45, false},
+    {16u, 45, false},
+    {17u, 45, false},
+    {18u, 45, false},
+    {19u, 45, false},
+    {20u, 45, false},
+    {21u, 45, false},
+    {22u, 45, false},
+    {23u, 45, false},
+    {25u, 45, false},
+    {29u, 45, false},
+    {90u, 35, true},
+    {24u, 45, true},
+    {24u, 45, true},
+    {10u, 45, false},
+    {11u, 45, false},
+    {27u, 45, false},
+    {26u, 45, true},
+    {2u, 45, false},
+    {4u, 45, false},
+    {6u, 45, false},
+    {8u, 45, false},
+    {28u, 45, false},
+    {27u, 45, true},
+    {3u, 45, false},
+    {5u, 45, false},
+    {7u, 45, false},
+    {9u, 45, false},
+    {24u, 45, true},
+    {852u, 45, false},
+    {33u, 45, false},
+    {32u, 45, false},
+    {91u, 35, true},
+    {31u, 45, true},
+    {37u, 45, false},
+    {38u, 45, false},
+    {39u, 45, false},
+    {40u, 45, false},
+    {41u, 45, false},
+    {50u, 45, false},
+    {51u, 45, false},
+    {52u, 45, false},
+    {53u, 45, false},
+    {54u, 45, false},
+    {31u, 45, true},
+    {34u, 45, false},
+    {35u, 45, false},
+    {36u, 45, false},
+    {33u, 45, true},
+    {44u, 45, false},
+    {45u, 45, false},
+    {33u, 45, true},
+    {33u, 45, true},
+    {48u, 45, false},
+    {32u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {34u, 45, true},
+    {46u, 45, false},
+    {47u, 45, false},
+    {56u, 45, false},
+    {34u, 45, true},
+    {44u, 45, true},
+    {44u, 45, true},
+    {49u, 45, false},
+    {36u, 45, true},
+    {47u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {32u, 45, true},
+    {44u, 45, true},
+    {77u, 45, false},
+    {61u, 45, false},
+    {2004u, 45, false},
+    {2020u, 45, false},
+    {2013u, 45, false},
+    {88u, 35, true},
+    {58u, 45, true},
+    {84u, 40, true},
+    {85u, 40, true},
+    {86u, 40, true},
+    {91u, 40, true},
+    {90u, 40, true},
+    {89u, 40, true},
+    {88u, 40, true},
+    {3048u, 40, true},
+    {87u, 40, true},
+    {63u, 45, false},
+    {68u, 45, false},
+    {89u, 35, true},
+    {62u, 45, true},
+    {3051u, 45, false},
+    {2138u, 45, false},
+    {62u, 45, true},
+    {58u, 45, true},
+    {78u, 40, true},
+    {80u, 40, true},
+    {77u, 40, false},
+    {77u, 40, false},
+    {61u, 40, false},
+    {85u, 35, false},
+    {86u, 35, false},
+    {87u, 35, false},
+    {84u, 35, true},
+    {61u, 40, false},
+    {84u, 35, true},
+    {61u, 40, false},
+    {91u, 35, false},
+    {90u, 35, false},
+    {89u, 35, false},
+    {88u, 35, false},
+    {3048u, 35, false},
+    {84u, 35, true},
+    {61u, 40, false},
+    {86u, 35, true},
+    {61u, 40, false},
+    {58u, 35, false},
+    {86u, 35, true},
+    {61u, 40, false},
+    {62u, 35, false},
+    {86u, 35, true},
+    {61u, 40, false},
+    {24u, 35, false},
+    {86u, 35, true},
+    {61u, 40, false},
+    {31u, 35, false},
+    {22u, 45, true},
+    {29u, 45, true},
+    {22u, 45, true},
+    {58u, 45, true},
+    {58u, 45, true},
+    {58u, 45, true},
+    {63u, 45, true},
+    {86u, 35, true},
+    {61u, 40, false},
+    {63u, 45, true},
+};
+
+static const UA_LazyNode ns0LazyNodes[77] = {
+    /* id, data type, value rank, name, inverse name, references,
+     * number of references, node class, flags, event notifier */
+    {1u, 0u, 0, 1, 0, 0, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Boolean */
+    {2u, 0u, 0, 9, 0, 1, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* SByte */
+    {3u, 0u, 0, 15, 0, 2, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Byte */
+    {4u, 0u, 0, 20, 0, 3, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Int16 */
+    {5u, 0u, 0, 26, 0, 4, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* UInt16 */
+    {6u, 0u, 0, 33, 0, 5, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Int32 */
+    {7u, 0u, 0, 39, 0, 6, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* UInt32 */
+    {8u, 0u, 0, 46, 0, 7, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Int64 */
+    {9u, 0u, 0, 52, 0, 8, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* UInt64 */
+    {10u, 0u, 0, 59, 0, 9, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Float */
+    {11u, 0u, 0, 65, 0, 10, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Double */
+    {12u, 0u, 0, 72, 0, 11, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* String */
+    {13u, 0u, 0, 79, 0, 12, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* DateTime */
+    {14u, 0u, 0, 88, 0, 13, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* Guid */
+    {15u, 0u, 0, 93, 0, 14, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* ByteString */
+    {16u, 0u, 0, 104, 0, 15, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* XmlElement */
+    {17u, 0u, 0, 115, 0, 16, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* NodeId */
+    {18u, 0u, 0, 122, 0, 17, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* ExpandedNodeId */
+    {19u, 0u, 0, 137, 0, 18, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* StatusCode */
+    {20u, 0u, 0, 148, 0, 19, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* QualifiedName */
+    {21u, 0u, 0, 162, 0, 20, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* LocalizedText */
+    {22u, 0u, 0, 176, 0, 21, 3, UA_NODECLASS_DATATYPE, 0x01, 0}, /* Structure */
+    {23u, 0u, 0, 186, 0, 24, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* DataValue */
+    {24u, 0u, 0, 196, 0, 25, 17, UA_NODECLASS_DATATYPE, 0x01, 0}, /* BaseDataType */
+    {25u, 0u, 0, 209, 0, 42, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* DiagnosticInfo */
+    {26u, 0u, 0, 224, 0, 43, 4, UA_NODECLASS_DATATYPE, 0x01, 0}, /* Number */
+    {27u, 0u, 0, 231, 0, 47, 6, UA_NODECLASS_DATATYPE, 0x01, 0}, /* Integer */
+    {28u, 0u, 0, 239, 0, 53, 5, UA_NODECLASS_DATATYPE, 0x01, 0}, /* UInteger */
+    {29u, 0u, 0, 248, 0, 58, 2, UA_NODECLASS_DATATYPE, 0x01, 0}, /* Enumeration */
+    {31u, 0u, 0, 260, 260, 60, 3, UA_NODECLASS_REFERENCETYPE, 0x03, 0}, /* References */
+    {32u, 0u, 0, 271, 0, 63, 11, UA_NODECLASS_REFERENCETYPE, 0x01, 0}, /* NonHierarchicalReferences */
+    {33u, 0u, 0, 297, 0, 74, 4, UA_NODECLASS_REFERENCETYPE, 0x01, 0}, /* HierarchicalReferences */
+    {34u, 0u, 0, 320, 0, 78, 3, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasChild */
+    {35u, 0u, 0, 329, 339, 81, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* Organizes */
+    {36u, 0u, 0, 351, 366, 82, 2, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasEventSource */
+    {37u, 0u, 0, 380, 397, 84, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasModellingRule */
+    {38u, 0u, 0, 413, 425, 85, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasEncoding */
+    {39u, 0u, 0, 436, 451, 86, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasDescription */
+    {40u, 0u, 0, 465, 483, 87, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasTypeDefinition */
+    {41u, 0u, 0, 500, 515, 88, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* GeneratesEvent */
+    {44u, 0u, 0, 527, 538, 89, 4, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* Aggregates */
+    {45u, 0u, 0, 551, 562, 93, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasSubtype */
+    {46u, 0u, 0, 575, 587, 94, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasProperty */
+    {47u, 0u, 0, 598, 611, 95, 2, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasComponent */
+    {48u, 0u, 0, 623, 635, 97, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasNotifier */
+    {49u, 0u, 0, 646, 666, 98, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasOrderedComponent */
+    {50u, 0u, 0, 685, 700, 99, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasModelParent */
+    {51u, 0u, 0, 714, 724, 100, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* FromState */
+    {52u, 0u, 0, 737, 745, 101, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* ToState */
+    {53u, 0u, 0, 760, 769, 102, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasCause */
+    {54u, 0u, 0, 783, 793, 103, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasEffect */
+    {56u, 0u, 0, 809, 836, 104, 1, UA_NODECLASS_REFERENCETYPE, 0x00, 0}, /* HasHistoricalConfiguration */
+    {58u, 0u, 0, 862, 0, 105, 6, UA_NODECLASS_OBJECTTYPE, 0x00, 0}, /* BaseObjectType */
+    {61u, 0u, 0, 877, 0, 111, 10, UA_NODECLASS_OBJECTTYPE, 0x00, 0}, /* FolderType */
+    {62u, 24u, -2, 888, 0, 121, 3, UA_NODECLASS_VARIABLETYPE, 0x01, 0}, /* BaseVariableType */
+    {63u, 24u, -2, 905, 0, 124, 3, UA_NODECLASS_VARIABLETYPE, 0x00, 0}, /* BaseDataVariableType */
+    {68u, 24u, -2, 926, 0, 127, 1, UA_NODECLASS_VARIABLETYPE, 0x00, 0}, /* PropertyType */
+    {77u, 0u, 0, 939, 0, 128, 3, UA_NODECLASS_OBJECTTYPE, 0x00, 0}, /* ModellingRuleType */
+    {78u, 0u, 0, 957, 0, 131, 1, UA_NODECLASS_OBJECT, 0x00, 0}, /* Mandatory */
+    {80u, 0u, 0, 967, 0, 132, 1, UA_NODECLASS_OBJECT, 0x00, 0}, /* Optional */
+    {84u, 0u, 0, 976, 0, 133, 4, UA_NODECLASS_OBJECT, 0x00, 0}, /* Root */
+    {85u, 0u, 0, 981, 0, 137, 2, UA_NODECLASS_OBJECT, 0x00, 0}, /* Objects */
+    {86u, 0u, 0, 989, 0, 139, 7, UA_NODECLASS_OBJECT, 0x00, 0}, /* Types */
+    {87u, 0u, 0, 995, 0, 146, 2, UA_NODECLASS_OBJECT, 0x00, 0}, /* Views */
+    {88u, 0u, 0, 1001, 0, 148, 3, UA_NODECLASS_OBJECT, 0x00, 0}, /* ObjectTypes */
+    {89u, 0u, 0, 1013, 0, 151, 3, UA_NODECLASS_OBJECT, 0x00, 0}, /* VariableTypes */
+    {90u, 0u, 0, 1027, 0, 154, 3, UA_NODECLASS_OBJECT, 0x00, 0}, /* DataTypes */
+    {91u, 0u, 0, 1037, 0, 157, 3, UA_NODECLASS_OBJECT, 0x00, 0}, /* ReferenceTypes */
+    {338u, 0u, 0, 1052, 0, 160, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* BuildInfo */
+    {852u, 0u, 0, 1062, 0, 161, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* ServerState */
+    {862u, 0u, 0, 1074, 0, 162, 1, UA_NODECLASS_DATATYPE, 0x00, 0}, /* ServerStatusDataType */
+    {2004u, 0u, 0, 1095, 0, 163, 1, UA_NODECLASS_OBJECTTYPE, 0x00, 0}, /* ServerType */
+    {2013u, 0u, 0, 1106, 0, 164, 1, UA_NODECLASS_OBJECTTYPE, 0x00, 0}, /* ServerCapatilitiesType */
+    {2020u, 0u, 0, 1129, 0, 165, 1, UA_NODECLASS_OBJECTTYPE, 0x00, 0}, /* ServerDiagnosticsType */
+    {2138u, 862u, -1, 1151, 0, 166, 1, UA_NODECLASS_VARIABLETYPE, 0x00, 0}, /* ServerStatusType */
+    {3048u, 0u, 0, 1168, 0, 167, 2, UA_NODECLASS_OBJECT, 0x00, 0}, /* EventTypes */
+    {3051u, 338u, -1, 1179, 0, 169, 1, UA_NODECLASS_VARIABLETYPE, 0x00, 0}, /* BuildInfoType */
+};
+
+static const UA_LazyNamespace ns0Lazy = {
+    ns0LazyNodes, 77, ns0LazyReferences, ns0LazyNames, "en_US"};
+
+static UA_StatusCode
+addLazyNamespace0(UA_NodeStore *ns) {
+    return UA_NodeStore_insertLazy(ns, &ns0Lazy);
+}
@@ -765,6 +765,16 @@ int __secs_to_tm(long long t, struct tm *tm);
 # define UA_THREAD_LOCAL
 #endif
 
+/* Prefetching
+ * -----------
+ * Loads memory into the cache ahead of its use. Does nothing on compilers
+ * without a prefetch builtin. Invalid addresses do not fault. */
+#if defined(__GNUC__) || defined(__clang__)
+# define UA_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+# define UA_PREFETCH(ptr)
+#endif
+
 /* Atomic Operations
  * -----------------
  * Atomic operations that synchronize across processor cores (for
@@ -848,6 +858,13 @@ UA_decodeBinary(const UA_ByteString *src, size_t *offset, void *dst,
 
 size_t UA_calcSizeBinary(void *p, const UA_DataType *type);
 
+/* Appends bytes that are already encoded. The buffer is exchanged when its end
+ * is reached. So the bytes may be split over several chunks. */
+UA_StatusCode
+UA_encodeBinaryRaw(const UA_ByteString *src,
+                   UA_exchangeEncodeBuffer exchangeCallback, void *exchangeHandle,
+                   UA_ByteString *dst, size_t *offset) UA_FUNC_ATTR_WARN_UNUSED_RESULT;
+
 
 /*********************************** amalgamated original file "/home/travis/build/open62541/open62541/build/src_generated/ua_types_generated_encoding_binary.h" ***********************************/
 
@@ -3237,6 +3254,29 @@ UA_Session * UA_SecureChannel_getSession(UA_SecureChannel *channel, UA_NodeId *t
 UA_StatusCode UA_SecureChannel_sendBinaryMessage(UA_SecureChannel *channel, UA_UInt32 requestId,
                                                   const void *content, const UA_DataType *contentType);
 
+/* Sends a response where everything after the ResponseHeader is already
+ * encoded */
+UA_StatusCode
+UA_SecureChannel_sendEncodedResponse(UA_SecureChannel *channel, UA_UInt32 requestId,
+                                     const UA_DataType *responseType,
+                                     const UA_ResponseHeader *responseHeader,
+                                     const UA_ByteString *body);
+
+/* Encodes the fields of a response after the ResponseHeader. Called with the
+ * chunking callback of the channel. */
+typedef UA_StatusCode
+(*UA_SecureChannel_encodeBody)(const void *body, UA_exchangeEncodeBuffer exchangeCallback,
+                               void *exchangeHandle, UA_ByteString *dst, size_t *offset);
+
+/* Sends a response where everything after the ResponseHeader is encoded by the
+ * callback */
+UA_StatusCode
+UA_SecureChannel_sendCustomResponse(UA_SecureChannel *channel, UA_UInt32 requestId,
+                                    const UA_DataType *responseType,
+                                    const UA_ResponseHeader *responseHeader,
+                                    UA_SecureChannel_encodeBody encodeBody,
+                                    const void *body);
+
 void UA_SecureChannel_revolveTokens(UA_SecureChannel *channel);
 
 /**
@@ -3334,6 +3374,13 @@ extern "C" {
  * Internally, open62541 uses ``UA_Node`` in places where the exact node type is
  * not known or not important. The ``nodeClass`` attribute is used to ensure the
  * correctness of casting from ``UA_Node`` to a specific node type. */
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+/* Encoded values of the attributes besides the Value (internal to the node) */
+# define UA_NODE_ATTRIBUTECACHE struct UA_EncodedAttributes *encodedAttributes;
+#else
+# define UA_NODE_ATTRIBUTECACHE
+#endif
+
 #define UA_NODE_BASEATTRIBUTES                  \
     UA_NodeId nodeId;                           \
     UA_NodeClass nodeClass;                     \
@@ -3343,7 +3390,10 @@ extern "C" {
     UA_UInt32 writeMask;                        \
     UA_UInt32 userWriteMask;                    \
     size_t referencesSize;                      \
-    UA_ReferenceNode *references;
+    size_t referencesCapacity;                  \
+    UA_ReferenceNode *references;               \
+    struct UA_ReferenceIndex *referenceIndex;   \
+    UA_NODE_ATTRIBUTECACHE
 
 typedef struct {
     UA_NODE_BASEATTRIBUTES
@@ -3445,6 +3495,15 @@ typedef struct {
     UA_Byte userAccessLevel;
     UA_Double minimumSamplingInterval;
     UA_Boolean historizing; /* currently unsupported */
+#ifdef UA_ENABLE_MULTITHREADING
+    /* The current value is published via RCU in a slot that is shared by all
+     * versions of the node in the nodestore. Value writes replace the value in
+     * the slot and do not copy the node. */
+    struct UA_ValueSlot *valueSlot;
+#endif
+    /* Optional cache for the values read from a data source. Shared by all
+     * versions of the node in the nodestore. */
+    struct UA_ValueCache *valueCache;
 } UA_VariableNode;
 
 /**
@@ -3684,11 +3743,24 @@ typedef struct {
 
 #define UA_MAXCONTINUATIONPOINTS 5
 
+/* Nodes registered with the RegisterNodes service get a numeric alias in a
+ * namespace that is not used for nodes. The alias is the position in the
+ * table of the session + 1. The hash of the original NodeId is computed once
+ * during registration. */
+#define UA_REGISTEREDNODES_NAMESPACE UA_UINT16_MAX
+#define UA_MAXREGISTEREDNODES 100000
+
+typedef struct {
+    UA_NodeId nodeId; /* null if the position is free */
+    UA_UInt32 hash;   /* nodestore hash of the nodeId */
+} UA_RegisteredNode;
+
 struct ContinuationPointEntry {
     LIST_ENTRY(ContinuationPointEntry) pointers;
     UA_ByteString        identifier;
     UA_BrowseDescription browseDescription;
-    UA_UInt32            continuationIndex;
+    size_t               referenceGroup;    /* position of the reference iterator */
+    size_t               referencePosition;
     UA_UInt32            maxReferences;
 };
 
@@ -3716,6 +3788,10 @@ struct UA_Session {
     UA_SecureChannel *channel;
     UA_UInt16 availableContinuationPoints;
     LIST_HEAD(ContinuationPointList, ContinuationPointEntry) continuationPoints;
+    size_t registeredNodesSize;
+    size_t registeredNodesCount;
+    size_t registeredNodesFree; /* no free position below */
+    UA_RegisteredNode *registeredNodes;
 #ifdef UA_ENABLE_SUBSCRIPTIONS
     UA_UInt32 lastSubscriptionID;
     LIST_HEAD(UA_ListOfUASubscriptions, UA_Subscription) serverSubscriptions;
@@ -3733,6 +3809,21 @@ void UA_Session_deleteMembersCleanup(UA_Session *session, UA_Server *server);
 /* If any activity on a session happens, the timeout is extended */
 void UA_Session_updateLifetime(UA_Session *session);
 
+/* Writes the alias for the NodeId. Numeric NodeIds are cheap to look up and
+ * are returned unchanged. So are all NodeIds when the table is full. */
+UA_StatusCode UA_Session_registerNode(UA_Session *session, const UA_NodeId *nodeId,
+                                      UA_NodeId *alias);
+
+/* Frees the position of the alias. Other NodeIds are ignored. */
+void UA_Session_unregisterNode(UA_Session *session, const UA_NodeId *alias);
+
+/* Returns the registered node for an alias of the session or NULL */
+const UA_RegisteredNode *
+UA_Session_getRegisteredNode(const UA_Session *session, const UA_NodeId *alias);
+
+/* Returns the original NodeId for aliases and the NodeId itself otherwise */
+const UA_NodeId * UA_Session_resolveNodeId(const UA_Session *session, const UA_NodeId *nodeId);
+
 #ifdef UA_ENABLE_SUBSCRIPTIONS
 void UA_Session_addSubscription(UA_Session *session, UA_Subscription *newSubscription);
 
@@ -3993,9 +4084,35 @@ void UA_NodeStore_deleteNode(UA_Node *node);
  * deleted. */
 UA_StatusCode UA_NodeStore_insert(UA_NodeStore *ns, UA_Node *node);
 
+/* Makes room for additional nodes, so that they can be inserted without
+ * growing the nodestore in between. */
+UA_StatusCode UA_NodeStore_reserve(UA_NodeStore *ns, size_t additional);
+
+/* Inserts several nodes after reserving room for all of them. The status of
+ * every insertion is written into results. Nodes that could not be inserted
+ * are deleted. */
+void UA_NodeStore_insertBatch(UA_NodeStore *ns, UA_Node **nodes, size_t nodesSize,
+                              UA_StatusCode *results);
+
 /* The returned node is immutable. */
 const UA_Node * UA_NodeStore_get(UA_NodeStore *ns, const UA_NodeId *nodeid);
 
+/* The hash of a NodeId in the nodestore. It can be kept for NodeIds that are
+ * looked up repeatedly. */
+UA_UInt32 UA_NodeStore_hash(const UA_NodeId *nodeid);
+
+/* Same as UA_NodeStore_get with the hash from UA_NodeStore_hash */
+const UA_Node * UA_NodeStore_getHashed(UA_NodeStore *ns, const UA_NodeId *nodeid,
+                                       UA_UInt32 hash);
+
+/* Hints that the NodeId will be looked up soon. Loads the memory of the
+ * lookup into the cache if the platform supports prefetching. The first call
+ * loads the slots of the hash-map. Once they are loaded, the second call
+ * (entry = true) loads the node stored under the hash. Lookups of many
+ * NodeIds are faster when every stage is issued for all of them first. */
+void UA_NodeStore_prefetch(UA_NodeStore *ns, const UA_NodeId *nodeid, UA_UInt32 hash,
+                           UA_Boolean entry);
+
 /* Returns an editable copy of a node (needs to be deleted with the deleteNode
    function or inserted / replaced into the nodestore). */
 UA_Node * UA_NodeStore_getCopy(UA_NodeStore *ns, const UA_NodeId *nodeid);
@@ -4010,6 +4127,12 @@ UA_StatusCode UA_NodeStore_replace(UA_NodeStore *ns, UA_Node *node);
 /* Remove a node in the nodestore. */
 UA_StatusCode UA_NodeStore_remove(UA_NodeStore *ns, const UA_NodeId *nodeid);
 
+#ifndef UA_ENABLE_MULTITHREADING
+/* Changes whenever a node is replaced or removed. Pointers to nodes remain
+ * valid while the version is unchanged. */
+UA_UInt32 UA_NodeStore_getVersion(const UA_NodeStore *ns);
+#endif
+
 /**
  * Iteration
  * ^^^^^^^^^
@@ -4018,6 +4141,92 @@ UA_StatusCode UA_NodeStore_remove(UA_NodeStore *ns, const UA_NodeId *nodeid);
 typedef void (*UA_NodeStore_nodeVisitor)(const UA_Node *node);
 void UA_NodeStore_iterate(UA_NodeStore *ns, UA_NodeStore_nodeVisitor visitor);
 
+/* Adds the memory used by the nodes to the report entries of their node
+ * class */
+void UA_NodeStore_memoryReport(UA_NodeStore *ns, UA_NodeMemoryReport *report);
+
+#ifndef UA_ENABLE_MULTITHREADING
+/**
+ * Read-Only Nodes
+ * ^^^^^^^^^^^^^^^
+ * The nodes can be stored in an image that is used in place after loading.
+ * Function pointers and handles are not stored. The image is only valid for
+ * the same build of the library. Nodes can also be compiled into constant
+ * memory (see gen_namespace0.c). */
+
+/* Writes all nodes and the namespace array into a newly allocated image. */
+UA_StatusCode
+UA_NodeStore_saveImage(UA_NodeStore *ns, const UA_String *namespaces,
+                       size_t namespacesSize, UA_ByteString *image);
+
+/* Inserts the nodes of an image into an empty nodestore. The image is relocated
+ * in place and must outlive the nodestore. The returned namespace array points
+ * into the image. */
+UA_StatusCode
+UA_NodeStore_loadImage(UA_NodeStore *ns, UA_Byte *image, size_t imageSize,
+                       const UA_String **namespaces, size_t *namespacesSize);
+
+/* Inserts nodes from constant memory. The nodes are laid out as nodestore
+ * entries in the memory block [nodes, nodes + nodesSize). They are used in
+ * place and never freed. */
+UA_StatusCode
+UA_NodeStore_insertConst(UA_NodeStore *ns, const void *nodes, size_t nodesSize,
+                         const UA_Node * const *nodeList, size_t nodeListSize);
+
+/* Nodes from the image or from constant memory must not be edited in place.
+ * Use getCopy and replace. */
+UA_Boolean UA_NodeStore_isReadOnly(UA_NodeStore *ns, const UA_Node *node);
+
+/**
+ * Lazy Nodes
+ * ^^^^^^^^^^
+ * Nodes of namespace 0 can be described by a compact table (see
+ * gen_namespace0.c). They are materialised on the heap when they are first
+ * looked up. Until then, a node takes only its slot in the directly indexed
+ * array of namespace 0. */
+
+#define UA_LAZYNODE_ISABSTRACT 0x01
+#define UA_LAZYNODE_SYMMETRIC 0x02
+#define UA_LAZYNODE_CONTAINSNOLOOPS 0x04
+
+/* BrowseName, DisplayName and Description of a lazy node have the same text.
+ * Names are offsets into the pool of zero-terminated names. Offset 0 is the
+ * empty name. */
+typedef struct {
+    UA_UInt32 id;          /* numeric identifier in namespace 0 */
+    UA_UInt32 dataType;    /* variable types */
+    UA_Int32 valueRank;    /* variable types */
+    UA_UInt16 name;
+    UA_UInt16 inverseName; /* reference types */
+    UA_UInt16 references;  /* position of the first reference */
+    UA_UInt16 referencesSize;
+    UA_Byte nodeClass;
+    UA_Byte flags;         /* UA_LAZYNODE_* */
+    UA_Byte eventNotifier; /* objects and views */
+} UA_LazyNode;
+
+/* The target and the reference type are numeric nodeids in namespace 0 */
+typedef struct {
+    UA_UInt32 targetId;
+    UA_UInt16 referenceTypeId;
+    UA_Boolean isInverse;
+} UA_LazyReference;
+
+typedef struct {
+    const UA_LazyNode *nodes;
+    size_t nodesSize;
+    const UA_LazyReference *references;
+    const char *names;
+    const char *locale; /* of all DisplayNames, Descriptions and InverseNames */
+} UA_LazyNamespace;
+
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+/* Registers the nodes of the table without materialising them. The table must
+ * outlive the nodestore. */
+UA_StatusCode UA_NodeStore_insertLazy(UA_NodeStore *ns, const UA_LazyNamespace *lazy);
+#endif
+#endif
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -4187,11 +4396,85 @@ typedef struct {
 extern UA_THREAD_LOCAL UA_Session* methodCallSession;
 #endif
 
+/* The subtypes of a type node (including the type itself) with a hash set for
+ * membership tests. Closures are cached in the server until a HasSubtype
+ * reference below the type changes. */
+typedef struct UA_TypeClosure {
+#ifdef UA_ENABLE_MULTITHREADING
+    struct rcu_head rcu_head;
+#endif
+    size_t typesSize;
+    UA_NodeId *types; /* types[0] is the root */
+    UA_UInt32 slotsSize; /* power of two, at most half full */
+    UA_UInt32 *slots;    /* position in types + 1, 0 if empty */
+} UA_TypeClosure;
+
+typedef struct {
+    size_t closuresSize; /* power of two */
+    size_t closuresCount;
+    UA_TypeClosure **closures; /* linear probing with the hash of the root */
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_t mutex;
+#endif
+} UA_TypeClosureCache;
+
+/* The mandatory members of a type (including the members inherited from the
+ * supertypes) or of an instance declaration that is copied into new instances.
+ * Plans are cached in the server until the members of a type change. */
+typedef struct {
+    UA_NodeId nodeId;
+    UA_NodeId referenceTypeId;
+    UA_QualifiedName browseName;
+    UA_NodeClass nodeClass;
+} UA_InstantiationMember;
+
+typedef struct UA_InstantiationPlan {
+    UA_NodeId source;
+    size_t membersSize;
+    UA_InstantiationMember *members;
+    UA_UInt32 refCount; /* the cache holds one reference */
+} UA_InstantiationPlan;
+
+typedef struct {
+    size_t plansSize; /* power of two */
+    size_t plansCount;
+    UA_InstantiationPlan **plans; /* linear probing with the hash of the source */
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_t mutex;
+#endif
+} UA_InstantiationPlanCache;
+
+/* Encoded GetEndpoints and FindServers responses (everything after the
+ * ResponseHeader) for the parameters of the request. The responses depend only
+ * on the configuration. The cache is cleared when the network layers are
+ * started and the discovery urls are known. */
+#define UA_DISCOVERYCACHE_SIZE 8
+
+typedef struct {
+    const UA_DataType *requestType;
+    UA_String endpointUrl;
+    size_t localeIdsSize;
+    UA_String *localeIds;
+    size_t urisSize; /* profileUris for GetEndpoints, serverUris for FindServers */
+    UA_String *uris;
+    UA_ByteString body;
+} UA_DiscoveryResponse;
+
+typedef struct {
+    size_t responsesSize;
+    size_t next; /* the entry that is replaced next when the cache is full */
+    UA_DiscoveryResponse responses[UA_DISCOVERYCACHE_SIZE];
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_t mutex;
+#endif
+} UA_DiscoveryCache;
+
 struct UA_Server {
     /* Meta */
     UA_DateTime startTime;
     size_t endpointDescriptionsSize;
     UA_EndpointDescription *endpointDescriptions;
+    UA_DiscoveryCache discoveryCache;
 
     /* Security */
     UA_SecureChannelManager secureChannelManager;
@@ -4199,6 +4482,8 @@ struct UA_Server {
 
     /* Address Space */
     UA_NodeStore *nodestore;
+    UA_TypeClosureCache typeClosures;
+    UA_InstantiationPlanCache instantiationPlans;
 
     size_t namespacesSize;
     UA_String *namespaces;
@@ -4213,6 +4498,10 @@ struct UA_Server {
 
 #ifndef UA_ENABLE_MULTITHREADING
     SLIST_HEAD(DelayedJobsList, UA_DelayedJob) delayedCallbacks;
+
+    /* The nodes loaded with UA_Server_newFromImage */
+    void *image;
+    size_t imageSize;
 #else
     /* Dispatch queue head for the worker threads (the tail should not be in the same cache line) */
     struct cds_wfcq_head dispatchQueue_head;
@@ -4237,11 +4526,187 @@ struct UA_Server {
 void UA_Node_deleteMembersAnyNodeClass(UA_Node *node);
 UA_StatusCode UA_Node_copyAnyNodeClass(const UA_Node *src, UA_Node *dst);
 
+/* Copy and delete the LocalizedTexts of nodes. With UA_ENABLE_COMPACT_NODES,
+ * the locales are shared between all nodes. */
+#ifdef UA_ENABLE_COMPACT_NODES
+UA_StatusCode UA_Node_copyText(const UA_LocalizedText *src, UA_LocalizedText *dst);
+void UA_Node_deleteText(UA_LocalizedText *text);
+#else
+# define UA_Node_copyText UA_LocalizedText_copy
+# define UA_Node_deleteText UA_LocalizedText_deleteMembers
+#endif
+
+/* Moves the LocalizedText into a node. src is empty afterwards. With
+ * UA_ENABLE_COMPACT_NODES, the locale of src is replaced by a shared locale. */
+void UA_Node_moveText(UA_LocalizedText *src, UA_LocalizedText *dst);
+
+/* Returns the DisplayName without copying. With UA_ENABLE_COMPACT_NODES, the
+ * DisplayName of nodes without a text (NULL string) is taken from the
+ * BrowseName. */
+void UA_Node_getDisplayName(const UA_Node *node, UA_LocalizedText *displayName);
+
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+/* The attributes besides the Value change only when the node is edited. Their
+ * values are encoded once when a client reads them and kept in a table in the
+ * node. The table is not copied with the node. Edits in place detach the table
+ * with UA_Node_takeEncodedAttributes. */
+typedef struct UA_EncodedAttributes {
+    /* Binary encoded Variants at the index attributeId - 1 */
+    UA_ByteString *attributes[UA_ATTRIBUTEID_USEREXECUTABLE];
+} UA_EncodedAttributes;
+
+/* Returns NULL if the attribute was not encoded yet */
+const UA_ByteString *
+UA_Node_findEncodedAttribute(const UA_Node *node, UA_UInt32 attributeId);
+
+/* Encodes the value of the attribute and adds it to the table of the node. Safe
+ * for concurrent readers of the node. Returns NULL if the encoding failed. */
+const UA_ByteString *
+UA_Node_addEncodedAttribute(const UA_Node *node, UA_UInt32 attributeId,
+                            const UA_Variant *value);
+
+UA_EncodedAttributes * UA_Node_takeEncodedAttributes(UA_Node *node);
+void UA_EncodedAttributes_delete(UA_EncodedAttributes *encoded);
+#endif
+
+/* The references of nodes with many references are indexed by type, direction
+ * and target. The index is internal to the node and NULL for small nodes.
+ * Indexes the references from position first onwards after they were appended
+ * to the array. Builds the index once the node has enough references. */
+void UA_Node_indexReferences(UA_Node *node, size_t first);
+
+/* Returns the position of the reference or referencesSize if not found */
+size_t UA_Node_findReference(const UA_Node *node, const UA_NodeId *referenceTypeId,
+                             UA_Boolean isInverse, const UA_NodeId *target);
+
+/* Deletes the reference at the position. The last reference takes its place. */
+void UA_Node_removeReference(UA_Node *node, size_t pos);
+
+/* Makes room for count more references. The capacity of the references array
+ * grows geometrically so that appending single references is amortized O(1).
+ * A capacity below referencesSize (copied nodes) means the array is full. */
+UA_StatusCode UA_Node_growReferences(UA_Node *node, size_t count);
+
+/* Sets the capacity of the references array to at least capacity */
+UA_StatusCode UA_Node_reserveReferences(UA_Node *node, size_t capacity);
+
+/* The index also maps the BrowseNames of the targets of forward references to
+ * the references. Looks up the targets of the forward references that were
+ * added since the last call in the nodestore and indexes their BrowseName. */
+void UA_Node_nameReferenceTargets(UA_Node *node, UA_NodeStore *ns);
+
+/* Sets the indexed BrowseName of the target of the reference at the position
+ * (after the BrowseName of the target was changed) */
+void UA_Node_setReferenceTargetName(UA_Node *node, size_t pos,
+                                    const UA_QualifiedName *browseName);
+
+/* Iterates over the references with the direction and one of the reference
+ * types (all types if referenceTypesSize is 0). The order is the same for all
+ * iterations as long as the node is not changed. */
+typedef struct {
+    const UA_Node *node;
+    UA_BrowseDirection direction;
+    const UA_NodeId *referenceTypes;
+    size_t referenceTypesSize;
+    const struct UA_TypeClosure *referenceTypeClosure;
+    UA_Boolean byName;
+    UA_UInt32 nameHash;
+    size_t group;
+    size_t pos;
+} UA_ReferenceIterator;
+
+void UA_ReferenceIterator_init(UA_ReferenceIterator *it, const UA_Node *node,
+                               UA_BrowseDirection direction, const UA_NodeId *referenceTypes,
+                               size_t referenceTypesSize);
+
+/* Iterates over the references with a type from the subtype closure */
+void UA_ReferenceIterator_initSubtypes(UA_ReferenceIterator *it, const UA_Node *node,
+                                       UA_BrowseDirection direction,
+                                       const struct UA_TypeClosure *referenceTypes);
+
+/* Restricts a forward iteration to the references whose target has the
+ * BrowseName. Returns false (and the iterator is unchanged) if the names of
+ * the targets are not indexed. Otherwise, the iterator returns the matching
+ * references plus possibly some with a colliding hash of the name. */
+UA_Boolean UA_ReferenceIterator_setTargetName(UA_ReferenceIterator *it,
+                                              const UA_QualifiedName *browseName);
+
+/* Returns NULL when all references were visited */
+const UA_ReferenceNode * UA_ReferenceIterator_next(UA_ReferenceIterator *it);
+
+/* Adds the memory used by the node to the entry of its node class */
+void UA_Node_addToMemoryReport(const UA_Node *node, size_t nodeSize, UA_Boolean readOnly,
+                               UA_NodeMemoryReport *report);
+
+/* Returns the current value of a VariableNode or VariableTypeNode with an
+ * internal value (no data source) */
+const UA_DataValue * UA_VariableNode_getValue(const UA_VariableNode *vn);
+
+/* Values read from the data source of a VariableNode can be cached for Reads
+ * with a maxAge [ms]. The cache answers Reads that accept values older than
+ * the last read from the data source, bounded by the maxAge of the cache. A
+ * maxAge of zero removes the cache. */
+struct UA_ValueCache;
+UA_StatusCode UA_VariableNode_setValueCache(UA_VariableNode *vn, UA_Double maxAge);
+void UA_VariableNode_shareValueCache(const UA_VariableNode *src, UA_VariableNode *dst);
+struct UA_ValueCache * UA_ValueCache_retain(struct UA_ValueCache *cache);
+void UA_ValueCache_release(struct UA_ValueCache *cache);
+
+/* Returns false (and counts a miss) if the cached value is older than maxAge.
+ * Otherwise the (range of the) cached value is copied to v. */
+UA_Boolean UA_ValueCache_read(struct UA_ValueCache *cache, UA_Double maxAge,
+                              const UA_NumericRange *range, UA_DataValue *v,
+                              UA_StatusCode *retval);
+
+/* Stores a copy of the value that was read at the (monotonic) readTime */
+void UA_ValueCache_update(struct UA_ValueCache *cache, const UA_DataValue *value,
+                          UA_DateTime readTime);
+void UA_ValueCache_clear(struct UA_ValueCache *cache);
+void UA_ValueCache_getStatistics(struct UA_ValueCache *cache,
+                                 UA_ValueCacheStatistics *statistics);
+
+#ifdef UA_ENABLE_MULTITHREADING
+/* Value slots are attached when a VariableNode is inserted into the nodestore
+ * and shared with the copies made for editing */
+UA_StatusCode UA_VariableNode_initValueSlot(UA_VariableNode *vn);
+void UA_VariableNode_shareValueSlot(const UA_VariableNode *src, UA_VariableNode *dst);
+
+/* Publishes a new value in the slot. The members of value are moved into the
+ * slot. If expected is not NULL, the value is only published if the current
+ * value is still expected (from UA_VariableNode_getValue). Otherwise
+ * UA_STATUSCODE_BADINTERNALERROR is returned and the caller retries. */
+UA_StatusCode
+UA_VariableNode_publishValue(UA_VariableNode *vn, const UA_DataValue *expected,
+                             UA_DataValue *value);
+#endif
+
+/* Returns the node with the NodeId. Aliases from the RegisterNodes service are
+ * resolved without hashing the original NodeId again. */
+const UA_Node * UA_Server_getSessionNode(UA_Server *server, const UA_Session *session,
+                                         const UA_NodeId *nodeId);
+
+/* Handles keep the hash of the NodeId. Without multithreading, they also
+ * cache the node until the nodestore version changes. */
+struct UA_NodeHandle {
+    UA_NodeId nodeId;
+    UA_UInt32 hash;
+#ifndef UA_ENABLE_MULTITHREADING
+    const UA_Node *node;
+    UA_UInt32 version;
+#endif
+};
+
+/* Returns NULL if the node of the handle was deleted */
+const UA_Node * UA_Server_getHandleNode(UA_Server *server, UA_NodeHandle *handle);
+
 /* Calls callback on the node. In the multithreaded case, the node is copied before and replaced in
-   the nodestore. */
+   the nodestore. Aliases of registered nodes are resolved. */
 typedef UA_StatusCode (*UA_EditNodeCallback)(UA_Server*, UA_Session*, UA_Node*, const void*);
 UA_StatusCode UA_Server_editNode(UA_Server *server, UA_Session *session, const UA_NodeId *nodeId,
                                  UA_EditNodeCallback callback, const void *data);
+UA_StatusCode UA_Server_editNodeByHandle(UA_Server *server, UA_Session *session,
+                                         UA_NodeHandle *handle, UA_EditNodeCallback callback,
+                                         const void *data);
 
 /********************/
 /* Event Processing */
@@ -4297,6 +4762,38 @@ isNodeInTree(UA_NodeStore *ns, const UA_NodeId *leafNode,
              const UA_NodeId *nodeToFind, const UA_NodeId *referenceTypeIds,
              size_t referenceTypeIdsSize);
 
+/* Returns the cached subtype closure of the type node. Returns NULL if out of
+ * memory. The closure is valid until the end of the current service call
+ * (the RCU read-side critical section with multithreading). */
+const UA_TypeClosure *
+getTypeClosure(UA_Server *server, const UA_Node *root);
+
+UA_Boolean
+UA_TypeClosure_contains(const UA_TypeClosure *closure, const UA_NodeId *type);
+
+/* Is type equal to superType or (recursively) a subtype of it? */
+UA_Boolean
+isSubtypeOf(UA_Server *server, const UA_NodeId *type, const UA_NodeId *superType);
+
+/* Drops the cached closures containing the type. Called when a HasSubtype
+ * reference from the type is added or removed. */
+void
+invalidateTypeClosures(UA_Server *server, const UA_NodeId *superType);
+
+void
+deleteTypeClosures(UA_Server *server);
+
+/* Drops the cached instantiation plans. Plans in use remain valid until they
+ * are released. */
+void
+invalidateInstantiationPlans(UA_Server *server);
+
+void
+deleteInstantiationPlans(UA_Server *server);
+
+void
+clearDiscoveryCache(UA_Server *server);
+
 const UA_Node *
 getNodeType(UA_Server *server, const UA_Node *node);
 
@@ -4331,6 +4828,12 @@ UA_StatusCode
 writeValueAttribute(UA_Server *server, UA_VariableNode *node,
                     const UA_DataValue *value, const UA_String *indexRange);
 
+/* Moves the value into a node that is not yet in the nodestore. value is empty
+ * afterwards. Values that need to be converted to the DataType of the node are
+ * not moved and UA_STATUSCODE_BADTYPEMISMATCH is returned. */
+UA_StatusCode
+moveValueAttribute(UA_Server *server, UA_VariableNode *node, UA_Variant *value);
+
 /*******************/
 /* Single-Services */
 /*******************/
@@ -4344,7 +4847,7 @@ void Service_Browse_single(UA_Server *server, UA_Session *session,
                            UA_UInt32 maxrefs, UA_BrowseResult *result);
 
 void Service_Read_single(UA_Server *server, UA_Session *session,
-                         UA_TimestampsToReturn timestamps,
+                         UA_TimestampsToReturn timestamps, UA_Double maxAge,
                          const UA_ReadValueId *id, UA_DataValue *v);
 
 void Service_Call_single(UA_Server *server, UA_Session *session,
@@ -4403,6 +4906,13 @@ void Service_GetEndpoints(UA_Server *server, UA_Session *session,
                           const UA_GetEndpointsRequest *request,
                           UA_GetEndpointsResponse *response);
 
+/* Sends the GetEndpoints or FindServers response from the cache of encoded
+ * responses. Calls the service and caches the encoded response if there is no
+ * entry for the parameters of the request. */
+void sendDiscoveryResponse(UA_Server *server, UA_Session *session,
+                           UA_SecureChannel *channel, UA_UInt32 requestId,
+                           const UA_DataType *requestType, const void *request);
+
 /* Not Implemented: Service_RegisterServer */
 
 /**
@@ -4492,6 +5002,13 @@ void Service_Browse(UA_Server *server, UA_Session *session,
                     const UA_BrowseRequest *request,
                     UA_BrowseResponse *response);
 
+/* Sends the response to a large Browse request. The BrowseResults are encoded
+ * one node at a time. Returns false if the Browse service is to be called as
+ * usual. */
+UA_Boolean sendBrowseResponse(UA_Server *server, UA_Session *session,
+                              UA_SecureChannel *channel, UA_UInt32 requestId,
+                              const UA_BrowseRequest *request);
+
 /* Used to request the next set of Browse or BrowseNext response information
  * that is too large to be sent in a single response. "Too large" in this
  * context means that the Server is not able to return a larger response or that
@@ -4545,6 +5062,15 @@ void Service_Read(UA_Server *server, UA_Session *session,
                   const UA_ReadRequest *request,
                   UA_ReadResponse *response);
 
+/* Calls the Read service and sends the response. Large responses are encoded
+ * while the nodes are read. With UA_ENABLE_ATTRIBUTE_CACHE, the attributes of
+ * the nodes besides the Value are cached in binary encoding and copied into the
+ * response. Returns false if the response was not sent. Then the Read service
+ * is called as usual. */
+UA_Boolean sendReadResponse(UA_Server *server, UA_Session *session,
+                            UA_SecureChannel *channel, UA_UInt32 requestId,
+                            const UA_ReadRequest *request);
+
 /* Used to write one or more Attributes of one or more Nodes. For constructed
  * Attribute values whose elements are indexed, such as an array, this Service
  * allows Clients to write the entire set of indexed values as a composite, to
@@ -5196,7 +5722,10 @@ UA_Variant_setArrayCopy(UA_Variant *v, const void *array,
  * - total: how many elements are in the range
  * - block: how big is each contiguous block of elements in the variant that
  *   maps into the range
- * - stride: how many elements are between the blocks (beginning to beginning)
+ * - stride: how many elements are between the blocks (beginning to beginning).
+ *   Zero if the blocks are not evenly spaced. This happens when a dimension
+ *   between the first dimension and the block is not entirely in the range.
+ *   Then the position of every block is given by blockPosition.
  * - first: where does the first block begin */
 static UA_StatusCode
 computeStrides(const UA_Variant *v, const UA_NumericRange range,
@@ -5249,6 +5778,9 @@ computeStrides(const UA_Variant *v, const UA_NumericRange range,
             found_contiguous = true;
             *block = running_dimssize * dimrange;
             *stride = running_dimssize * dims[k];
+        } else if(found_contiguous && k > 0 && dimrange != dims[k]) {
+            /* The blocks are not evenly spaced */
+            *stride = 0;
         }
         *first += running_dimssize * range.dimensions[k].min;
         running_dimssize *= dims[k];
@@ -5256,6 +5788,71 @@ computeStrides(const UA_Variant *v, const UA_NumericRange range,
     return UA_STATUSCODE_GOOD;
 }
 
+/* Position of the i-th block relative to the first block. If the blocks are
+ * not evenly spaced, the index counts through the range of the dimensions in
+ * front of the block. */
+static size_t
+blockPosition(const UA_Variant *v, const UA_NumericRange range,
+              size_t stride, size_t i) {
+    if(stride > 0)
+        return i * stride;
+    const UA_UInt32 *dims = v->arrayDimensions;
+    size_t k = v->arrayDimensionsSize;
+    size_t running_dimssize = 1;
+    /* Skip the dimensions of the block. The block ends with the first
+     * dimension that is not entirely in the range. */
+    while(k > 0) {
+        --k;
+        running_dimssize *= dims[k];
+        if(1 + range.dimensions[k].max - range.dimensions[k].min != dims[k])
+            break;
+    }
+    size_t pos = 0;
+    while(k > 0) {
+        --k;
+        size_t dimrange = 1 + range.dimensions[k].max - range.dimensions[k].min;
+        pos += (i % dimrange) * running_dimssize;
+        i /= dimrange;
+        running_dimssize *= dims[k];
+    }
+    return pos;
+}
+
+/* Copies block_count blocks of block elements of a fixed-size type. The
+ * strides are the distances between the beginnings of the blocks (in
+ * elements). Contiguous blocks are copied with a single memcpy. Small blocks
+ * (e.g. a column of a matrix) are copied with a constant size that the
+ * compiler turns into a single move. */
+#define COPY_BLOCKS(BYTES) do {                                         \
+        for(size_t i = 0; i < block_count; ++i) {                       \
+            memcpy((void*)dst, (const void*)src, BYTES);                \
+            dst += dst_step;                                            \
+            src += src_step;                                            \
+        }                                                               \
+    } while(0)
+
+static void
+copyFixedBlocks(uintptr_t dst, size_t dst_stride, uintptr_t src, size_t src_stride,
+                size_t block_count, size_t block, size_t elem_size) {
+    if(block_count == 1 || (dst_stride == block && src_stride == block)) {
+        memcpy((void*)dst, (const void*)src, block_count * block * elem_size);
+        return;
+    }
+    size_t bytes = block * elem_size;
+    size_t dst_step = dst_stride * elem_size;
+    size_t src_step = src_stride * elem_size;
+    switch(bytes) {
+    case 1: COPY_BLOCKS(1); break;
+    case 2: COPY_BLOCKS(2); break;
+    case 4: COPY_BLOCKS(4); break;
+    case 8: COPY_BLOCKS(8); break;
+    case 16: COPY_BLOCKS(16); break;
+    default: COPY_BLOCKS(bytes); break;
+    }
+}
+
+#undef COPY_BLOCKS
+
 /* Is the type string-like? */
 static UA_Boolean
 isStringLike(const UA_DataType *type) {
@@ -5337,21 +5934,26 @@ UA_Variant_copyRange(const UA_Variant *src, UA_Variant *dst,
     uintptr_t nextsrc = (uintptr_t)src->data + (elem_size * first);
     if(nextrange.dimensionsSize == 0) {
         /* no nextrange */
-        if(src->type->fixedSize) {
+        if(src->type->fixedSize && stride > 0) {
+            copyFixedBlocks(nextdst, block, nextsrc, stride,
+                            block_count, block, elem_size);
+        } else if(src->type->fixedSize) {
             for(size_t i = 0; i < block_count; ++i) {
-                memcpy((void*)nextdst, (void*)nextsrc, elem_size * block);
+                uintptr_t blocksrc = nextsrc +
+                    blockPosition(src, thisrange, 0, i) * elem_size;
+                memcpy((void*)nextdst, (const void*)blocksrc, block * elem_size);
                 nextdst += block * elem_size;
-                nextsrc += stride * elem_size;
             }
         } else {
             for(size_t i = 0; i < block_count; ++i) {
+                uintptr_t blocksrc = nextsrc +
+                    blockPosition(src, thisrange, stride, i) * elem_size;
                 for(size_t j = 0; j < block; ++j) {
-                    retval = UA_copy((const void*)nextsrc,
-                                     (void*)nextdst, src->type);
+                    retval |= UA_copy((const void*)blocksrc,
+                                      (void*)nextdst, src->type);
                     nextdst += elem_size;
-                    nextsrc += elem_size;
+                    blocksrc += elem_size;
                 }
-                nextsrc += (stride - block) * elem_size;
             }
         }
     } else {
@@ -5366,19 +5968,20 @@ UA_Variant_copyRange(const UA_Variant *src, UA_Variant *dst,
 
         /* Copy the content */
         for(size_t i = 0; i < block_count; ++i) {
+            uintptr_t blocksrc = nextsrc +
+                blockPosition(src, thisrange, stride, i) * elem_size;
             for(size_t j = 0; j < block && retval == UA_STATUSCODE_GOOD; ++j) {
                 if(stringLike)
-                    retval = copySubString((const UA_String*)nextsrc,
+                    retval = copySubString((const UA_String*)blocksrc,
                                            (UA_String*)nextdst,
                                            nextrange.dimensions);
                 else
-                    retval = UA_Variant_copyRange((const UA_Variant*)nextsrc,
+                    retval = UA_Variant_copyRange((const UA_Variant*)blocksrc,
                                                   (UA_Variant*)nextdst,
                                                   nextrange);
                 nextdst += elem_size;
-                nextsrc += elem_size;
+                blocksrc += elem_size;
             }
-            nextsrc += (stride - block) * elem_size;
         }
     }
 
@@ -5431,26 +6034,42 @@ Variant_setRange(UA_Variant *v, void *array, size_t arraySize,
     uintptr_t nextdst = (uintptr_t)v->data + (first * elem_size);
     uintptr_t nextsrc = (uintptr_t)array;
     if(v->type->fixedSize || !copy) {
-        for(size_t i = 0; i < block_count; ++i) {
-            memcpy((void*)nextdst, (void*)nextsrc, elem_size * block);
-            nextsrc += block * elem_size;
-            nextdst += stride * elem_size;
+        /* The moved members replace the members in the range */
+        if(!v->type->fixedSize) {
+            for(size_t i = 0; i < block_count; ++i) {
+                uintptr_t olddst = nextdst +
+                    blockPosition(v, range, stride, i) * elem_size;
+                for(size_t j = 0; j < block; ++j)
+                    deleteMembers_noInit((void*)(olddst + j * elem_size), v->type);
+            }
+        }
+        if(stride > 0) {
+            copyFixedBlocks(nextdst, stride, nextsrc, block,
+                            block_count, block, elem_size);
+        } else {
+            for(size_t i = 0; i < block_count; ++i) {
+                uintptr_t blockdst = nextdst +
+                    blockPosition(v, range, 0, i) * elem_size;
+                memcpy((void*)blockdst, (const void*)nextsrc, block * elem_size);
+                nextsrc += block * elem_size;
+            }
         }
     } else {
         for(size_t i = 0; i < block_count; ++i) {
+            uintptr_t blockdst = nextdst +
+                blockPosition(v, range, stride, i) * elem_size;
             for(size_t j = 0; j < block; ++j) {
-                deleteMembers_noInit((void*)nextdst, v->type);
-                retval |= UA_copy((void*)nextsrc, (void*)nextdst, v->type);
-                nextdst += elem_size;
+                deleteMembers_noInit((void*)blockdst, v->type);
+                retval |= UA_copy((void*)nextsrc, (void*)blockdst, v->type);
+                blockdst += elem_size;
                 nextsrc += elem_size;
             }
-            nextdst += (stride - block) * elem_size;
         }
     }
 
     /* If members were moved, initialize original array to prevent reuse */
     if(!copy && !v->type->fixedSize)
-        memset(array, 0, sizeof(elem_size)*arraySize);
+        memset(array, 0, elem_size * arraySize);
 
     return retval;
 }
@@ -7130,6 +7749,40 @@ UA_encodeBinary(const void *src, const UA_DataType *type,
     return retval;
 }
 
+UA_StatusCode
+UA_encodeBinaryRaw(const UA_ByteString *src,
+                   UA_exchangeEncodeBuffer exchangeCallback, void *exchangeHandle,
+                   UA_ByteString *dst, size_t *offset) {
+    pos = &dst->data[*offset];
+    end = &dst->data[dst->length];
+    encodeBuf = dst;
+    exchangeBufferCallback = exchangeCallback;
+    exchangeBufferCallbackHandle = exchangeHandle;
+
+    /* Fill the buffer and exchange it until all bytes are written */
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    const UA_Byte *data = src->data;
+    size_t remaining = src->length;
+    while(remaining > 0) {
+        if(pos == end) {
+            retval = exchangeBuffer();
+            if(retval == UA_STATUSCODE_GOOD && pos == end)
+                retval = UA_STATUSCODE_BADENCODINGERROR;
+            if(retval != UA_STATUSCODE_GOOD)
+                break;
+        }
+        size_t length = (size_t)(end - pos);
+        if(length > remaining)
+            length = remaining;
+        memcpy(pos, data, length);
+        pos += length;
+        data += length;
+        remaining -= length;
+    }
+    *offset = (size_t)(pos - dst->data) / sizeof(UA_Byte);
+    return retval;
+}
+
 const UA_decodeBinarySignature decodeBinaryJumpTable[UA_BUILTIN_TYPES_COUNT + 1] = {
     (UA_decodeBinarySignature)Boolean_decodeBinary,
     (UA_decodeBinarySignature)Byte_decodeBinary, // SByte
@@ -15210,9 +15863,14 @@ UA_SecureChannel_sendChunk(UA_ChunkInfo *ci, UA_ByteString *dst, size_t offset)
     return ci->errorCode;
 }
 
-UA_StatusCode
-UA_SecureChannel_sendBinaryMessage(UA_SecureChannel *channel, UA_UInt32 requestId,
-                                   const void *content, const UA_DataType *contentType) {
+/* Encodes the content as the encodeType and appends the body with the
+ * encodeBody callback (if not NULL). The type of the message is that of
+ * contentType. */
+static UA_StatusCode
+sendChunkedMessage(UA_SecureChannel *channel, UA_UInt32 requestId,
+                   const void *content, const UA_DataType *contentType,
+                   const UA_DataType *encodeType, UA_SecureChannel_encodeBody encodeBody,
+                   const void *body) {
     UA_Connection *connection = channel->connection;
     if(!connection)
         return UA_STATUSCODE_BADINTERNALERROR;
@@ -15247,9 +15905,12 @@ UA_SecureChannel_sendBinaryMessage(UA_SecureChannel *channel, UA_UInt32 requestI
         ci.messageType = UA_MESSAGETYPE_OPN;
     else if(typeId.identifier.numeric == 452 || typeId.identifier.numeric == 455)
         ci.messageType = UA_MESSAGETYPE_CLO;
-    retval = UA_encodeBinary(content, contentType,
+    retval = UA_encodeBinary(content, encodeType,
                              (UA_exchangeEncodeBuffer)UA_SecureChannel_sendChunk,
                              &ci, &message, &messagePos);
+    if(retval == UA_STATUSCODE_GOOD && encodeBody)
+        retval = encodeBody(body, (UA_exchangeEncodeBuffer)UA_SecureChannel_sendChunk,
+                            &ci, &message, &messagePos);
 
     /* Encoding failed, release the message */
     if(retval != UA_STATUSCODE_GOOD) {
@@ -15266,6 +15927,33 @@ UA_SecureChannel_sendBinaryMessage(UA_SecureChannel *channel, UA_UInt32 requestI
     return UA_SecureChannel_sendChunk(&ci, &message, messagePos);
 }
 
+UA_StatusCode
+UA_SecureChannel_sendBinaryMessage(UA_SecureChannel *channel, UA_UInt32 requestId,
+                                   const void *content, const UA_DataType *contentType) {
+    return sendChunkedMessage(channel, requestId, content, contentType, contentType,
+                              NULL, NULL);
+}
+
+UA_StatusCode
+UA_SecureChannel_sendEncodedResponse(UA_SecureChannel *channel, UA_UInt32 requestId,
+                                     const UA_DataType *responseType,
+                                     const UA_ResponseHeader *responseHeader,
+                                     const UA_ByteString *body) {
+    return sendChunkedMessage(channel, requestId, responseHeader, responseType,
+                              &UA_TYPES[UA_TYPES_RESPONSEHEADER],
+                              (UA_SecureChannel_encodeBody)UA_encodeBinaryRaw, body);
+}
+
+UA_StatusCode
+UA_SecureChannel_sendCustomResponse(UA_SecureChannel *channel, UA_UInt32 requestId,
+                                    const UA_DataType *responseType,
+                                    const UA_ResponseHeader *responseHeader,
+                                    UA_SecureChannel_encodeBody encodeBody,
+                                    const void *body) {
+    return sendChunkedMessage(channel, requestId, responseHeader, responseType,
+                              &UA_TYPES[UA_TYPES_RESPONSEHEADER], encodeBody, body);
+}
+
 /***************************/
 /* Process Received Chunks */
 /***************************/
@@ -15506,6 +16194,10 @@ void UA_Session_init(UA_Session *session) {
     session->channel = NULL;
     session->availableContinuationPoints = UA_MAXCONTINUATIONPOINTS;
     LIST_INIT(&session->continuationPoints);
+    session->registeredNodesSize = 0;
+    session->registeredNodesCount = 0;
+    session->registeredNodesFree = 0;
+    session->registeredNodes = NULL;
 #ifdef UA_ENABLE_SUBSCRIPTIONS
     LIST_INIT(&session->serverSubscriptions);
     session->lastSubscriptionID = 0;
@@ -15525,6 +16217,13 @@ void UA_Session_deleteMembersCleanup(UA_Session *session, UA_Server* server) {
         UA_BrowseDescription_deleteMembers(&cp->browseDescription);
         UA_free(cp);
     }
+    for(size_t i = 0; i < session->registeredNodesSize; ++i)
+        UA_NodeId_deleteMembers(&session->registeredNodes[i].nodeId);
+    UA_free(session->registeredNodes);
+    session->registeredNodes = NULL;
+    session->registeredNodesSize = 0;
+    session->registeredNodesCount = 0;
+    session->registeredNodesFree = 0;
     if(session->channel)
         UA_SecureChannel_detachSession(session->channel, session);
 #ifdef UA_ENABLE_SUBSCRIPTIONS
@@ -15548,6 +16247,74 @@ void UA_Session_updateLifetime(UA_Session *session) {
         (UA_DateTime)(session->timeout * UA_MSEC_TO_DATETIME);
 }
 
+UA_StatusCode
+UA_Session_registerNode(UA_Session *session, const UA_NodeId *nodeId, UA_NodeId *alias) {
+    if(nodeId->identifierType == UA_NODEIDTYPE_NUMERIC || UA_NodeId_isNull(nodeId) ||
+       session->registeredNodesCount >= UA_MAXREGISTEREDNODES)
+        return UA_NodeId_copy(nodeId, alias);
+
+    /* Find a free position */
+    size_t pos = session->registeredNodesFree;
+    while(pos < session->registeredNodesSize &&
+          !UA_NodeId_isNull(&session->registeredNodes[pos].nodeId))
+        ++pos;
+    if(pos == session->registeredNodesSize) {
+        size_t size = session->registeredNodesSize * 2;
+        if(size < 16)
+            size = 16;
+        UA_RegisteredNode *nodes = (UA_RegisteredNode*)
+            UA_realloc(session->registeredNodes, size * sizeof(UA_RegisteredNode));
+        if(!nodes)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        for(size_t i = session->registeredNodesSize; i < size; ++i)
+            UA_NodeId_init(&nodes[i].nodeId);
+        session->registeredNodes = nodes;
+        session->registeredNodesSize = size;
+    }
+
+    UA_RegisteredNode *reg = &session->registeredNodes[pos];
+    UA_StatusCode retval = UA_NodeId_copy(nodeId, &reg->nodeId);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    reg->hash = UA_NodeStore_hash(nodeId);
+    ++session->registeredNodesCount;
+    session->registeredNodesFree = pos + 1;
+    *alias = UA_NODEID_NUMERIC(UA_REGISTEREDNODES_NAMESPACE, (UA_UInt32)pos + 1);
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+UA_Session_unregisterNode(UA_Session *session, const UA_NodeId *alias) {
+    UA_RegisteredNode *reg =
+        (UA_RegisteredNode*)(uintptr_t)UA_Session_getRegisteredNode(session, alias);
+    if(!reg)
+        return;
+    UA_NodeId_deleteMembers(&reg->nodeId);
+    --session->registeredNodesCount;
+    size_t pos = (size_t)(reg - session->registeredNodes);
+    if(pos < session->registeredNodesFree)
+        session->registeredNodesFree = pos;
+}
+
+const UA_RegisteredNode *
+UA_Session_getRegisteredNode(const UA_Session *session, const UA_NodeId *alias) {
+    if(alias->namespaceIndex != UA_REGISTEREDNODES_NAMESPACE ||
+       alias->identifierType != UA_NODEIDTYPE_NUMERIC ||
+       alias->identifier.numeric == 0 ||
+       alias->identifier.numeric > session->registeredNodesSize)
+        return NULL;
+    const UA_RegisteredNode *reg = &session->registeredNodes[alias->identifier.numeric - 1];
+    if(UA_NodeId_isNull(&reg->nodeId))
+        return NULL;
+    return reg;
+}
+
+const UA_NodeId *
+UA_Session_resolveNodeId(const UA_Session *session, const UA_NodeId *nodeId) {
+    const UA_RegisteredNode *reg = UA_Session_getRegisteredNode(session, nodeId);
+    return reg ? &reg->nodeId : nodeId;
+}
+
 #ifdef UA_ENABLE_SUBSCRIPTIONS
 
 void UA_Session_addSubscription(UA_Session *session, UA_Subscription *newSubscription) {
@@ -15595,6 +16362,16 @@ UA_UInt32 UA_Session_getUniqueSubscriptionID(UA_Session *session) {
 #ifdef UA_ENABLE_SUBSCRIPTIONS
 #endif
 
+#ifndef UA_ENABLE_MULTITHREADING
+# include <stdio.h>
+# ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+# endif
+#endif
+
 #if defined(UA_ENABLE_MULTITHREADING) && !defined(NDEBUG)
 UA_THREAD_LOCAL bool rcu_locked = false;
 #endif
@@ -15603,9 +16380,11 @@ UA_THREAD_LOCAL bool rcu_locked = false;
 UA_THREAD_LOCAL UA_Session* methodCallSession = NULL;
 #endif
 
+#if !defined(UA_ENABLE_STATIC_NAMESPACE0) && !defined(UA_ENABLE_LAZY_NAMESPACE0)
 static const UA_NodeId nodeIdHasSubType = {
     .namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC,
     .identifier.numeric = UA_NS0ID_HASSUBTYPE};
+#endif
 static const UA_NodeId nodeIdHasComponent = {
     .namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC,
     .identifier.numeric = UA_NS0ID_HASCOMPONENT};
@@ -15616,7 +16395,8 @@ static const UA_NodeId nodeIdOrganizes = {
     .namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC,
     .identifier.numeric = UA_NS0ID_ORGANIZES};
 
-#ifndef UA_ENABLE_GENERATE_NAMESPACE0
+#if !defined(UA_ENABLE_GENERATE_NAMESPACE0) && !defined(UA_ENABLE_STATIC_NAMESPACE0) && \
+    !defined(UA_ENABLE_LAZY_NAMESPACE0)
 static const UA_NodeId nodeIdNonHierarchicalReferences = {
         .namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC,
         .identifier.numeric = UA_NS0ID_NONHIERARCHICALREFERENCES};
@@ -15728,6 +16508,7 @@ UA_Server_forEachChildNodeCall(UA_Server *server, UA_NodeId parentNodeId,
     return retval;
 }
 
+#if !defined(UA_ENABLE_STATIC_NAMESPACE0) && !defined(UA_ENABLE_LAZY_NAMESPACE0)
 static UA_AddNodesResult
 addNodeInternal(UA_Server *server, UA_Node *node, const UA_NodeId parentNodeId,
                 const UA_NodeId referenceTypeId) {
@@ -15740,6 +16521,7 @@ addNodeInternal(UA_Server *server, UA_Node *node, const UA_NodeId parentNodeId,
     UA_RCU_UNLOCK();
     return res;
 }
+#endif
 
 static UA_AddNodesResult
 addNodeInternalWithType(UA_Server *server, UA_Node *node, const UA_NodeId parentNodeId,
@@ -15795,6 +16577,9 @@ void UA_Server_delete(UA_Server *server) {
     UA_RCU_LOCK();
     UA_NodeStore_delete(server->nodestore);
     UA_RCU_UNLOCK();
+    deleteTypeClosures(server);
+    deleteInstantiationPlans(server);
+    clearDiscoveryCache(server);
 #ifdef UA_ENABLE_EXTERNAL_NAMESPACES
     UA_Server_deleteExternalNamespaces(server);
 #endif
@@ -15805,10 +16590,32 @@ void UA_Server_delete(UA_Server *server) {
 #ifdef UA_ENABLE_MULTITHREADING
     pthread_cond_destroy(&server->dispatchQueue_condition);
     pthread_mutex_destroy(&server->dispatchQueue_mutex);
+    pthread_mutex_destroy(&server->typeClosures.mutex);
+    pthread_mutex_destroy(&server->instantiationPlans.mutex);
+    pthread_mutex_destroy(&server->discoveryCache.mutex);
+#else
+    /* The nodestore is deleted, so the image is no longer used */
+    if(server->image) {
+# ifndef _WIN32
+        munmap(server->image, server->imageSize);
+# else
+        UA_free(server->image);
+# endif
+    }
 #endif
     UA_free(server);
 }
 
+UA_StatusCode
+UA_Server_getNodeMemoryReport(UA_Server *server,
+                              UA_NodeMemoryReport report[UA_NODEMEMORYREPORT_SIZE]) {
+    memset(report, 0, sizeof(UA_NodeMemoryReport) * UA_NODEMEMORYREPORT_SIZE);
+    UA_RCU_LOCK();
+    UA_NodeStore_memoryReport(server->nodestore, report);
+    UA_RCU_UNLOCK();
+    return UA_STATUSCODE_GOOD;
+}
+
 /* Recurring cleanup. Removing unused and timed-out channels and sessions */
 static void UA_Server_cleanup(UA_Server *server, void *_) {
     UA_DateTime nowMonotonic = UA_DateTime_nowMonotonic();
@@ -15981,6 +16788,7 @@ static void copyNames(UA_Node *node, char *name) {
     node->description = UA_LOCALIZEDTEXT_ALLOC("en_US", name);
 }
 
+#if !defined(UA_ENABLE_STATIC_NAMESPACE0) && !defined(UA_ENABLE_LAZY_NAMESPACE0)
 static void
 addDataTypeNode(UA_Server *server, char* name, UA_UInt32 datatypeid,
                 UA_Boolean isAbstract, UA_UInt32 parent) {
@@ -16011,6 +16819,7 @@ createVariableTypeNode(UA_Server *server, char* name, UA_UInt32 variabletypeid,
     variabletype->isAbstract = abstract;
     return variabletype;
 }
+#endif
 
 #if defined(UA_ENABLE_METHODCALLS) && defined(UA_ENABLE_SUBSCRIPTIONS)
 static UA_StatusCode
@@ -16044,7 +16853,8 @@ GetMonitoredItems(void *handle, const UA_NodeId objectId, size_t inputSize,
 }
 #endif
 
-UA_Server * UA_Server_new(const UA_ServerConfig config) {
+/* Creates the server without the nodes */
+static UA_Server * createServer(const UA_ServerConfig config) {
     UA_Server *server = UA_calloc(1, sizeof(UA_Server));
     if(!server)
         return NULL;
@@ -16054,6 +16864,9 @@ UA_Server * UA_Server_new(const UA_ServerConfig config) {
     LIST_INIT(&server->repeatedJobs);
 
 #ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_init(&server->typeClosures.mutex, NULL);
+    pthread_mutex_init(&server->instantiationPlans.mutex, NULL);
+    pthread_mutex_init(&server->discoveryCache.mutex, NULL);
     rcu_init();
     cds_wfcq_init(&server->dispatchQueue_head, &server->dispatchQueue_tail);
     cds_lfs_init(&server->mainLoopJobs);
@@ -16122,9 +16935,31 @@ UA_Server * UA_Server_new(const UA_ServerConfig config) {
     UA_Server_addRepeatedJob(server, cleanup, 10000, NULL);
 
     server->startTime = UA_DateTime_now();
+    return server;
+}
+
+#ifdef UA_ENABLE_STATIC_NAMESPACE0
+/* Defined in the generated ua_namespace0_static.c that is included with the
+ * nodestore */
+static UA_StatusCode addStaticNamespace0(UA_NodeStore *ns);
+#endif
 
-#ifndef UA_ENABLE_GENERATE_NAMESPACE0
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+# if defined(UA_ENABLE_STATIC_NAMESPACE0) || defined(UA_ENABLE_GENERATE_NAMESPACE0)
+#  error UA_ENABLE_LAZY_NAMESPACE0 replaces the other sources of namespace 0
+# endif
+# ifdef UA_ENABLE_MULTITHREADING
+#  error The lazy namespace 0 requires the single-threaded nodestore
+# endif
+/* Defined in the generated ua_namespace0_lazy.c that is included with the
+ * nodestore */
+static UA_StatusCode addLazyNamespace0(UA_NodeStore *ns);
+#endif
 
+#if !defined(UA_ENABLE_GENERATE_NAMESPACE0) && !defined(UA_ENABLE_STATIC_NAMESPACE0) && \
+    !defined(UA_ENABLE_LAZY_NAMESPACE0)
+/* Namespace 0 without the server object */
+static void createNamespace0(UA_Server *server) {
     /*********************************/
     /* Bootstrap reference hierarchy */
     /*********************************/
@@ -16524,7 +17359,24 @@ UA_Server * UA_Server_new(const UA_ServerConfig config) {
     optional->nodeId.identifier.numeric = UA_NS0ID_MODELLINGRULE_OPTIONAL;
     addNodeInternalWithType(server, (UA_Node*)optional, UA_NODEID_NULL,
                             UA_NODEID_NULL, UA_NODEID_NUMERIC(0, UA_NS0ID_MODELLINGRULETYPE));
+}
+#endif
+
+UA_Server * UA_Server_new(const UA_ServerConfig config) {
+    UA_Server *server = createServer(config);
+    if(!server)
+        return NULL;
 
+#if defined(UA_ENABLE_STATIC_NAMESPACE0)
+    /* use the constant nodes in place */
+    UA_RCU_LOCK();
+    addStaticNamespace0(server->nodestore);
+    UA_RCU_UNLOCK();
+#elif defined(UA_ENABLE_LAZY_NAMESPACE0)
+    /* the nodes are created when they are first used */
+    addLazyNamespace0(server->nodestore);
+#elif !defined(UA_ENABLE_GENERATE_NAMESPACE0)
+    createNamespace0(server);
 #else
     /* load the generated namespace externally */
     ua_namespaceinit_generated(server);
@@ -16930,38 +17782,178 @@ UA_Server * UA_Server_new(const UA_ServerConfig config) {
     return server;
 }
 
-/*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_server_binary.c" ***********************************/
-
-/* This Source Code Form is subject to the terms of the Mozilla Public
-*  License, v. 2.0. If a copy of the MPL was not distributed with this 
-*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
-
+#ifndef UA_ENABLE_MULTITHREADING
 
-/********************/
-/* Helper Functions */
-/********************/
+/***********************/
+/* Address-Space Image */
+/***********************/
 
-static void
-sendError(UA_SecureChannel *channel, const UA_ByteString *msg,
-          size_t offset, const UA_DataType *responseType,
-          UA_UInt32 requestId, UA_StatusCode error) {
-    UA_RequestHeader requestHeader;
-    UA_StatusCode retval = UA_RequestHeader_decodeBinary(msg, &offset, &requestHeader);
+UA_StatusCode
+UA_Server_saveImage(UA_Server *server, const char *path) {
+    UA_ByteString image;
+    UA_StatusCode retval = UA_NodeStore_saveImage(server->nodestore, server->namespaces,
+                                                  server->namespacesSize, &image);
     if(retval != UA_STATUSCODE_GOOD)
-        return;
-    void *response = UA_alloca(responseType->memSize);
-    UA_init(response, responseType);
-    UA_ResponseHeader *responseHeader = (UA_ResponseHeader*)response;
-    responseHeader->requestHandle = requestHeader.requestHandle;
-    responseHeader->timestamp = UA_DateTime_now();
-    responseHeader->serviceResult = error;
-    UA_SecureChannel_sendBinaryMessage(channel, requestId, response, responseType);
-    UA_RequestHeader_deleteMembers(&requestHeader);
-    UA_ResponseHeader_deleteMembers(responseHeader);
+        return retval;
+    FILE *f = fopen(path, "wb");
+    if(!f) {
+        UA_ByteString_deleteMembers(&image);
+        return UA_STATUSCODE_BADINTERNALERROR;
+    }
+    if(fwrite(image.data, 1, image.length, f) != image.length)
+        retval = UA_STATUSCODE_BADINTERNALERROR;
+    if(fclose(f) != 0)
+        retval = UA_STATUSCODE_BADINTERNALERROR;
+    UA_ByteString_deleteMembers(&image);
+    return retval;
 }
 
-static void
-getServicePointers(UA_UInt32 requestTypeId, const UA_DataType **requestType,
+/* Maps the image with copy-on-write. Only the pages with pointers are written
+ * to during loading. */
+static UA_StatusCode
+mapImage(UA_Server *server, const char *path) {
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if(fd < 0)
+        return UA_STATUSCODE_BADNOTFOUND;
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return UA_STATUSCODE_BADDECODINGERROR;
+    }
+    void *image = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(image == MAP_FAILED)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    server->image = image;
+    server->imageSize = (size_t)st.st_size;
+#else
+    FILE *f = fopen(path, "rb");
+    if(!f)
+        return UA_STATUSCODE_BADNOTFOUND;
+    long size = -1;
+    if(fseek(f, 0, SEEK_END) == 0)
+        size = ftell(f);
+    if(size <= 0 || fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return UA_STATUSCODE_BADDECODINGERROR;
+    }
+    void *image = UA_malloc((size_t)size);
+    if(!image) {
+        fclose(f);
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    }
+    if(fread(image, 1, (size_t)size, f) != (size_t)size) {
+        fclose(f);
+        UA_free(image);
+        return UA_STATUSCODE_BADDECODINGERROR;
+    }
+    fclose(f);
+    server->image = image;
+    server->imageSize = (size_t)size;
+#endif
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+setStartTime(UA_Server *server, UA_Session *session, UA_VariableNode *node,
+             const void *_) {
+    UA_Variant_deleteMembers(&node->value.data.value.value);
+    return UA_Variant_setScalarCopy(&node->value.data.value.value, &server->startTime,
+                                    &UA_TYPES[UA_TYPES_DATETIME]);
+}
+
+/* Function pointers are not part of the image */
+static void
+attachNs0Callbacks(UA_Server *server) {
+    UA_DataSource ds = {.handle = server, .read = readNamespaces, .write = writeNamespaces};
+    UA_Server_setVariableNode_dataSource(server, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY), ds);
+    ds = (UA_DataSource) {.handle = server, .read = readStatus, .write = NULL};
+    UA_Server_setVariableNode_dataSource(server, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS), ds);
+    ds = (UA_DataSource) {.handle = NULL, .read = readCurrentTime, .write = NULL};
+    UA_Server_setVariableNode_dataSource(server, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS_CURRENTTIME), ds);
+    ds = (UA_DataSource) {.handle = server, .read = readServiceLevel, .write = NULL};
+    UA_Server_setVariableNode_dataSource(server, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVICELEVEL), ds);
+    ds = (UA_DataSource) {.handle = server, .read = readAuditing, .write = NULL};
+    UA_Server_setVariableNode_dataSource(server, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_AUDITING), ds);
+
+    UA_NodeId startTime = UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_SERVERSTATUS_STARTTIME);
+    UA_RCU_LOCK();
+    UA_Server_editNode(server, &adminSession, &startTime,
+                       (UA_EditNodeCallback)setStartTime, NULL);
+    UA_RCU_UNLOCK();
+
+#if defined(UA_ENABLE_METHODCALLS) && defined(UA_ENABLE_SUBSCRIPTIONS)
+    UA_Server_setMethodNode_callback(server, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_GETMONITOREDITEMS),
+                                     GetMonitoredItems, NULL);
+#endif
+}
+
+UA_Server *
+UA_Server_newFromImage(const UA_ServerConfig config, const char *path) {
+    UA_Server *server = createServer(config);
+    if(!server)
+        return NULL;
+    if(mapImage(server, path) != UA_STATUSCODE_GOOD) {
+        UA_Server_delete(server);
+        return NULL;
+    }
+
+    const UA_String *namespaces;
+    size_t namespacesSize;
+    UA_StatusCode retval = UA_NodeStore_loadImage(server->nodestore, server->image,
+                                                  server->imageSize, &namespaces,
+                                                  &namespacesSize);
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_LOG_ERROR(config.logger, UA_LOGCATEGORY_SERVER,
+                     "Could not load the image %s", path);
+        UA_Server_delete(server);
+        return NULL;
+    }
+
+    /* Take the namespaces from the image. ns1 is the application uri of this
+     * server. */
+    for(size_t i = 2; i < namespacesSize; ++i)
+        addNamespace(server, namespaces[i]);
+
+    attachNs0Callbacks(server);
+    return server;
+}
+
+#endif /* UA_ENABLE_MULTITHREADING */
+
+/*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_server_binary.c" ***********************************/
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+*  License, v. 2.0. If a copy of the MPL was not distributed with this 
+*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
+
+
+/********************/
+/* Helper Functions */
+/********************/
+
+static void
+sendError(UA_SecureChannel *channel, const UA_ByteString *msg,
+          size_t offset, const UA_DataType *responseType,
+          UA_UInt32 requestId, UA_StatusCode error) {
+    UA_RequestHeader requestHeader;
+    UA_StatusCode retval = UA_RequestHeader_decodeBinary(msg, &offset, &requestHeader);
+    if(retval != UA_STATUSCODE_GOOD)
+        return;
+    void *response = UA_alloca(responseType->memSize);
+    UA_init(response, responseType);
+    UA_ResponseHeader *responseHeader = (UA_ResponseHeader*)response;
+    responseHeader->requestHandle = requestHeader.requestHandle;
+    responseHeader->timestamp = UA_DateTime_now();
+    responseHeader->serviceResult = error;
+    UA_SecureChannel_sendBinaryMessage(channel, requestId, response, responseType);
+    UA_RequestHeader_deleteMembers(&requestHeader);
+    UA_ResponseHeader_deleteMembers(responseHeader);
+}
+
+static void
+getServicePointers(UA_UInt32 requestTypeId, const UA_DataType **requestType,
                    const UA_DataType **responseType, UA_Service *service,
                    UA_Boolean *requiresSession) {
     switch(requestTypeId) {
@@ -17407,6 +18399,23 @@ processMSG(UA_Server *server, UA_SecureChannel *channel,
     }
 #endif
 
+    /* Discovery responses are sent from a cache of encoded responses */
+    if(requestType == &UA_TYPES[UA_TYPES_GETENDPOINTSREQUEST] ||
+       requestType == &UA_TYPES[UA_TYPES_FINDSERVERSREQUEST]) {
+        sendDiscoveryResponse(server, session, channel, requestId, requestType, request);
+        UA_deleteMembers(request, requestType);
+        return;
+    }
+
+    /* Large Read and Browse responses are encoded while the service runs */
+    if((requestType == &UA_TYPES[UA_TYPES_READREQUEST] &&
+        sendReadResponse(server, session, channel, requestId, request)) ||
+       (requestType == &UA_TYPES[UA_TYPES_BROWSEREQUEST] &&
+        sendBrowseResponse(server, session, channel, requestId, request))) {
+        UA_deleteMembers(request, requestType);
+        return;
+    }
+
     /* Call the service */
     UA_assert(service); /* For all services besides publish, the service pointer is non-NULL*/
     service(server, session, request, response);
@@ -17654,17 +18663,17 @@ getTypeHierarchy(UA_NodeStore *ns, const UA_Node *rootRef, UA_Boolean inverse,
     size_t idx = 0; /* Current index (contains NodeId of node) */
     size_t last = 0; /* Index of the last element in the array */
     const UA_NodeId hasSubtypeNodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE);
+    const UA_BrowseDirection direction =
+        inverse ? UA_BROWSEDIRECTION_INVERSE : UA_BROWSEDIRECTION_FORWARD;
     while(true) {
-        for(size_t i = 0; i < node->referencesSize; ++i) {
-            /* is the reference relevant? */
-            if(node->references[i].isInverse != inverse ||
-               !UA_NodeId_equal(&hasSubtypeNodeId, &node->references[i].referenceTypeId))
-                continue;
-
+        UA_ReferenceIterator it;
+        UA_ReferenceIterator_init(&it, node, direction, &hasSubtypeNodeId, 1);
+        const UA_ReferenceNode *ref;
+        while((ref = UA_ReferenceIterator_next(&it))) {
             /* is the target already considered? (multi-inheritance) */
             UA_Boolean duplicate = false;
             for(size_t j = 0; j <= last; ++j) {
-                if(UA_NodeId_equal(&node->references[i].targetId.nodeId, &results[j])) {
+                if(UA_NodeId_equal(&ref->targetId.nodeId, &results[j])) {
                     duplicate = true;
                     break;
                 }
@@ -17685,7 +18694,7 @@ getTypeHierarchy(UA_NodeStore *ns, const UA_Node *rootRef, UA_Boolean inverse,
             }
 
             /* copy new nodeid to the end of the list */
-            retval = UA_NodeId_copy(&node->references[i].targetId.nodeId, &results[++last]);
+            retval = UA_NodeId_copy(&ref->targetId.nodeId, &results[++last]);
             if(retval != UA_STATUSCODE_GOOD)
                 break;
         }
@@ -17720,54 +18729,226 @@ isNodeInTree(UA_NodeStore *ns, const UA_NodeId *leafNode, const UA_NodeId *nodeT
     if(!node)
         return false;
 
-    /* Search upwards in the tree */
-    for(size_t i = 0; i < node->referencesSize; ++i) {
-        if(!node->references[i].isInverse)
+    /* Search upwards in the tree. Recurse only for valid reference types. */
+    UA_ReferenceIterator it;
+    UA_ReferenceIterator_init(&it, node, UA_BROWSEDIRECTION_INVERSE,
+                              referenceTypeIds, referenceTypeIdsSize);
+    const UA_ReferenceNode *ref;
+    while((ref = UA_ReferenceIterator_next(&it))) {
+        if(isNodeInTree(ns, &ref->targetId.nodeId, nodeToFind,
+                        referenceTypeIds, referenceTypeIdsSize))
+            return true;
+    }
+    return false;
+}
+
+/* Subtype closures are cached in a hash table of the server. Entries are
+ * looked up and built under the mutex, so that a closure is never built from
+ * outdated references after it was invalidated. */
+
+UA_Boolean
+UA_TypeClosure_contains(const UA_TypeClosure *closure, const UA_NodeId *type) {
+    UA_UInt32 mask = closure->slotsSize - 1;
+    for(UA_UInt32 s = UA_NodeId_hash(type) & mask; closure->slots[s] != 0; s = (s + 1) & mask) {
+        if(UA_NodeId_equal(&closure->types[closure->slots[s] - 1], type))
+            return true;
+    }
+    return false;
+}
+
+static void
+deleteTypeClosure(UA_TypeClosure *closure) {
+    UA_Array_delete(closure->types, closure->typesSize, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_free(closure->slots);
+    UA_free(closure);
+}
+
+#ifdef UA_ENABLE_MULTITHREADING
+static void
+deleteTypeClosureRCU(struct rcu_head *head) {
+    deleteTypeClosure(container_of(head, UA_TypeClosure, rcu_head));
+}
+#endif
+
+static UA_TypeClosure *
+buildTypeClosure(UA_NodeStore *ns, const UA_Node *root) {
+    UA_TypeClosure *closure = UA_calloc(1, sizeof(UA_TypeClosure));
+    if(!closure)
+        return NULL;
+    if(getTypeHierarchy(ns, root, false, &closure->types,
+                        &closure->typesSize) != UA_STATUSCODE_GOOD) {
+        UA_free(closure);
+        return NULL;
+    }
+    closure->slotsSize = 4;
+    while(closure->slotsSize < closure->typesSize * 2)
+        closure->slotsSize *= 2;
+    closure->slots = UA_calloc(closure->slotsSize, sizeof(UA_UInt32));
+    if(!closure->slots) {
+        deleteTypeClosure(closure);
+        return NULL;
+    }
+    UA_UInt32 mask = closure->slotsSize - 1;
+    for(size_t i = 0; i < closure->typesSize; ++i) {
+        UA_UInt32 s = UA_NodeId_hash(&closure->types[i]) & mask;
+        while(closure->slots[s] != 0)
+            s = (s + 1) & mask;
+        closure->slots[s] = (UA_UInt32)i + 1;
+    }
+    return closure;
+}
+
+static UA_TypeClosure **
+findTypeClosure(UA_TypeClosureCache *cache, const UA_NodeId *root) {
+    size_t mask = cache->closuresSize - 1;
+    size_t s = UA_NodeId_hash(root) & mask;
+    while(cache->closures[s] && !UA_NodeId_equal(&cache->closures[s]->types[0], root))
+        s = (s + 1) & mask;
+    return &cache->closures[s];
+}
+
+/* Takes the closures out of the table and inserts those that are not dropped
+ * into a table of the given size */
+static UA_StatusCode
+rebuildTypeClosures(UA_TypeClosureCache *cache, size_t size, const UA_NodeId *drop) {
+    UA_TypeClosure **closures = UA_calloc(size, sizeof(UA_TypeClosure*));
+    if(!closures)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    UA_TypeClosure **old = cache->closures;
+    size_t oldSize = cache->closuresSize;
+    cache->closures = closures;
+    cache->closuresSize = size;
+    cache->closuresCount = 0;
+    for(size_t i = 0; i < oldSize; ++i) {
+        UA_TypeClosure *closure = old[i];
+        if(!closure)
+            continue;
+        if(drop && UA_TypeClosure_contains(closure, drop)) {
+#ifdef UA_ENABLE_MULTITHREADING
+            call_rcu(&closure->rcu_head, deleteTypeClosureRCU);
+#else
+            deleteTypeClosure(closure);
+#endif
             continue;
+        }
+        *findTypeClosure(cache, &closure->types[0]) = closure;
+        ++cache->closuresCount;
+    }
+    UA_free(old);
+    return UA_STATUSCODE_GOOD;
+}
+
+const UA_TypeClosure *
+getTypeClosure(UA_Server *server, const UA_Node *root) {
+    UA_TypeClosureCache *cache = &server->typeClosures;
+    UA_TypeClosure *closure = NULL;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    if(cache->closuresCount > 0)
+        closure = *findTypeClosure(cache, &root->nodeId);
+    if(closure)
+        goto finish;
+
+    /* Build and insert the closure */
+    if((cache->closuresCount + 1) * 2 > cache->closuresSize) {
+        size_t size = cache->closuresSize > 0 ? cache->closuresSize * 2 : 16;
+        if(rebuildTypeClosures(cache, size, NULL) != UA_STATUSCODE_GOOD)
+            goto finish;
+    }
+    closure = buildTypeClosure(server->nodestore, root);
+    if(closure) {
+        *findTypeClosure(cache, &root->nodeId) = closure;
+        ++cache->closuresCount;
+    }
+
+ finish:
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+    return closure;
+}
+
+UA_Boolean
+isSubtypeOf(UA_Server *server, const UA_NodeId *type, const UA_NodeId *superType) {
+    if(UA_NodeId_equal(type, superType))
+        return true;
+    const UA_Node *root = UA_NodeStore_get(server->nodestore, superType);
+    if(!root)
+        return false;
+    const UA_TypeClosure *closure = getTypeClosure(server, root);
+    if(!closure) {
+        const UA_NodeId hasSubtype = UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE);
+        return isNodeInTree(server->nodestore, type, superType, &hasSubtype, 1);
+    }
+    return UA_TypeClosure_contains(closure, type);
+}
 
-        /* Recurse only for valid reference types */
-        for(size_t j = 0; j < referenceTypeIdsSize; ++j) {
-            if(UA_NodeId_equal(&node->references[i].referenceTypeId, &referenceTypeIds[j]) &&
-               isNodeInTree(ns, &node->references[i].targetId.nodeId, nodeToFind,
-                            referenceTypeIds, referenceTypeIdsSize))
-                return true;
+void
+invalidateTypeClosures(UA_Server *server, const UA_NodeId *superType) {
+    UA_TypeClosureCache *cache = &server->typeClosures;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    if(cache->closuresCount > 0 &&
+       rebuildTypeClosures(cache, cache->closuresSize, superType) != UA_STATUSCODE_GOOD) {
+        /* Out of memory. Drop all closures. */
+        for(size_t i = 0; i < cache->closuresSize; ++i) {
+            if(!cache->closures[i])
+                continue;
+#ifdef UA_ENABLE_MULTITHREADING
+            call_rcu(&cache->closures[i]->rcu_head, deleteTypeClosureRCU);
+#else
+            deleteTypeClosure(cache->closures[i]);
+#endif
+            cache->closures[i] = NULL;
         }
+        cache->closuresCount = 0;
     }
-    return false;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+}
+
+void
+deleteTypeClosures(UA_Server *server) {
+    UA_TypeClosureCache *cache = &server->typeClosures;
+    for(size_t i = 0; i < cache->closuresSize; ++i) {
+        if(cache->closures[i])
+            deleteTypeClosure(cache->closures[i]);
+    }
+    UA_free(cache->closures);
+    cache->closures = NULL;
+    cache->closuresSize = 0;
+    cache->closuresCount = 0;
 }
 
 const UA_Node *
 getNodeType(UA_Server *server, const UA_Node *node) {
     /* The reference to the parent is different for variable and variabletype */
     UA_NodeId parentRef;
-    UA_Boolean inverse;
+    UA_BrowseDirection direction;
     if(node->nodeClass == UA_NODECLASS_VARIABLE ||
        node->nodeClass == UA_NODECLASS_OBJECT) {
         parentRef = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
-        inverse = false;
+        direction = UA_BROWSEDIRECTION_FORWARD;
     } else if(node->nodeClass == UA_NODECLASS_VARIABLETYPE ||
               /* node->nodeClass == UA_NODECLASS_OBJECTTYPE || // objecttype may have multiple parents */
               node->nodeClass == UA_NODECLASS_REFERENCETYPE ||
               node->nodeClass == UA_NODECLASS_DATATYPE) {
         parentRef = UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE);
-        inverse = true;
+        direction = UA_BROWSEDIRECTION_INVERSE;
     } else {
         return NULL;
     }
 
     /* stop at the first matching candidate */
-    UA_NodeId *parentId = NULL;
-    for(size_t i = 0; i < node->referencesSize; ++i) {
-        if(node->references[i].isInverse == inverse &&
-           UA_NodeId_equal(&node->references[i].referenceTypeId, &parentRef)) {
-            parentId = &node->references[i].targetId.nodeId;
-            break;
-        }
-    }
-
-    if(!parentId)
+    UA_ReferenceIterator it;
+    UA_ReferenceIterator_init(&it, node, direction, &parentRef, 1);
+    const UA_ReferenceNode *ref = UA_ReferenceIterator_next(&it);
+    if(!ref)
         return NULL;
-    return UA_NodeStore_get(server->nodestore, parentId);
+    return UA_NodeStore_get(server->nodestore, &ref->targetId.nodeId);
 }
 
 const UA_VariableTypeNode *
@@ -17781,7 +18962,7 @@ getVariableNodeType(UA_Server *server, const UA_VariableNode *node) {
 const UA_ObjectTypeNode *
 getObjectNodeType(UA_Server *server, const UA_ObjectNode *node) {
     const UA_Node *type = getNodeType(server, (const UA_Node*)node);
-    if(type->nodeClass != UA_NODECLASS_OBJECTTYPE)
+    if(!type || type->nodeClass != UA_NODECLASS_OBJECTTYPE)
         return NULL;
     return (const UA_ObjectTypeNode*)type;
 }
@@ -17790,30 +18971,118 @@ UA_Boolean
 UA_Node_hasSubTypeOrInstances(const UA_Node *node) {
     const UA_NodeId hasSubType = UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE);
     const UA_NodeId hasTypeDefinition = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
-    for(size_t i = 0; i < node->referencesSize; ++i) {
-        if(node->references[i].isInverse == false &&
-           UA_NodeId_equal(&node->references[i].referenceTypeId, &hasSubType))
-            return true;
-        if(node->references[i].isInverse == true &&
-           UA_NodeId_equal(&node->references[i].referenceTypeId, &hasTypeDefinition))
-            return true;
+    UA_ReferenceIterator it;
+    UA_ReferenceIterator_init(&it, node, UA_BROWSEDIRECTION_FORWARD, &hasSubType, 1);
+    if(UA_ReferenceIterator_next(&it))
+        return true;
+    UA_ReferenceIterator_init(&it, node, UA_BROWSEDIRECTION_INVERSE, &hasTypeDefinition, 1);
+    return (UA_ReferenceIterator_next(&it) != NULL);
+}
+
+const UA_Node *
+UA_Server_getSessionNode(UA_Server *server, const UA_Session *session,
+                         const UA_NodeId *nodeId) {
+    const UA_RegisteredNode *reg = UA_Session_getRegisteredNode(session, nodeId);
+    if(reg)
+        return UA_NodeStore_getHashed(server->nodestore, &reg->nodeId, reg->hash);
+    return UA_NodeStore_get(server->nodestore, nodeId);
+}
+
+/****************/
+/* Node Handles */
+/****************/
+
+UA_NodeHandle *
+UA_Server_getNodeHandle(UA_Server *server, const UA_NodeId nodeId) {
+    UA_RCU_LOCK();
+    const UA_Node *node = UA_NodeStore_get(server->nodestore, &nodeId);
+    UA_RCU_UNLOCK();
+    if(!node)
+        return NULL;
+    UA_NodeHandle *handle = UA_malloc(sizeof(UA_NodeHandle));
+    if(!handle)
+        return NULL;
+    if(UA_NodeId_copy(&nodeId, &handle->nodeId) != UA_STATUSCODE_GOOD) {
+        UA_free(handle);
+        return NULL;
     }
-    return false;
+    handle->hash = UA_NodeStore_hash(&nodeId);
+#ifndef UA_ENABLE_MULTITHREADING
+    handle->node = node;
+    handle->version = UA_NodeStore_getVersion(server->nodestore);
+#endif
+    return handle;
+}
+
+void
+UA_NodeHandle_delete(UA_NodeHandle *handle) {
+    if(!handle)
+        return;
+    UA_NodeId_deleteMembers(&handle->nodeId);
+    UA_free(handle);
+}
+
+const UA_Node *
+UA_Server_getHandleNode(UA_Server *server, UA_NodeHandle *handle) {
+#ifndef UA_ENABLE_MULTITHREADING
+    UA_UInt32 version = UA_NodeStore_getVersion(server->nodestore);
+    if(handle->node && handle->version == version)
+        return handle->node;
+    handle->node = UA_NodeStore_getHashed(server->nodestore, &handle->nodeId, handle->hash);
+    handle->version = version;
+    return handle->node;
+#else
+    return UA_NodeStore_getHashed(server->nodestore, &handle->nodeId, handle->hash);
+#endif
+}
+
+#ifndef UA_ENABLE_MULTITHREADING
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+static void
+deleteEncodedAttributes(UA_Server *server, void *encoded) {
+    UA_EncodedAttributes_delete((UA_EncodedAttributes*)encoded);
+}
+#endif
+
+static UA_StatusCode
+editFoundNode(UA_Server *server, UA_Session *session, const UA_Node *node,
+              UA_EditNodeCallback callback, const void *data) {
+    if(UA_NodeStore_isReadOnly(server->nodestore, node)) {
+        UA_Node *copy = UA_NodeStore_getCopy(server->nodestore, &node->nodeId);
+        if(!copy)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        UA_StatusCode retval = UA_NodeStore_replace(server->nodestore, copy);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+        node = copy;
+    }
+    UA_Node *editNode = (UA_Node*)(uintptr_t)node; // dirty cast
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    /* The encoded attributes are outdated. A Read that is in progress (the
+     * edit is made from a data source) may still point into them. */
+    UA_EncodedAttributes *encoded = UA_Node_takeEncodedAttributes(editNode);
+    if(encoded && UA_Server_delayedCallback(server, deleteEncodedAttributes,
+                                            encoded) != UA_STATUSCODE_GOOD)
+        UA_EncodedAttributes_delete(encoded);
+#endif
+    return callback(server, session, editNode, data);
 }
+#endif
 
 /* For mulithreading: make a copy of the node, edit and replace.
- * For singletrheading: edit the original */
+ * For singletrheading: edit the original. Nodes from an image are copied to
+ * the heap first. */
 UA_StatusCode
 UA_Server_editNode(UA_Server *server, UA_Session *session,
                    const UA_NodeId *nodeId, UA_EditNodeCallback callback,
                    const void *data) {
 #ifndef UA_ENABLE_MULTITHREADING
-    const UA_Node *node = UA_NodeStore_get(server->nodestore, nodeId);
+    const UA_Node *node = UA_Server_getSessionNode(server, session, nodeId);
     if(!node)
         return UA_STATUSCODE_BADNODEIDUNKNOWN;
-    UA_Node *editNode = (UA_Node*)(uintptr_t)node; // dirty cast
-    return callback(server, session, editNode, data);
+    return editFoundNode(server, session, node, callback, data);
 #else
+    nodeId = UA_Session_resolveNodeId(session, nodeId);
     UA_StatusCode retval;
     do {
         UA_Node *copy = UA_NodeStore_getCopy(server->nodestore, nodeId);
@@ -17830,6 +19099,21 @@ UA_Server_editNode(UA_Server *server, UA_Session *session,
 #endif
 }
 
+UA_StatusCode
+UA_Server_editNodeByHandle(UA_Server *server, UA_Session *session,
+                           UA_NodeHandle *handle, UA_EditNodeCallback callback,
+                           const void *data) {
+#ifndef UA_ENABLE_MULTITHREADING
+    const UA_Node *node = UA_Server_getHandleNode(server, handle);
+    if(!node)
+        return UA_STATUSCODE_BADNODEIDUNKNOWN;
+    return editFoundNode(server, session, node, callback, data);
+#else
+    /* The node is copied anyway */
+    return UA_Server_editNode(server, session, &handle->nodeId, callback, data);
+#endif
+}
+
 /*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_server_worker.c" ***********************************/
 
 /* This Source Code Form is subject to the terms of the Mozilla Public
@@ -18394,6 +19678,8 @@ UA_StatusCode UA_Server_run_startup(UA_Server *server) {
         result |= nl->start(nl, server->config.logger);
     }
 
+    /* The discovery urls of the networklayers are set now */
+    clearDiscoveryCache(server);
     return result;
 }
 
@@ -18868,534 +20154,2838 @@ UA_SessionManager_removeSession(UA_SessionManager *sm, const UA_NodeId *token) {
 *  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
 
 
-void UA_Node_deleteMembersAnyNodeClass(UA_Node *node) {
-    /* delete standard content */
-    UA_NodeId_deleteMembers(&node->nodeId);
-    UA_QualifiedName_deleteMembers(&node->browseName);
-    UA_LocalizedText_deleteMembers(&node->displayName);
-    UA_LocalizedText_deleteMembers(&node->description);
-    UA_Array_delete(node->references, node->referencesSize,
-                    &UA_TYPES[UA_TYPES_REFERENCENODE]);
-    node->references = NULL;
-    node->referencesSize = 0;
+#ifdef UA_ENABLE_MULTITHREADING
 
-    /* delete unique content of the nodeclass */
-    switch(node->nodeClass) {
-    case UA_NODECLASS_OBJECT:
-        break;
-    case UA_NODECLASS_METHOD:
-        break;
-    case UA_NODECLASS_OBJECTTYPE:
-        break;
-    case UA_NODECLASS_VARIABLE:
-    case UA_NODECLASS_VARIABLETYPE: {
-        UA_VariableNode *p = (UA_VariableNode*)node;
-        UA_NodeId_deleteMembers(&p->dataType);
-        UA_Array_delete(p->arrayDimensions, p->arrayDimensionsSize,
-                        &UA_TYPES[UA_TYPES_INT32]);
-        p->arrayDimensions = NULL;
-        p->arrayDimensionsSize = 0;
-        if(p->valueSource == UA_VALUESOURCE_DATA)
-            UA_DataValue_deleteMembers(&p->value.data.value);
-        break;
-    }
-    case UA_NODECLASS_REFERENCETYPE: {
-        UA_ReferenceTypeNode *p = (UA_ReferenceTypeNode*)node;
-        UA_LocalizedText_deleteMembers(&p->inverseName);
-        break;
-    }
+typedef struct {
+    struct rcu_head rcu_head;
+    UA_DataValue value;
+} UA_PublishedValue;
+
+struct UA_ValueSlot {
+    UA_PublishedValue *current; /* NULL until the first value is published.
+                                 * Then the value in the node is outdated. */
+    long refCount;
+};
+
+static void
+deletePublishedValue(struct rcu_head *head) {
+    UA_PublishedValue *pv = container_of(head, UA_PublishedValue, rcu_head);
+    UA_DataValue_deleteMembers(&pv->value);
+    UA_free(pv);
+}
+
+static void
+releaseValueSlot(struct UA_ValueSlot *slot) {
+    if(uatomic_sub_return(&slot->refCount, 1) > 0)
+        return;
+    /* The last node using the slot is deleted. Readers may still see the
+     * current value until the grace period ends. */
+    if(slot->current)
+        call_rcu(&slot->current->rcu_head, deletePublishedValue);
+    UA_free(slot);
+}
+
+UA_StatusCode
+UA_VariableNode_initValueSlot(UA_VariableNode *vn) {
+    struct UA_ValueSlot *slot = UA_malloc(sizeof(struct UA_ValueSlot));
+    if(!slot)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    slot->current = NULL;
+    slot->refCount = 1;
+    vn->valueSlot = slot;
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+UA_VariableNode_shareValueSlot(const UA_VariableNode *src, UA_VariableNode *dst) {
+    if(dst->valueSlot)
+        releaseValueSlot(dst->valueSlot);
+    dst->valueSlot = src->valueSlot;
+    if(dst->valueSlot)
+        uatomic_inc(&dst->valueSlot->refCount);
+}
+
+UA_StatusCode
+UA_VariableNode_publishValue(UA_VariableNode *vn, const UA_DataValue *expected,
+                             UA_DataValue *value) {
+    struct UA_ValueSlot *slot = vn->valueSlot;
+    if(!slot) {
+        /* Not yet in the nodestore. Nobody else can see the node. */
+        UA_DataValue_deleteMembers(&vn->value.data.value);
+        vn->value.data.value = *value;
+        return UA_STATUSCODE_GOOD;
+    }
+
+    UA_PublishedValue *pv = UA_malloc(sizeof(UA_PublishedValue));
+    if(!pv) {
+        UA_DataValue_deleteMembers(value);
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    }
+    pv->value = *value;
+
+    UA_PublishedValue *old;
+    if(!expected) {
+        old = rcu_xchg_pointer(&slot->current, pv);
+    } else {
+        UA_PublishedValue *exp = NULL;
+        if(expected != &vn->value.data.value)
+            exp = container_of(expected, UA_PublishedValue, value);
+        old = rcu_cmpxchg_pointer(&slot->current, exp, pv);
+        if(old != exp) {
+            /* Concurrent write. Retry with the new value. */
+            UA_DataValue_deleteMembers(&pv->value);
+            UA_free(pv);
+            return UA_STATUSCODE_BADINTERNALERROR;
+        }
+    }
+    if(old)
+        call_rcu(&old->rcu_head, deletePublishedValue);
+    return UA_STATUSCODE_GOOD;
+}
+
+#endif /* UA_ENABLE_MULTITHREADING */
+
+/***************/
+/* Value Cache */
+/***************/
+
+struct UA_ValueCache {
+    UA_Double maxAge;     /* [ms] upper bound for the age of cached values */
+    UA_DateTime readTime; /* monotonic time of the last read, 0 if empty */
+    UA_DateTime validFrom; /* values read before are outdated */
+    UA_DataValue value;   /* full value with the source timestamp */
+    UA_ValueCacheStatistics statistics;
+    long refCount;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_t mutex;
+#endif
+};
+
+#ifdef UA_ENABLE_MULTITHREADING
+# define UA_VALUECACHE_LOCK(c) pthread_mutex_lock(&(c)->mutex)
+# define UA_VALUECACHE_UNLOCK(c) pthread_mutex_unlock(&(c)->mutex)
+#else
+# define UA_VALUECACHE_LOCK(c)
+# define UA_VALUECACHE_UNLOCK(c)
+#endif
+
+struct UA_ValueCache *
+UA_ValueCache_retain(struct UA_ValueCache *cache) {
+#ifdef UA_ENABLE_MULTITHREADING
+    uatomic_inc(&cache->refCount);
+#else
+    ++cache->refCount;
+#endif
+    return cache;
+}
+
+void
+UA_ValueCache_release(struct UA_ValueCache *cache) {
+#ifdef UA_ENABLE_MULTITHREADING
+    if(uatomic_sub_return(&cache->refCount, 1) > 0)
+        return;
+    pthread_mutex_destroy(&cache->mutex);
+#else
+    if(--cache->refCount > 0)
+        return;
+#endif
+    UA_DataValue_deleteMembers(&cache->value);
+    UA_free(cache);
+}
+
+UA_StatusCode
+UA_VariableNode_setValueCache(UA_VariableNode *vn, UA_Double maxAge) {
+    if(vn->valueCache) {
+        UA_ValueCache_release(vn->valueCache);
+        vn->valueCache = NULL;
+    }
+    if(maxAge <= 0.0)
+        return UA_STATUSCODE_GOOD;
+    struct UA_ValueCache *cache = UA_calloc(1, sizeof(struct UA_ValueCache));
+    if(!cache)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    cache->maxAge = maxAge;
+    cache->refCount = 1;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_init(&cache->mutex, NULL);
+#endif
+    vn->valueCache = cache;
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+UA_VariableNode_shareValueCache(const UA_VariableNode *src, UA_VariableNode *dst) {
+    if(dst->valueCache)
+        UA_ValueCache_release(dst->valueCache);
+    dst->valueCache = src->valueCache;
+    if(dst->valueCache)
+        UA_ValueCache_retain(dst->valueCache);
+}
+
+UA_Boolean
+UA_ValueCache_read(struct UA_ValueCache *cache, UA_Double maxAge,
+                   const UA_NumericRange *range, UA_DataValue *v,
+                   UA_StatusCode *retval) {
+    if(maxAge > cache->maxAge)
+        maxAge = cache->maxAge;
+    UA_VALUECACHE_LOCK(cache);
+    if(cache->readTime == 0 ||
+       (UA_Double)(UA_DateTime_nowMonotonic() - cache->readTime) >
+       maxAge * UA_MSEC_TO_DATETIME) {
+        ++cache->statistics.misses;
+        UA_VALUECACHE_UNLOCK(cache);
+        return false;
+    }
+    ++cache->statistics.hits;
+    if(range) {
+        *v = cache->value;
+        UA_Variant_init(&v->value);
+        *retval = UA_Variant_copyRange(&cache->value.value, &v->value, *range);
+    } else {
+        *retval = UA_DataValue_copy(&cache->value, v);
+    }
+    UA_VALUECACHE_UNLOCK(cache);
+    return true;
+}
+
+void
+UA_ValueCache_update(struct UA_ValueCache *cache, const UA_DataValue *value,
+                     UA_DateTime readTime) {
+    UA_DataValue copy;
+    if(UA_DataValue_copy(value, &copy) != UA_STATUSCODE_GOOD)
+        return;
+    UA_VALUECACHE_LOCK(cache);
+    if(readTime < cache->readTime || readTime < cache->validFrom) {
+        /* A concurrent read already cached a newer value or the value was
+         * written in the meantime */
+        UA_VALUECACHE_UNLOCK(cache);
+        UA_DataValue_deleteMembers(&copy);
+        return;
+    }
+    UA_DataValue old = cache->value;
+    cache->value = copy;
+    cache->readTime = readTime;
+    UA_VALUECACHE_UNLOCK(cache);
+    UA_DataValue_deleteMembers(&old);
+}
+
+void
+UA_ValueCache_clear(struct UA_ValueCache *cache) {
+    UA_VALUECACHE_LOCK(cache);
+    UA_DataValue old = cache->value;
+    UA_DataValue_init(&cache->value);
+    cache->readTime = 0;
+    cache->validFrom = UA_DateTime_nowMonotonic();
+    UA_VALUECACHE_UNLOCK(cache);
+    UA_DataValue_deleteMembers(&old);
+}
+
+void
+UA_ValueCache_getStatistics(struct UA_ValueCache *cache,
+                            UA_ValueCacheStatistics *statistics) {
+    UA_VALUECACHE_LOCK(cache);
+    *statistics = cache->statistics;
+    UA_VALUECACHE_UNLOCK(cache);
+}
+
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+
+/*******************/
+/* Attribute Cache */
+/*******************/
+
+const UA_ByteString *
+UA_Node_findEncodedAttribute(const UA_Node *node, UA_UInt32 attributeId) {
+    const UA_EncodedAttributes *encoded = node->encodedAttributes;
+    if(!encoded || attributeId == 0 || attributeId > UA_ATTRIBUTEID_USEREXECUTABLE)
+        return NULL;
+    return encoded->attributes[attributeId - 1];
+}
+
+const UA_ByteString *
+UA_Node_addEncodedAttribute(const UA_Node *node, UA_UInt32 attributeId,
+                            const UA_Variant *value) {
+    if(attributeId == 0 || attributeId > UA_ATTRIBUTEID_USEREXECUTABLE)
+        return NULL;
+
+    /* Create the table. Concurrent readers may do the same. */
+    UA_EncodedAttributes *encoded = node->encodedAttributes;
+    if(!encoded) {
+        UA_EncodedAttributes *table = UA_calloc(1, sizeof(UA_EncodedAttributes));
+        if(!table)
+            return NULL;
+        void * volatile *ptr = (void * volatile *)(uintptr_t)&node->encodedAttributes;
+        encoded = UA_atomic_cmpxchg(ptr, NULL, table);
+        if(encoded)
+            UA_free(table);
+        else
+            encoded = table;
+    }
+
+    /* Encode behind the ByteString */
+    size_t size = UA_calcSizeBinary((void*)(uintptr_t)value, &UA_TYPES[UA_TYPES_VARIANT]);
+    UA_ByteString *encoding = UA_malloc(sizeof(UA_ByteString) + size);
+    if(!encoding)
+        return NULL;
+    encoding->data = (UA_Byte*)encoding + sizeof(UA_ByteString);
+    encoding->length = size;
+    size_t offset = 0;
+    if(UA_encodeBinary(value, &UA_TYPES[UA_TYPES_VARIANT], NULL, NULL,
+                       encoding, &offset) != UA_STATUSCODE_GOOD) {
+        UA_free(encoding);
+        return NULL;
+    }
+
+    /* Keep the first encoding if another reader was faster */
+    void * volatile *slot = (void * volatile *)&encoded->attributes[attributeId - 1];
+    UA_ByteString *current = UA_atomic_cmpxchg(slot, NULL, encoding);
+    if(!current)
+        return encoding;
+    UA_free(encoding);
+    return current;
+}
+
+UA_EncodedAttributes *
+UA_Node_takeEncodedAttributes(UA_Node *node) {
+    UA_EncodedAttributes *encoded = node->encodedAttributes;
+    node->encodedAttributes = NULL;
+    return encoded;
+}
+
+void
+UA_EncodedAttributes_delete(UA_EncodedAttributes *encoded) {
+    if(!encoded)
+        return;
+    for(size_t i = 0; i < UA_ATTRIBUTEID_USEREXECUTABLE; ++i)
+        UA_free(encoded->attributes[i]);
+    UA_free(encoded);
+}
+
+#endif /* UA_ENABLE_ATTRIBUTE_CACHE */
+
+#ifdef UA_ENABLE_COMPACT_NODES
+
+/* Locales of the LocalizedTexts in nodes are stored once in an append-only
+ * arena. Every entry is a length byte followed by the string. The arena is
+ * never freed. If it is full, the locales are copied as usual. */
+#define UA_LOCALE_ARENA_SIZE 1024
+static UA_Byte localeArena[UA_LOCALE_ARENA_SIZE];
+static size_t localeArenaSize;
+#ifdef UA_ENABLE_MULTITHREADING
+static pthread_mutex_t localeArenaMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static UA_Boolean
+isSharedLocale(const UA_String *s) {
+    return s->data >= localeArena && s->data < &localeArena[UA_LOCALE_ARENA_SIZE];
+}
+
+static UA_Boolean
+shareLocale(const UA_String *src, UA_String *dst) {
+    if(src->length == 0 || src->length > 255)
+        return false;
+    UA_Boolean found = false;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&localeArenaMutex);
+#endif
+    size_t pos = 0;
+    while(pos < localeArenaSize) {
+        size_t len = localeArena[pos];
+        if(len == src->length && memcmp(&localeArena[pos+1], src->data, len) == 0) {
+            found = true;
+            break;
+        }
+        pos += len + 1;
+    }
+    if(!found && localeArenaSize + src->length + 1 <= UA_LOCALE_ARENA_SIZE) {
+        localeArena[pos] = (UA_Byte)src->length;
+        memcpy(&localeArena[pos+1], src->data, src->length);
+        localeArenaSize += src->length + 1;
+        found = true;
+    }
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&localeArenaMutex);
+#endif
+    if(found) {
+        dst->length = src->length;
+        dst->data = &localeArena[pos+1];
+    }
+    return found;
+}
+
+UA_StatusCode
+UA_Node_copyText(const UA_LocalizedText *src, UA_LocalizedText *dst) {
+    UA_LocalizedText_init(dst);
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    if(!shareLocale(&src->locale, &dst->locale))
+        retval = UA_String_copy(&src->locale, &dst->locale);
+    retval |= UA_String_copy(&src->text, &dst->text);
+    if(retval != UA_STATUSCODE_GOOD)
+        UA_Node_deleteText(dst);
+    return retval;
+}
+
+void
+UA_Node_deleteText(UA_LocalizedText *text) {
+    if(!isSharedLocale(&text->locale))
+        UA_String_deleteMembers(&text->locale);
+    UA_String_deleteMembers(&text->text);
+    UA_LocalizedText_init(text);
+}
+
+#endif /* UA_ENABLE_COMPACT_NODES */
+
+void
+UA_Node_moveText(UA_LocalizedText *src, UA_LocalizedText *dst) {
+    *dst = *src;
+#ifdef UA_ENABLE_COMPACT_NODES
+    if(shareLocale(&src->locale, &dst->locale))
+        UA_String_deleteMembers(&src->locale);
+#endif
+    UA_LocalizedText_init(src);
+}
+
+void
+UA_Node_getDisplayName(const UA_Node *node, UA_LocalizedText *displayName) {
+    *displayName = node->displayName;
+#ifdef UA_ENABLE_COMPACT_NODES
+    if(!node->displayName.text.data)
+        displayName->text = node->browseName.name;
+#endif
+}
+
+const UA_DataValue *
+UA_VariableNode_getValue(const UA_VariableNode *vn) {
+#ifdef UA_ENABLE_MULTITHREADING
+    if(vn->nodeClass == UA_NODECLASS_VARIABLE && vn->valueSlot) {
+        UA_PublishedValue *pv = rcu_dereference(vn->valueSlot->current);
+        if(pv)
+            return &pv->value;
+    }
+#endif
+    return &vn->value.data.value;
+}
+
+/*******************/
+/* Reference Index */
+/*******************/
+
+/* Nodes with many references get an index over the references array. The
+ * positions of the references are grouped by (referenceTypeId, isInverse). A
+ * hash set over (referenceTypeId, isInverse, target) with linear probing finds
+ * single references. A second hash set over the BrowseNames of the targets of
+ * forward references finds children by name. It is only used when the names
+ * of all these targets are known. */
+#define UA_REFERENCEINDEX_MINSIZE 16
+
+typedef struct {
+    UA_NodeId referenceTypeId;
+    UA_Boolean isInverse;
+    UA_UInt32 refsSize;
+    UA_UInt32 refsCapacity;
+    UA_UInt32 *refs; /* positions in the references array */
+} UA_ReferenceGroup;
+
+typedef struct {
+    UA_UInt32 hash;
+    UA_UInt32 groupPos; /* position in the refs of the group */
+    UA_UInt32 nameHash; /* hash of the BrowseName of the target */
+    UA_Boolean named;
+} UA_ReferenceIndexEntry;
+
+struct UA_ReferenceIndex {
+    size_t groupsSize;
+    UA_ReferenceGroup *groups;
+    size_t entriesCapacity;
+    UA_ReferenceIndexEntry *entries; /* one entry per reference */
+    UA_UInt32 slotsCount;
+    UA_UInt32 slotsSize; /* power of two, at most half full */
+    UA_UInt32 *slots;    /* position of the reference + 1, 0 if empty */
+    UA_UInt32 *nameSlots; /* same for the named references */
+    size_t unnamedSize;   /* forward references without a known name */
+    size_t namedUpTo;     /* the targets below were looked up by name */
+};
+
+static UA_UInt32
+browseNameHash(const UA_QualifiedName *browseName) {
+    return fnv32(browseName->namespaceIndex, browseName->name.data,
+                 browseName->name.length);
+}
+
+static UA_UInt32
+referenceHash(const UA_NodeId *referenceTypeId, UA_Boolean isInverse,
+              const UA_NodeId *target) {
+    UA_UInt32 h = UA_NodeId_hash(target);
+    h ^= UA_NodeId_hash(referenceTypeId) * 31 + isInverse;
+    h ^= h >> 15;
+    h *= 2246822519u;
+    h ^= h >> 13;
+    return h;
+}
+
+static void
+deleteReferenceIndex(struct UA_ReferenceIndex *index) {
+    for(size_t i = 0; i < index->groupsSize; ++i) {
+        UA_NodeId_deleteMembers(&index->groups[i].referenceTypeId);
+        UA_free(index->groups[i].refs);
+    }
+    UA_free(index->groups);
+    UA_free(index->entries);
+    UA_free(index->slots);
+    UA_free(index->nameSlots);
+    UA_free(index);
+}
+
+static UA_ReferenceGroup *
+findReferenceGroup(const struct UA_ReferenceIndex *index,
+                   const UA_NodeId *referenceTypeId, UA_Boolean isInverse) {
+    for(size_t i = 0; i < index->groupsSize; ++i) {
+        UA_ReferenceGroup *g = &index->groups[i];
+        if(g->isInverse == isInverse && UA_NodeId_equal(&g->referenceTypeId, referenceTypeId))
+            return g;
+    }
+    return NULL;
+}
+
+/* Returns the slot holding the position */
+static UA_UInt32
+findReferenceSlot(const struct UA_ReferenceIndex *index, size_t pos) {
+    UA_UInt32 mask = index->slotsSize - 1;
+    UA_UInt32 s = index->entries[pos].hash & mask;
+    while(index->slots[s] != pos + 1)
+        s = (s + 1) & mask;
+    return s;
+}
+
+static void
+insertReferenceSlot(struct UA_ReferenceIndex *index, size_t pos) {
+    UA_UInt32 mask = index->slotsSize - 1;
+    UA_UInt32 s = index->entries[pos].hash & mask;
+    while(index->slots[s] != 0)
+        s = (s + 1) & mask;
+    index->slots[s] = (UA_UInt32)pos + 1;
+    ++index->slotsCount;
+}
+
+/* Returns the name slot holding the position */
+static UA_UInt32
+findNameSlot(const struct UA_ReferenceIndex *index, size_t pos) {
+    UA_UInt32 mask = index->slotsSize - 1;
+    UA_UInt32 s = index->entries[pos].nameHash & mask;
+    while(index->nameSlots[s] != pos + 1)
+        s = (s + 1) & mask;
+    return s;
+}
+
+static void
+insertNameSlot(struct UA_ReferenceIndex *index, size_t pos) {
+    UA_UInt32 mask = index->slotsSize - 1;
+    UA_UInt32 s = index->entries[pos].nameHash & mask;
+    while(index->nameSlots[s] != 0)
+        s = (s + 1) & mask;
+    index->nameSlots[s] = (UA_UInt32)pos + 1;
+}
+
+/* Backward shift deletion. Moves later slots of the probe sequence into the
+ * hole. */
+static void
+removeSlot(const struct UA_ReferenceIndex *index, UA_UInt32 *slots,
+           UA_UInt32 hole, UA_Boolean byName) {
+    UA_UInt32 mask = index->slotsSize - 1;
+    for(UA_UInt32 s = (hole + 1) & mask; slots[s] != 0; s = (s + 1) & mask) {
+        const UA_ReferenceIndexEntry *e = &index->entries[slots[s] - 1];
+        UA_UInt32 home = (byName ? e->nameHash : e->hash) & mask;
+        if(((s - home) & mask) < ((s - hole) & mask))
+            continue;
+        slots[hole] = slots[s];
+        hole = s;
+    }
+    slots[hole] = 0;
+}
+
+static UA_StatusCode
+resizeReferenceSlots(struct UA_ReferenceIndex *index, UA_UInt32 size) {
+    UA_UInt32 *slots = (UA_UInt32*)UA_calloc(size, sizeof(UA_UInt32));
+    UA_UInt32 *nameSlots = (UA_UInt32*)UA_calloc(size, sizeof(UA_UInt32));
+    if(!slots || !nameSlots) {
+        UA_free(slots);
+        UA_free(nameSlots);
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    }
+    UA_UInt32 *oldSlots = index->slots;
+    UA_UInt32 *oldNameSlots = index->nameSlots;
+    UA_UInt32 oldSize = index->slotsSize;
+    index->slots = slots;
+    index->nameSlots = nameSlots;
+    index->slotsSize = size;
+    index->slotsCount = 0;
+    for(UA_UInt32 i = 0; i < oldSize; ++i) {
+        if(oldSlots[i] != 0)
+            insertReferenceSlot(index, oldSlots[i] - 1);
+        if(oldNameSlots[i] != 0)
+            insertNameSlot(index, oldNameSlots[i] - 1);
+    }
+    UA_free(oldSlots);
+    UA_free(oldNameSlots);
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+indexReference(const UA_Node *node, struct UA_ReferenceIndex *index, size_t pos) {
+    const UA_ReferenceNode *ref = &node->references[pos];
+
+    /* Make room */
+    if(pos >= index->entriesCapacity) {
+        size_t cap = index->entriesCapacity * 2;
+        if(cap <= pos)
+            cap = pos + 1;
+        UA_ReferenceIndexEntry *entries = (UA_ReferenceIndexEntry*)
+            UA_realloc(index->entries, cap * sizeof(UA_ReferenceIndexEntry));
+        if(!entries)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        index->entries = entries;
+        index->entriesCapacity = cap;
+    }
+    if((index->slotsCount + 1) * 2 > index->slotsSize &&
+       resizeReferenceSlots(index, index->slotsSize * 2) != UA_STATUSCODE_GOOD)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    UA_ReferenceGroup *g = findReferenceGroup(index, &ref->referenceTypeId, ref->isInverse);
+    if(!g) {
+        g = (UA_ReferenceGroup*)UA_realloc(index->groups, (index->groupsSize + 1) *
+                                           sizeof(UA_ReferenceGroup));
+        if(!g)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        index->groups = g;
+        g = &g[index->groupsSize];
+        memset(g, 0, sizeof(UA_ReferenceGroup));
+        if(UA_NodeId_copy(&ref->referenceTypeId, &g->referenceTypeId) != UA_STATUSCODE_GOOD)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        g->isInverse = ref->isInverse;
+        ++index->groupsSize;
+    }
+    if(g->refsSize == g->refsCapacity) {
+        UA_UInt32 cap = g->refsCapacity > 0 ? g->refsCapacity * 2 : 4;
+        UA_UInt32 *refs = (UA_UInt32*)UA_realloc(g->refs, cap * sizeof(UA_UInt32));
+        if(!refs)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        g->refs = refs;
+        g->refsCapacity = cap;
+    }
+
+    /* Add to the group and the hash set */
+    index->entries[pos].hash = referenceHash(&ref->referenceTypeId, ref->isInverse,
+                                             &ref->targetId.nodeId);
+    index->entries[pos].groupPos = g->refsSize;
+    index->entries[pos].named = false;
+    if(!ref->isInverse)
+        ++index->unnamedSize;
+    g->refs[g->refsSize++] = (UA_UInt32)pos;
+    insertReferenceSlot(index, pos);
+    return UA_STATUSCODE_GOOD;
+}
+
+static void
+unindexReference(const UA_Node *node, struct UA_ReferenceIndex *index, size_t pos) {
+    /* Remove from the group. The last position of the group takes its place. */
+    const UA_ReferenceNode *ref = &node->references[pos];
+    UA_ReferenceGroup *g = findReferenceGroup(index, &ref->referenceTypeId, ref->isInverse);
+    UA_UInt32 groupPos = index->entries[pos].groupPos;
+    UA_UInt32 moved = g->refs[--g->refsSize];
+    if(groupPos != g->refsSize) {
+        g->refs[groupPos] = moved;
+        index->entries[moved].groupPos = groupPos;
+    }
+    if(g->refsSize == 0) {
+        UA_NodeId_deleteMembers(&g->referenceTypeId);
+        UA_free(g->refs);
+        *g = index->groups[--index->groupsSize];
+    }
+
+    /* Remove from the hash sets */
+    removeSlot(index, index->slots, findReferenceSlot(index, pos), false);
+    --index->slotsCount;
+    if(index->entries[pos].named)
+        removeSlot(index, index->nameSlots, findNameSlot(index, pos), true);
+    else if(!ref->isInverse)
+        --index->unnamedSize;
+}
+
+static UA_StatusCode
+buildReferenceIndex(UA_Node *node) {
+    struct UA_ReferenceIndex *index =
+        (struct UA_ReferenceIndex*)UA_calloc(1, sizeof(struct UA_ReferenceIndex));
+    if(!index)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    UA_UInt32 size = 8;
+    while(size < node->referencesSize * 2)
+        size *= 2;
+    UA_StatusCode retval = resizeReferenceSlots(index, size);
+    for(size_t i = 0; i < node->referencesSize && retval == UA_STATUSCODE_GOOD; ++i)
+        retval = indexReference(node, index, i);
+    if(retval != UA_STATUSCODE_GOOD) {
+        deleteReferenceIndex(index);
+        return retval;
+    }
+    node->referenceIndex = index;
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+UA_Node_indexReferences(UA_Node *node, size_t first) {
+    if(!node->referenceIndex) {
+        if(node->referencesSize >= UA_REFERENCEINDEX_MINSIZE)
+            buildReferenceIndex(node);
+        return;
+    }
+    for(size_t i = first; i < node->referencesSize; ++i) {
+        if(indexReference(node, node->referenceIndex, i) != UA_STATUSCODE_GOOD) {
+            /* Fall back to linear search */
+            deleteReferenceIndex(node->referenceIndex);
+            node->referenceIndex = NULL;
+            return;
+        }
+    }
+}
+
+size_t
+UA_Node_findReference(const UA_Node *node, const UA_NodeId *referenceTypeId,
+                      UA_Boolean isInverse, const UA_NodeId *target) {
+    const struct UA_ReferenceIndex *index = node->referenceIndex;
+    if(!index) {
+        for(size_t i = 0; i < node->referencesSize; ++i) {
+            const UA_ReferenceNode *ref = &node->references[i];
+            if(ref->isInverse == isInverse &&
+               UA_NodeId_equal(&ref->targetId.nodeId, target) &&
+               UA_NodeId_equal(&ref->referenceTypeId, referenceTypeId))
+                return i;
+        }
+        return node->referencesSize;
+    }
+    UA_UInt32 h = referenceHash(referenceTypeId, isInverse, target);
+    UA_UInt32 mask = index->slotsSize - 1;
+    for(UA_UInt32 s = h & mask; index->slots[s] != 0; s = (s + 1) & mask) {
+        size_t pos = index->slots[s] - 1;
+        const UA_ReferenceNode *ref = &node->references[pos];
+        if(index->entries[pos].hash == h && ref->isInverse == isInverse &&
+           UA_NodeId_equal(&ref->targetId.nodeId, target) &&
+           UA_NodeId_equal(&ref->referenceTypeId, referenceTypeId))
+            return pos;
+    }
+    return node->referencesSize;
+}
+
+static void
+setTargetName(struct UA_ReferenceIndex *index, size_t pos,
+              const UA_QualifiedName *browseName) {
+    UA_ReferenceIndexEntry *e = &index->entries[pos];
+    if(e->named)
+        removeSlot(index, index->nameSlots, findNameSlot(index, pos), true);
+    else
+        --index->unnamedSize;
+    e->nameHash = browseNameHash(browseName);
+    e->named = true;
+    insertNameSlot(index, pos);
+}
+
+void
+UA_Node_setReferenceTargetName(UA_Node *node, size_t pos,
+                               const UA_QualifiedName *browseName) {
+    if(!node->referenceIndex || pos >= node->referencesSize ||
+       node->references[pos].isInverse)
+        return;
+    setTargetName(node->referenceIndex, pos, browseName);
+}
+
+void
+UA_Node_nameReferenceTargets(UA_Node *node, UA_NodeStore *ns) {
+    struct UA_ReferenceIndex *index = node->referenceIndex;
+    if(!index)
+        return;
+    for(size_t i = index->namedUpTo; i < node->referencesSize; ++i) {
+        const UA_ReferenceNode *ref = &node->references[i];
+        if(ref->isInverse || index->entries[i].named || ref->targetId.serverIndex != 0)
+            continue;
+        const UA_Node *target = UA_NodeStore_get(ns, &ref->targetId.nodeId);
+        if(target)
+            setTargetName(index, i, &target->browseName);
+    }
+    index->namedUpTo = node->referencesSize;
+}
+
+UA_StatusCode
+UA_Node_reserveReferences(UA_Node *node, size_t capacity) {
+    if(capacity <= node->referencesCapacity || capacity <= node->referencesSize)
+        return UA_STATUSCODE_GOOD;
+    UA_ReferenceNode *refs =
+        (UA_ReferenceNode*)UA_realloc(node->references, capacity * sizeof(UA_ReferenceNode));
+    if(!refs)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    node->references = refs;
+    node->referencesCapacity = capacity;
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode
+UA_Node_growReferences(UA_Node *node, size_t count) {
+    size_t required = node->referencesSize + count;
+    if(required <= node->referencesCapacity)
+        return UA_STATUSCODE_GOOD;
+    size_t capacity = node->referencesCapacity * 2;
+    if(capacity < node->referencesSize * 2)
+        capacity = node->referencesSize * 2;
+    if(capacity < 4)
+        capacity = 4;
+    if(capacity < required)
+        capacity = required;
+    return UA_Node_reserveReferences(node, capacity);
+}
+
+void
+UA_Node_removeReference(UA_Node *node, size_t pos) {
+    struct UA_ReferenceIndex *index = node->referenceIndex;
+    size_t last = node->referencesSize - 1;
+    if(index) {
+        unindexReference(node, index, pos);
+        if(pos != last) {
+            /* The last reference moves to the position */
+            const UA_ReferenceNode *ref = &node->references[last];
+            index->slots[findReferenceSlot(index, last)] = (UA_UInt32)pos + 1;
+            if(index->entries[last].named)
+                index->nameSlots[findNameSlot(index, last)] = (UA_UInt32)pos + 1;
+            index->entries[pos] = index->entries[last];
+            UA_ReferenceGroup *g = findReferenceGroup(index, &ref->referenceTypeId,
+                                                      ref->isInverse);
+            g->refs[index->entries[pos].groupPos] = (UA_UInt32)pos;
+        }
+    }
+    UA_ReferenceNode_deleteMembers(&node->references[pos]);
+    node->references[pos] = node->references[last];
+    node->referencesSize = last;
+    if(index && index->namedUpTo > last)
+        index->namedUpTo = last;
+    if(last == 0) {
+        UA_free(node->references);
+        node->references = NULL;
+        node->referencesCapacity = 0;
+        if(index)
+            deleteReferenceIndex(index);
+        node->referenceIndex = NULL;
+        return;
+    }
+
+    /* Shrink when the array is mostly empty */
+    if(node->referencesCapacity >= 16 && last <= node->referencesCapacity / 4) {
+        size_t capacity = node->referencesCapacity / 2;
+        UA_ReferenceNode *refs =
+            (UA_ReferenceNode*)UA_realloc(node->references, capacity * sizeof(UA_ReferenceNode));
+        if(refs) {
+            node->references = refs;
+            node->referencesCapacity = capacity;
+        }
+    }
+}
+
+static UA_Boolean
+referenceIteratorMatches(const UA_ReferenceIterator *it, const UA_NodeId *referenceTypeId,
+                         UA_Boolean isInverse) {
+    if(isInverse && it->direction == UA_BROWSEDIRECTION_FORWARD)
+        return false;
+    if(!isInverse && it->direction == UA_BROWSEDIRECTION_INVERSE)
+        return false;
+    if(it->referenceTypeClosure)
+        return UA_TypeClosure_contains(it->referenceTypeClosure, referenceTypeId);
+    if(it->referenceTypesSize == 0)
+        return true;
+    for(size_t i = 0; i < it->referenceTypesSize; ++i) {
+        if(UA_NodeId_equal(&it->referenceTypes[i], referenceTypeId))
+            return true;
+    }
+    return false;
+}
+
+void
+UA_ReferenceIterator_init(UA_ReferenceIterator *it, const UA_Node *node,
+                          UA_BrowseDirection direction, const UA_NodeId *referenceTypes,
+                          size_t referenceTypesSize) {
+    it->node = node;
+    it->direction = direction;
+    it->referenceTypes = referenceTypes;
+    it->referenceTypesSize = referenceTypesSize;
+    it->referenceTypeClosure = NULL;
+    it->byName = false;
+    it->nameHash = 0;
+    it->group = 0;
+    it->pos = 0;
+}
+
+void
+UA_ReferenceIterator_initSubtypes(UA_ReferenceIterator *it, const UA_Node *node,
+                                  UA_BrowseDirection direction,
+                                  const struct UA_TypeClosure *referenceTypes) {
+    UA_ReferenceIterator_init(it, node, direction, NULL, 0);
+    it->referenceTypeClosure = referenceTypes;
+}
+
+UA_Boolean
+UA_ReferenceIterator_setTargetName(UA_ReferenceIterator *it,
+                                   const UA_QualifiedName *browseName) {
+    const struct UA_ReferenceIndex *index = it->node->referenceIndex;
+    if(!index || index->unnamedSize > 0 || it->direction != UA_BROWSEDIRECTION_FORWARD)
+        return false;
+    it->byName = true;
+    it->nameHash = browseNameHash(browseName);
+    it->pos = it->nameHash & (index->slotsSize - 1);
+    return true;
+}
+
+const UA_ReferenceNode *
+UA_ReferenceIterator_next(UA_ReferenceIterator *it) {
+    const UA_Node *node = it->node;
+    const struct UA_ReferenceIndex *index = node->referenceIndex;
+    if(it->byName) {
+        /* Walk the probe sequence of the name. pos is the next slot. */
+        UA_UInt32 mask = index->slotsSize - 1;
+        while(index->nameSlots[it->pos] != 0) {
+            size_t pos = index->nameSlots[it->pos] - 1;
+            it->pos = (it->pos + 1) & mask;
+            const UA_ReferenceNode *ref = &node->references[pos];
+            if(index->entries[pos].nameHash == it->nameHash &&
+               referenceIteratorMatches(it, &ref->referenceTypeId, ref->isInverse))
+                return ref;
+        }
+        return NULL;
+    }
+    if(!index) {
+        while(it->pos < node->referencesSize) {
+            const UA_ReferenceNode *ref = &node->references[it->pos++];
+            if(referenceIteratorMatches(it, &ref->referenceTypeId, ref->isInverse))
+                return ref;
+        }
+        return NULL;
+    }
+
+    /* Groups are matched as a whole when they are entered */
+    while(it->group < index->groupsSize) {
+        const UA_ReferenceGroup *g = &index->groups[it->group];
+        if(it->pos < g->refsSize && (it->pos > 0 ||
+           referenceIteratorMatches(it, &g->referenceTypeId, g->isInverse)))
+            return &node->references[g->refs[it->pos++]];
+        ++it->group;
+        it->pos = 0;
+    }
+    return NULL;
+}
+
+/* The references of the copy are at the same positions */
+static void
+copyReferenceTargetNames(const UA_Node *src, UA_Node *dst) {
+    const struct UA_ReferenceIndex *srcIndex = src->referenceIndex;
+    struct UA_ReferenceIndex *index = dst->referenceIndex;
+    if(!srcIndex || !index)
+        return;
+    for(size_t i = 0; i < dst->referencesSize; ++i) {
+        if(!srcIndex->entries[i].named)
+            continue;
+        index->entries[i].nameHash = srcIndex->entries[i].nameHash;
+        index->entries[i].named = true;
+        insertNameSlot(index, i);
+        --index->unnamedSize;
+    }
+    index->namedUpTo = srcIndex->namedUpTo;
+}
+
+static size_t
+referenceIndexHeapSize(const UA_Node *node) {
+    const struct UA_ReferenceIndex *index = node->referenceIndex;
+    if(!index)
+        return 0;
+    size_t size = sizeof(struct UA_ReferenceIndex) +
+        index->groupsSize * sizeof(UA_ReferenceGroup) +
+        index->entriesCapacity * sizeof(UA_ReferenceIndexEntry) +
+        index->slotsSize * 2 * sizeof(UA_UInt32);
+    for(size_t i = 0; i < index->groupsSize; ++i)
+        size += index->groups[i].refsCapacity * sizeof(UA_UInt32);
+    return size;
+}
+
+void UA_Node_deleteMembersAnyNodeClass(UA_Node *node) {
+    /* delete standard content */
+    UA_NodeId_deleteMembers(&node->nodeId);
+    UA_QualifiedName_deleteMembers(&node->browseName);
+    UA_Node_deleteText(&node->displayName);
+    UA_Node_deleteText(&node->description);
+    UA_Array_delete(node->references, node->referencesSize,
+                    &UA_TYPES[UA_TYPES_REFERENCENODE]);
+    node->references = NULL;
+    node->referencesSize = 0;
+    node->referencesCapacity = 0;
+    if(node->referenceIndex) {
+        deleteReferenceIndex(node->referenceIndex);
+        node->referenceIndex = NULL;
+    }
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    UA_EncodedAttributes_delete(UA_Node_takeEncodedAttributes(node));
+#endif
+
+    /* delete unique content of the nodeclass */
+    switch(node->nodeClass) {
+    case UA_NODECLASS_OBJECT:
+        break;
+    case UA_NODECLASS_METHOD:
+        break;
+    case UA_NODECLASS_OBJECTTYPE:
+        break;
+    case UA_NODECLASS_VARIABLE:
+    case UA_NODECLASS_VARIABLETYPE: {
+        UA_VariableNode *p = (UA_VariableNode*)node;
+        UA_NodeId_deleteMembers(&p->dataType);
+        UA_Array_delete(p->arrayDimensions, p->arrayDimensionsSize,
+                        &UA_TYPES[UA_TYPES_INT32]);
+        p->arrayDimensions = NULL;
+        p->arrayDimensionsSize = 0;
+        if(p->valueSource == UA_VALUESOURCE_DATA)
+            UA_DataValue_deleteMembers(&p->value.data.value);
+#ifdef UA_ENABLE_MULTITHREADING
+        if(node->nodeClass == UA_NODECLASS_VARIABLE && p->valueSlot) {
+            releaseValueSlot(p->valueSlot);
+            p->valueSlot = NULL;
+        }
+#endif
+        if(node->nodeClass == UA_NODECLASS_VARIABLE && p->valueCache) {
+            UA_ValueCache_release(p->valueCache);
+            p->valueCache = NULL;
+        }
+        break;
+    }
+    case UA_NODECLASS_REFERENCETYPE: {
+        UA_ReferenceTypeNode *p = (UA_ReferenceTypeNode*)node;
+        UA_Node_deleteText(&p->inverseName);
+        break;
+    }
+    case UA_NODECLASS_DATATYPE:
+        break;
+    case UA_NODECLASS_VIEW:
+        break;
+    default:
+        break;
+    }
+}
+
+static UA_StatusCode
+UA_ObjectNode_copy(const UA_ObjectNode *src, UA_ObjectNode *dst) {
+    dst->eventNotifier = src->eventNotifier;
+    dst->instanceHandle = src->instanceHandle;
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+UA_CommonVariableNode_copy(const UA_VariableNode *src, UA_VariableNode *dst) {
+    UA_StatusCode retval = UA_Array_copy(src->arrayDimensions,
+                                         src->arrayDimensionsSize,
+                                         (void**)&dst->arrayDimensions,
+                                         &UA_TYPES[UA_TYPES_INT32]);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    dst->arrayDimensionsSize = src->arrayDimensionsSize;
+    retval = UA_NodeId_copy(&src->dataType, &dst->dataType);
+    dst->valueRank = src->valueRank;
+    dst->valueSource = src->valueSource;
+    if(src->valueSource == UA_VALUESOURCE_DATA) {
+        retval |= UA_DataValue_copy(UA_VariableNode_getValue(src),
+                                    &dst->value.data.value);
+        dst->value.data.callback = src->value.data.callback;
+    } else
+        dst->value.dataSource = src->value.dataSource;
+    return retval;
+}
+
+static UA_StatusCode
+UA_VariableNode_copy(const UA_VariableNode *src, UA_VariableNode *dst) {
+    UA_StatusCode retval = UA_CommonVariableNode_copy(src, dst);
+    dst->accessLevel = src->accessLevel;
+    dst->userAccessLevel = src->userAccessLevel;
+    dst->minimumSamplingInterval = src->minimumSamplingInterval;
+    dst->historizing = src->historizing;
+    return retval;
+}
+
+static UA_StatusCode
+UA_VariableTypeNode_copy(const UA_VariableTypeNode *src,
+                         UA_VariableTypeNode *dst) {
+    UA_StatusCode retval = UA_CommonVariableNode_copy((const UA_VariableNode*)src,
+                                                      (UA_VariableNode*)dst);
+    dst->isAbstract = src->isAbstract;
+    return retval;
+}
+
+static UA_StatusCode
+UA_MethodNode_copy(const UA_MethodNode *src, UA_MethodNode *dst) {
+    dst->executable = src->executable;
+    dst->userExecutable = src->userExecutable;
+    dst->methodHandle  = src->methodHandle;
+    dst->attachedMethod = src->attachedMethod;
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+UA_ObjectTypeNode_copy(const UA_ObjectTypeNode *src, UA_ObjectTypeNode *dst) {
+    dst->isAbstract = src->isAbstract;
+    dst->lifecycleManagement = src->lifecycleManagement;
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+UA_ReferenceTypeNode_copy(const UA_ReferenceTypeNode *src,
+                          UA_ReferenceTypeNode *dst) {
+    UA_StatusCode retval = UA_Node_copyText(&src->inverseName, &dst->inverseName);
+    dst->isAbstract = src->isAbstract;
+    dst->symmetric = src->symmetric;
+    return retval;
+}
+
+static UA_StatusCode
+UA_DataTypeNode_copy(const UA_DataTypeNode *src, UA_DataTypeNode *dst) {
+    dst->isAbstract = src->isAbstract;
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+UA_ViewNode_copy(const UA_ViewNode *src, UA_ViewNode *dst) {
+    dst->containsNoLoops = src->containsNoLoops;
+    dst->eventNotifier = src->eventNotifier;
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode UA_Node_copyAnyNodeClass(const UA_Node *src, UA_Node *dst) {
+    if(src->nodeClass != dst->nodeClass)
+        return UA_STATUSCODE_BADINTERNALERROR;
+    
+    /* copy standard content */
+    UA_StatusCode retval = UA_NodeId_copy(&src->nodeId, &dst->nodeId);
+    dst->nodeClass = src->nodeClass;
+    retval |= UA_QualifiedName_copy(&src->browseName, &dst->browseName);
+    retval |= UA_Node_copyText(&src->displayName, &dst->displayName);
+    retval |= UA_Node_copyText(&src->description, &dst->description);
+    dst->writeMask = src->writeMask;
+    dst->userWriteMask = src->userWriteMask;
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_Node_deleteMembersAnyNodeClass(dst);
+        return retval;
+    }
+    retval |= UA_Array_copy(src->references, src->referencesSize,
+                            (void**)&dst->references,
+                            &UA_TYPES[UA_TYPES_REFERENCENODE]);
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_Node_deleteMembersAnyNodeClass(dst);
+        return retval;
+    }
+    dst->referencesSize = src->referencesSize;
+    dst->referencesCapacity = src->referencesSize;
+    UA_Node_indexReferences(dst, 0);
+    copyReferenceTargetNames(src, dst);
+
+    /* copy unique content of the nodeclass */
+    switch(src->nodeClass) {
+    case UA_NODECLASS_OBJECT:
+        retval = UA_ObjectNode_copy((const UA_ObjectNode*)src,
+                                    (UA_ObjectNode*)dst);
+        break;
+    case UA_NODECLASS_VARIABLE:
+        retval = UA_VariableNode_copy((const UA_VariableNode*)src,
+                                      (UA_VariableNode*)dst);
+        break;
+    case UA_NODECLASS_METHOD:
+        retval = UA_MethodNode_copy((const UA_MethodNode*)src,
+                                    (UA_MethodNode*)dst);
+        break;
+    case UA_NODECLASS_OBJECTTYPE:
+        retval = UA_ObjectTypeNode_copy((const UA_ObjectTypeNode*)src,
+                                        (UA_ObjectTypeNode*)dst);
+        break;
+    case UA_NODECLASS_VARIABLETYPE:
+        retval = UA_VariableTypeNode_copy((const UA_VariableTypeNode*)src,
+                                          (UA_VariableTypeNode*)dst);
+        break;
+    case UA_NODECLASS_REFERENCETYPE:
+        retval = UA_ReferenceTypeNode_copy((const UA_ReferenceTypeNode*)src,
+                                           (UA_ReferenceTypeNode*)dst);
+        break;
+    case UA_NODECLASS_DATATYPE:
+        retval = UA_DataTypeNode_copy((const UA_DataTypeNode*)src,
+                                      (UA_DataTypeNode*)dst);
+        break;
+    case UA_NODECLASS_VIEW:
+        retval = UA_ViewNode_copy((const UA_ViewNode*)src, (UA_ViewNode*)dst);
+        break;
+    default:
+        break;
+    }
+
+    if(retval != UA_STATUSCODE_GOOD)
+        UA_Node_deleteMembersAnyNodeClass(dst);
+
+    return retval;
+}
+
+/*****************/
+/* Memory Report */
+/*****************/
+
+static size_t
+stringHeapSize(const UA_String *s) {
+    if(s->data <= (UA_Byte*)UA_EMPTY_ARRAY_SENTINEL)
+        return 0;
+#ifdef UA_ENABLE_COMPACT_NODES
+    if(isSharedLocale(s))
+        return 0;
+#endif
+    return s->length;
+}
+
+static size_t
+nodeIdHeapSize(const UA_NodeId *id) {
+    if(id->identifierType == UA_NODEIDTYPE_STRING ||
+       id->identifierType == UA_NODEIDTYPE_BYTESTRING)
+        return stringHeapSize(&id->identifier.string);
+    return 0;
+}
+
+static size_t heapSize(const void *p, const UA_DataType *type);
+
+static size_t
+arrayHeapSize(const void *array, size_t length, const UA_DataType *type) {
+    if(array <= UA_EMPTY_ARRAY_SENTINEL)
+        return 0;
+    size_t size = length * type->memSize;
+    if(type->fixedSize)
+        return size;
+    uintptr_t ptr = (uintptr_t)array;
+    for(size_t i = 0; i < length; ++i) {
+        size += heapSize((const void*)ptr, type);
+        ptr += type->memSize;
+    }
+    return size;
+}
+
+static size_t
+variantHeapSize(const UA_Variant *v) {
+    if(v->storageType != UA_VARIANT_DATA || !v->type)
+        return 0;
+    size_t length = v->arrayLength;
+    if(UA_Variant_isScalar(v))
+        length = 1;
+    return arrayHeapSize(v->data, length, v->type) +
+        v->arrayDimensionsSize * sizeof(UA_UInt32);
+}
+
+/* Bytes allocated for the members of a value (not the value itself) */
+static size_t
+heapSize(const void *p, const UA_DataType *type) {
+    if(type->fixedSize)
+        return 0;
+    if(type->builtin) {
+        switch(type->typeIndex) {
+        case UA_TYPES_STRING:
+        case UA_TYPES_BYTESTRING:
+        case UA_TYPES_XMLELEMENT:
+            return stringHeapSize((const UA_String*)p);
+        case UA_TYPES_NODEID:
+            return nodeIdHeapSize((const UA_NodeId*)p);
+        case UA_TYPES_EXPANDEDNODEID: {
+            const UA_ExpandedNodeId *id = (const UA_ExpandedNodeId*)p;
+            return nodeIdHeapSize(&id->nodeId) + stringHeapSize(&id->namespaceUri);
+        }
+        case UA_TYPES_QUALIFIEDNAME:
+            return stringHeapSize(&((const UA_QualifiedName*)p)->name);
+        case UA_TYPES_LOCALIZEDTEXT: {
+            const UA_LocalizedText *lt = (const UA_LocalizedText*)p;
+            return stringHeapSize(&lt->locale) + stringHeapSize(&lt->text);
+        }
+        case UA_TYPES_VARIANT:
+            return variantHeapSize((const UA_Variant*)p);
+        case UA_TYPES_DATAVALUE:
+            return variantHeapSize(&((const UA_DataValue*)p)->value);
+        case UA_TYPES_EXTENSIONOBJECT: {
+            const UA_ExtensionObject *eo = (const UA_ExtensionObject*)p;
+            if(eo->encoding == UA_EXTENSIONOBJECT_DECODED)
+                return eo->content.decoded.type->memSize +
+                    heapSize(eo->content.decoded.data, eo->content.decoded.type);
+            if(eo->encoding == UA_EXTENSIONOBJECT_DECODED_NODELETE)
+                return 0;
+            return nodeIdHeapSize(&eo->content.encoded.typeId) +
+                stringHeapSize(&eo->content.encoded.body);
+        }
+        default:
+            return 0; /* DiagnosticInfo */
+        }
+    }
+
+    /* Structures */
+    size_t size = 0;
+    uintptr_t ptr = (uintptr_t)p;
+    for(size_t i = 0; i < type->membersSize; ++i) {
+        const UA_DataTypeMember *m = &type->members[i];
+        const UA_DataType *typelists[2] = { UA_TYPES, &type[-type->typeIndex] };
+        const UA_DataType *mt = &typelists[!m->namespaceZero][m->memberTypeIndex];
+        ptr += m->padding;
+        if(!m->isArray) {
+            size += heapSize((const void*)ptr, mt);
+            ptr += mt->memSize;
+        } else {
+            size_t length = *(const size_t*)ptr;
+            ptr += sizeof(size_t);
+            size += arrayHeapSize(*(void* const*)ptr, length, mt);
+            ptr += sizeof(void*);
+        }
+    }
+    return size;
+}
+
+static size_t
+nodeClassIndex(UA_NodeClass nodeClass) {
+    size_t i = 0;
+    while(i < UA_NODEMEMORYREPORT_SIZE - 1 && !((UA_UInt32)nodeClass & (1u << i)))
+        ++i;
+    return i;
+}
+
+void
+UA_Node_addToMemoryReport(const UA_Node *node, size_t nodeSize, UA_Boolean readOnly,
+                          UA_NodeMemoryReport *report) {
+    UA_NodeMemoryReport *r = &report[nodeClassIndex(node->nodeClass)];
+    ++r->nodes;
+    if(readOnly) {
+        /* The memory is owned by the image or the program */
+        ++r->readOnlyNodes;
+        return;
+    }
+    r->nodeBytes += nodeSize;
+    r->referencesSize += node->referencesSize;
+    r->referenceBytes += arrayHeapSize(node->references, node->referencesSize,
+                                       &UA_TYPES[UA_TYPES_REFERENCENODE]) +
+        referenceIndexHeapSize(node);
+    if(node->referencesCapacity > node->referencesSize)
+        r->referenceBytes += (node->referencesCapacity - node->referencesSize) *
+            sizeof(UA_ReferenceNode);
+    size_t attr = nodeIdHeapSize(&node->nodeId) +
+        stringHeapSize(&node->browseName.name) +
+        heapSize(&node->displayName, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]) +
+        heapSize(&node->description, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    if(node->encodedAttributes) {
+        attr += sizeof(UA_EncodedAttributes);
+        for(size_t i = 0; i < UA_ATTRIBUTEID_USEREXECUTABLE; ++i) {
+            const UA_ByteString *encoding = node->encodedAttributes->attributes[i];
+            if(encoding)
+                attr += sizeof(UA_ByteString) + encoding->length;
+        }
+    }
+#endif
+    if(node->nodeClass == UA_NODECLASS_VARIABLE ||
+       node->nodeClass == UA_NODECLASS_VARIABLETYPE) {
+        const UA_VariableNode *vn = (const UA_VariableNode*)node;
+        attr += nodeIdHeapSize(&vn->dataType);
+        attr += arrayHeapSize(vn->arrayDimensions, vn->arrayDimensionsSize,
+                              &UA_TYPES[UA_TYPES_INT32]);
+        if(vn->valueSource == UA_VALUESOURCE_DATA)
+            attr += variantHeapSize(&UA_VariableNode_getValue(vn)->value);
+        if(node->nodeClass == UA_NODECLASS_VARIABLE && vn->valueCache)
+            attr += sizeof(struct UA_ValueCache) +
+                variantHeapSize(&vn->valueCache->value.value);
+    } else if(node->nodeClass == UA_NODECLASS_REFERENCETYPE) {
+        attr += heapSize(&((const UA_ReferenceTypeNode*)node)->inverseName,
+                         &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
+    }
+    r->attributeBytes += attr;
+}
+
+/*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_nodestore.c" ***********************************/
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+*  License, v. 2.0. If a copy of the MPL was not distributed with this
+*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
+
+
+#ifndef UA_ENABLE_MULTITHREADING /* conditional compilation */
+
+#define UA_NODESTORE_MINSIZE 64
+
+typedef struct UA_NodeStoreEntry {
+    struct UA_NodeStoreEntry *orig; // the version this is a copy from (or NULL)
+    UA_Node node;
+} UA_NodeStoreEntry;
+
+/* The nodestore is an open-addressing hash-map with linear probing and a
+ * power-of-two size. Next to the array of entry pointers, a parallel array of
+ * control bytes holds a 7-bit fingerprint of the hash of every used slot (or
+ * UA_NODESTORE_EMPTY). Lookups scan the control bytes a group of eight at a
+ * time and only dereference entries whose fingerprint matches. The full hash
+ * of every entry is cached, so resizing does not rehash the NodeIds.
+ *
+ * Removal shifts the following entries of the probe sequence back by one slot
+ * (backward-shift deletion). So there are no tombstones and the probe
+ * sequences stay short after many removals.
+ *
+ * The control array has UA_NODESTORE_GROUP additional bytes at the end that
+ * mirror the first bytes. So a group can be loaded from every position without
+ * wrapping around.
+ *
+ * Resizing is incremental. A new table is allocated and the entries of the old
+ * table are moved over UA_NODESTORE_MIGRATE slots at a time during the
+ * following insertions and removals. So no single operation rehashes the
+ * entire hash-map. Until the migration is complete, lookups search both
+ * tables. Slots of the old table that were migrated or removed keep their
+ * control byte (so the probe sequences stay intact) but have no entry.
+ *
+ * Namespace 0 consists almost entirely of numeric NodeIds from a small and
+ * dense range. They are kept in a directly indexed array in front of the
+ * hash-map. The array grows on demand up to UA_NODESTORE_DENSEMAX entries. */
+
+#define UA_NODESTORE_EMPTY 0x80
+#define UA_NODESTORE_GROUP 8
+#define UA_NODESTORE_MIGRATE 32
+#define UA_NODESTORE_DENSEMIN 256
+#define UA_NODESTORE_DENSEMAX 32768
+
+typedef struct {
+    UA_NodeStoreEntry **entries; /* NULL for empty slots */
+    UA_UInt32 *hashes;
+    UA_Byte *ctrl;
+    UA_UInt32 size; /* always a power of two */
+    UA_UInt32 count; /* entries in the table */
+} UA_NodeStoreTable;
+
+struct UA_NodeStore {
+    UA_NodeStoreTable table;
+
+    /* The previous table during a resize */
+    UA_NodeStoreTable old;
+    UA_UInt32 migrated; /* slots of the old table that were moved */
+
+    /* Numeric ns0 nodes */
+    UA_NodeStoreEntry **dense;
+    UA_UInt32 denseSize;
+
+    /* Nodes loaded from an image or from constant memory are not freed */
+    UA_Byte *image;
+    size_t imageSize;
+    const UA_Byte *constNodes;
+    size_t constNodesSize;
+
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+    /* Table of the lazy nodes that are not yet materialised */
+    const UA_LazyNamespace *lazy;
+#endif
+
+    UA_UInt32 version; /* incremented when an entry is released */
+};
+
+static UA_Boolean
+isDense(const UA_NodeId *nodeid) {
+    return nodeid->namespaceIndex == 0 &&
+        nodeid->identifierType == UA_NODEIDTYPE_NUMERIC &&
+        nodeid->identifier.numeric < UA_NODESTORE_DENSEMAX;
+}
+
+/* Returns the slot in the dense array or NULL if it was not yet allocated */
+static UA_NodeStoreEntry **
+findDense(const UA_NodeStore *ns, const UA_NodeId *nodeid) {
+    if(nodeid->identifier.numeric >= ns->denseSize)
+        return NULL;
+    return &ns->dense[nodeid->identifier.numeric];
+}
+
+static UA_StatusCode
+growDense(UA_NodeStore *ns, UA_UInt32 id) {
+    UA_UInt32 nsize = ns->denseSize;
+    if(nsize < UA_NODESTORE_DENSEMIN)
+        nsize = UA_NODESTORE_DENSEMIN;
+    while(nsize <= id)
+        nsize *= 2;
+    UA_NodeStoreEntry **ndense = UA_realloc(ns->dense, nsize * sizeof(UA_NodeStoreEntry*));
+    if(!ndense)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    memset(&ndense[ns->denseSize], 0, (nsize - ns->denseSize) * sizeof(UA_NodeStoreEntry*));
+    ns->dense = ndense;
+    ns->denseSize = nsize;
+    return UA_STATUSCODE_GOOD;
+}
+
+/* The multiplicative hash of numeric NodeIds has weak low bits. Mix the bits
+ * before masking (finalizer of MurmurHash3). */
+static UA_UInt32
+mixHash(UA_UInt32 h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+static UA_Byte fingerprint(UA_UInt32 h) { return (UA_Byte)(h >> 25); }
+
+/* Byte-parallel operations on a group of control bytes in an integer ("SIMD
+ * within a register"). Byte i of the group is the control byte at position
+ * idx+i. The group is assembled bytewise to be independent of the
+ * endianness. Compilers turn this into a single load. */
+typedef UA_UInt64 UA_NodeStoreGroup;
+#define UA_NODESTORE_LSB 0x0101010101010101ULL
+#define UA_NODESTORE_MSB 0x8080808080808080ULL
+
+static UA_NodeStoreGroup
+loadGroup(const UA_Byte *ctrl) {
+    UA_NodeStoreGroup g = 0;
+    for(size_t i = 0; i < UA_NODESTORE_GROUP; ++i)
+        g |= (UA_NodeStoreGroup)ctrl[i] << (8 * i);
+    return g;
+}
+
+/* Sets the highest bit of every byte that (may) equal the fingerprint. False
+ * positives are possible and filtered out by comparing the cached hash. */
+static UA_NodeStoreGroup
+matchFingerprint(UA_NodeStoreGroup g, UA_Byte fp) {
+    UA_NodeStoreGroup x = g ^ (UA_NODESTORE_LSB * fp);
+    return (x - UA_NODESTORE_LSB) & ~x & UA_NODESTORE_MSB;
+}
+
+/* Sets the highest bit of every empty byte */
+static UA_NodeStoreGroup
+matchEmpty(UA_NodeStoreGroup g) { return g & UA_NODESTORE_MSB; }
+
+/* Position of the byte with the lowest highest-bit set */
+static UA_UInt32
+lowestByte(UA_NodeStoreGroup m) {
+    UA_UInt32 i = 0;
+    while(!(m & 0x80)) {
+        m >>= 8;
+        ++i;
+    }
+    return i;
+}
+
+static void
+setCtrl(UA_NodeStoreTable *t, UA_UInt32 idx, UA_Byte c) {
+    t->ctrl[idx] = c;
+    if(idx < UA_NODESTORE_GROUP)
+        t->ctrl[t->size + idx] = c;
+}
+
+static size_t
+entrySize(UA_NodeClass nodeClass) {
+    size_t size = sizeof(UA_NodeStoreEntry) - sizeof(UA_Node);
+    switch(nodeClass) {
+    case UA_NODECLASS_OBJECT:
+        size += sizeof(UA_ObjectNode);
+        break;
+    case UA_NODECLASS_VARIABLE:
+        size += sizeof(UA_VariableNode);
+        break;
+    case UA_NODECLASS_METHOD:
+        size += sizeof(UA_MethodNode);
+        break;
+    case UA_NODECLASS_OBJECTTYPE:
+        size += sizeof(UA_ObjectTypeNode);
+        break;
+    case UA_NODECLASS_VARIABLETYPE:
+        size += sizeof(UA_VariableTypeNode);
+        break;
+    case UA_NODECLASS_REFERENCETYPE:
+        size += sizeof(UA_ReferenceTypeNode);
+        break;
     case UA_NODECLASS_DATATYPE:
+        size += sizeof(UA_DataTypeNode);
         break;
     case UA_NODECLASS_VIEW:
+        size += sizeof(UA_ViewNode);
         break;
     default:
+        return 0;
+    }
+    return size;
+}
+
+static UA_NodeStoreEntry *
+instantiateEntry(UA_NodeClass nodeClass) {
+    size_t size = entrySize(nodeClass);
+    if(size == 0)
+        return NULL;
+    UA_NodeStoreEntry *entry = UA_calloc(1, size);
+    if(!entry)
+        return NULL;
+    entry->node.nodeClass = nodeClass;
+    return entry;
+}
+
+static void
+deleteEntry(UA_NodeStoreEntry *entry) {
+    UA_Node_deleteMembersAnyNodeClass(&entry->node);
+    UA_free(entry);
+}
+
+static UA_Boolean
+isReadOnlyEntry(const UA_NodeStore *ns, const UA_NodeStoreEntry *entry) {
+    const UA_Byte *p = (const UA_Byte*)entry;
+    if(ns->image && p >= ns->image && p < ns->image + ns->imageSize)
+        return true;
+    return ns->constNodes && p >= ns->constNodes && p < ns->constNodes + ns->constNodesSize;
+}
+
+/* Deletes an entry that was stored in the nodestore. Entries in the image or
+ * in constant memory remain where they are. */
+static void
+releaseEntry(UA_NodeStore *ns, UA_NodeStoreEntry *entry) {
+    ++ns->version;
+    if(!isReadOnlyEntry(ns, entry))
+        deleteEntry(entry);
+}
+
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+
+/* The dense slot of a lazy node that is not yet materialised holds its
+ * position in the table, shifted and tagged with the lowest bit. Entries are
+ * allocated with an alignment that leaves the bit unset. */
+static UA_NodeStoreEntry *
+pendingEntry(size_t pos) {
+    return (UA_NodeStoreEntry*)(((uintptr_t)pos << 1) | 1);
+}
+
+static UA_Boolean
+isPending(const UA_NodeStoreEntry *entry) {
+    return ((uintptr_t)entry & 1) != 0;
+}
+
+/* Points into the table */
+static UA_LocalizedText
+lazyText(const UA_LazyNamespace *lazy, UA_UInt16 name) {
+    UA_LocalizedText text;
+    text.locale = UA_STRING((char*)(uintptr_t)lazy->locale);
+    text.text = UA_STRING((char*)(uintptr_t)&lazy->names[name]);
+    return text;
+}
+
+static UA_StatusCode
+setLazyAttributes(const UA_LazyNamespace *lazy, const UA_LazyNode *ln, UA_Node *node) {
+    node->nodeId = UA_NODEID_NUMERIC(0, ln->id);
+    UA_LocalizedText text = lazyText(lazy, ln->name);
+    UA_StatusCode retval = UA_String_copy(&text.text, &node->browseName.name);
+    retval |= UA_Node_copyText(&text, &node->description);
+#ifdef UA_ENABLE_COMPACT_NODES
+    /* Leave out the text of the DisplayName. It is the same as the BrowseName. */
+    text.text = UA_STRING_NULL;
+#endif
+    retval |= UA_Node_copyText(&text, &node->displayName);
+
+    if(ln->referencesSize > 0) {
+        node->references = UA_Array_new(ln->referencesSize, &UA_TYPES[UA_TYPES_REFERENCENODE]);
+        if(!node->references)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        node->referencesSize = ln->referencesSize;
+        node->referencesCapacity = ln->referencesSize;
+        for(size_t i = 0; i < ln->referencesSize; ++i) {
+            const UA_LazyReference *lr = &lazy->references[ln->references + i];
+            UA_ReferenceNode *ref = &node->references[i];
+            ref->referenceTypeId = UA_NODEID_NUMERIC(0, lr->referenceTypeId);
+            ref->isInverse = lr->isInverse;
+            ref->targetId.nodeId = UA_NODEID_NUMERIC(0, lr->targetId);
+        }
+        UA_Node_indexReferences(node, 0);
+    }
+
+    UA_Boolean isAbstract = (ln->flags & UA_LAZYNODE_ISABSTRACT) != 0;
+    switch(node->nodeClass) {
+    case UA_NODECLASS_OBJECT:
+        ((UA_ObjectNode*)node)->eventNotifier = ln->eventNotifier;
+        break;
+    case UA_NODECLASS_OBJECTTYPE:
+        ((UA_ObjectTypeNode*)node)->isAbstract = isAbstract;
+        break;
+    case UA_NODECLASS_VARIABLETYPE: {
+        UA_VariableTypeNode *vtn = (UA_VariableTypeNode*)node;
+        vtn->dataType = UA_NODEID_NUMERIC(0, ln->dataType);
+        vtn->valueRank = ln->valueRank;
+        vtn->isAbstract = isAbstract;
+        break;
+    }
+    case UA_NODECLASS_REFERENCETYPE: {
+        UA_ReferenceTypeNode *rtn = (UA_ReferenceTypeNode*)node;
+        rtn->isAbstract = isAbstract;
+        rtn->symmetric = (ln->flags & UA_LAZYNODE_SYMMETRIC) != 0;
+        if(ln->inverseName != 0) {
+            UA_LocalizedText inverseName = lazyText(lazy, ln->inverseName);
+            retval |= UA_Node_copyText(&inverseName, &rtn->inverseName);
+        }
+        break;
+    }
+    case UA_NODECLASS_DATATYPE:
+        ((UA_DataTypeNode*)node)->isAbstract = isAbstract;
+        break;
+    case UA_NODECLASS_VIEW:
+        ((UA_ViewNode*)node)->containsNoLoops =
+            (ln->flags & UA_LAZYNODE_CONTAINSNOLOOPS) != 0;
+        ((UA_ViewNode*)node)->eventNotifier = ln->eventNotifier;
         break;
+    default:
+        return UA_STATUSCODE_BADINTERNALERROR;
+    }
+    return retval;
+}
+
+/* Creates the node of a pending slot on the heap and stores it in the slot.
+ * Returns NULL if this fails. The slot remains pending then. */
+static UA_NodeStoreEntry *
+materialize(UA_NodeStore *ns, UA_NodeStoreEntry **slot) {
+    const UA_LazyNode *ln = &ns->lazy->nodes[(uintptr_t)*slot >> 1];
+    UA_NodeStoreEntry *entry = instantiateEntry((UA_NodeClass)ln->nodeClass);
+    if(!entry)
+        return NULL;
+    if(setLazyAttributes(ns->lazy, ln, &entry->node) != UA_STATUSCODE_GOOD) {
+        deleteEntry(entry);
+        return NULL;
+    }
+    *slot = entry;
+    return entry;
+}
+
+#else
+static UA_Boolean isPending(const UA_NodeStoreEntry *entry) { return false; }
+#endif
+
+/* Returns the entry in a non-empty dense slot. Lazy nodes are materialised. */
+static UA_NodeStoreEntry *
+denseEntry(UA_NodeStore *ns, UA_NodeStoreEntry **slot) {
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+    if(isPending(*slot))
+        return materialize(ns, slot);
+#endif
+    return *slot;
+}
+
+/* Allocates the arrays for a table of the given size. All slots are empty. */
+static UA_StatusCode
+allocTable(UA_NodeStoreTable *t, UA_UInt32 size) {
+    UA_NodeStoreEntry **entries = UA_calloc(size, sizeof(UA_NodeStoreEntry*));
+    UA_UInt32 *hashes = UA_malloc(size * sizeof(UA_UInt32));
+    UA_Byte *ctrl = UA_malloc(size + UA_NODESTORE_GROUP);
+    if(!entries || !hashes || !ctrl) {
+        UA_free(entries);
+        UA_free(hashes);
+        UA_free(ctrl);
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    }
+    memset(ctrl, UA_NODESTORE_EMPTY, size + UA_NODESTORE_GROUP);
+    t->entries = entries;
+    t->hashes = hashes;
+    t->ctrl = ctrl;
+    t->size = size;
+    t->count = 0;
+    return UA_STATUSCODE_GOOD;
+}
+
+static void
+deleteTable(UA_NodeStoreTable *t) {
+    UA_free(t->entries);
+    UA_free(t->hashes);
+    UA_free(t->ctrl);
+    memset(t, 0, sizeof(UA_NodeStoreTable));
+}
+
+static UA_UInt32
+hashNodeId(const UA_NodeId *nodeid) {
+    return mixHash(UA_NodeId_hash(nodeid));
+}
+
+/* Returns the index of the node with the hash h or UA_UINT32_MAX */
+static UA_UInt32
+findNode(const UA_NodeStoreTable *t, const UA_NodeId *nodeid, UA_UInt32 h) {
+    if(!t->entries)
+        return UA_UINT32_MAX;
+    UA_Byte fp = fingerprint(h);
+    UA_UInt32 mask = t->size - 1;
+    UA_UInt32 idx = h & mask;
+    while(true) {
+        UA_NodeStoreGroup g = loadGroup(&t->ctrl[idx]);
+        UA_NodeStoreGroup empty = matchEmpty(g);
+        UA_NodeStoreGroup match = matchFingerprint(g, fp);
+        /* Only consider candidates before the first empty slot */
+        if(empty)
+            match &= (empty & (~empty + 1)) - 1;
+        while(match) {
+            UA_UInt32 i = (idx + lowestByte(match)) & mask;
+            if(t->hashes[i] == h && t->entries[i] &&
+               UA_NodeId_equal(&t->entries[i]->node.nodeId, nodeid))
+                return i;
+            match &= match - 1;
+        }
+        if(empty)
+            return UA_UINT32_MAX;
+        idx = (idx + UA_NODESTORE_GROUP) & mask;
+    }
+}
+
+/* Returns the first empty slot of the probe sequence of the hash */
+static UA_UInt32
+findEmptySlot(const UA_NodeStoreTable *t, UA_UInt32 h) {
+    UA_UInt32 mask = t->size - 1;
+    UA_UInt32 idx = h & mask;
+    while(true) {
+        UA_NodeStoreGroup empty = matchEmpty(loadGroup(&t->ctrl[idx]));
+        if(empty)
+            return (idx + lowestByte(empty)) & mask;
+        idx = (idx + UA_NODESTORE_GROUP) & mask;
+    }
+}
+
+static void
+setSlot(UA_NodeStoreTable *t, UA_UInt32 idx, UA_NodeStoreEntry *entry, UA_UInt32 h) {
+    t->entries[idx] = entry;
+    t->hashes[idx] = h;
+    setCtrl(t, idx, fingerprint(h));
+}
+
+/* Remove the entry at idx and shift the following entries of the cluster back
+ * if this brings them closer to their home slot */
+static void
+clearSlot(UA_NodeStoreTable *t, UA_UInt32 idx) {
+    UA_UInt32 mask = t->size - 1;
+    UA_UInt32 hole = idx;
+    for(UA_UInt32 j = (idx + 1) & mask; t->ctrl[j] != UA_NODESTORE_EMPTY; j = (j + 1) & mask) {
+        UA_UInt32 home = t->hashes[j] & mask;
+        /* Can the entry be moved to the hole without leaving its probe
+         * sequence? */
+        if(((j - home) & mask) < ((j - hole) & mask))
+            continue;
+        setSlot(t, hole, t->entries[j], t->hashes[j]);
+        hole = j;
+    }
+    t->entries[hole] = NULL;
+    setCtrl(t, hole, UA_NODESTORE_EMPTY);
+}
+
+/* Moves up to n slots of the old table into the current table. The old table
+ * is freed when all slots are migrated. */
+static void
+migrate(UA_NodeStore *ns, UA_UInt32 n) {
+    if(!ns->old.entries)
+        return;
+    UA_UInt32 end = ns->old.size;
+    if(n < end - ns->migrated)
+        end = ns->migrated + n;
+    for(; ns->migrated < end && ns->old.count > 0; ++ns->migrated) {
+        UA_NodeStoreEntry *entry = ns->old.entries[ns->migrated];
+        if(!entry)
+            continue;
+        UA_UInt32 h = ns->old.hashes[ns->migrated];
+        setSlot(&ns->table, findEmptySlot(&ns->table, h), entry, h);
+        ++ns->table.count;
+        ns->old.entries[ns->migrated] = NULL;
+        --ns->old.count;
+    }
+    if(ns->old.count == 0)
+        deleteTable(&ns->old);
+}
+
+/* Starts the migration to a new table of the given power of two. A running
+ * migration is completed first. The entries are moved with the cached hash. */
+static UA_StatusCode
+resize(UA_NodeStore *ns, UA_UInt32 nsize) {
+    migrate(ns, UA_UINT32_MAX);
+    UA_NodeStoreTable old = ns->table;
+    UA_StatusCode retval = allocTable(&ns->table, nsize);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    ns->old = old;
+    ns->migrated = 0;
+    migrate(ns, UA_NODESTORE_MIGRATE);
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_UInt32
+hashedCount(const UA_NodeStore *ns) {
+    return ns->table.count + ns->old.count;
+}
+
+/* Visits the slots of both tables for i < ns->table.size + ns->old.size.
+ * Returns NULL for empty slots. */
+static UA_NodeStoreEntry *
+entryAt(const UA_NodeStore *ns, UA_UInt32 i) {
+    if(i < ns->table.size)
+        return ns->table.entries[i];
+    return ns->old.entries[i - ns->table.size];
+}
+
+/* Returns the slot holding the node with the hash h in one of the tables or
+ * NULL */
+static UA_NodeStoreEntry **
+findHashed(const UA_NodeStore *ns, const UA_NodeId *nodeid, UA_UInt32 h) {
+    UA_UInt32 idx = findNode(&ns->table, nodeid, h);
+    if(idx != UA_UINT32_MAX)
+        return &ns->table.entries[idx];
+    idx = findNode(&ns->old, nodeid, h);
+    if(idx != UA_UINT32_MAX)
+        return &ns->old.entries[idx];
+    return NULL;
+}
+
+/* Returns the slot holding the node (in the dense array or the hash-map) or
+ * NULL */
+static UA_NodeStoreEntry **
+findSlot(UA_NodeStore *ns, const UA_NodeId *nodeid) {
+    if(isDense(nodeid)) {
+        UA_NodeStoreEntry **slot = findDense(ns, nodeid);
+        if(!slot || !*slot || !denseEntry(ns, slot))
+            return NULL;
+        return slot;
+    }
+    return findHashed(ns, nodeid, hashNodeId(nodeid));
+}
+
+/**********************/
+/* Exported functions */
+/**********************/
+
+UA_NodeStore *
+UA_NodeStore_new(void) {
+    UA_NodeStore *ns = UA_malloc(sizeof(UA_NodeStore));
+    if(!ns)
+        return NULL;
+    memset(&ns->old, 0, sizeof(UA_NodeStoreTable));
+    ns->migrated = 0;
+    ns->dense = NULL;
+    ns->denseSize = 0;
+    ns->image = NULL;
+    ns->imageSize = 0;
+    ns->constNodes = NULL;
+    ns->constNodesSize = 0;
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+    ns->lazy = NULL;
+#endif
+    if(allocTable(&ns->table, UA_NODESTORE_MINSIZE) != UA_STATUSCODE_GOOD) {
+        UA_free(ns);
+        return NULL;
+    }
+    return ns;
+}
+
+void
+UA_NodeStore_delete(UA_NodeStore *ns) {
+    for(UA_UInt32 i = 0; i < ns->table.size + ns->old.size; ++i) {
+        UA_NodeStoreEntry *entry = entryAt(ns, i);
+        if(entry)
+            releaseEntry(ns, entry);
+    }
+    for(UA_UInt32 i = 0; i < ns->denseSize; ++i) {
+        if(ns->dense[i] && !isPending(ns->dense[i]))
+            releaseEntry(ns, ns->dense[i]);
+    }
+    deleteTable(&ns->table);
+    deleteTable(&ns->old);
+    UA_free(ns->dense);
+    UA_free(ns);
+}
+
+UA_Node *
+UA_NodeStore_newNode(UA_NodeClass nodeClass) {
+    UA_NodeStoreEntry *entry = instantiateEntry(nodeClass);
+    if(!entry)
+        return NULL;
+    return &entry->node;
+}
+
+void
+UA_NodeStore_deleteNode(UA_Node *node) {
+    UA_NodeStoreEntry *entry = container_of(node, UA_NodeStoreEntry, node);
+    UA_assert(&entry->node == node);
+    deleteEntry(entry);
+}
+
+UA_StatusCode
+UA_NodeStore_insert(UA_NodeStore *ns, UA_Node *node) {
+    if(isDense(&node->nodeId) && node->nodeId.identifier.numeric != 0) {
+        UA_NodeStoreEntry **slot = findDense(ns, &node->nodeId);
+        if(!slot) {
+            if(growDense(ns, node->nodeId.identifier.numeric) != UA_STATUSCODE_GOOD)
+                return UA_STATUSCODE_BADINTERNALERROR;
+            slot = findDense(ns, &node->nodeId);
+        }
+        if(*slot) {
+            UA_NodeStore_deleteNode(node);
+            return UA_STATUSCODE_BADNODEIDEXISTS;
+        }
+        *slot = container_of(node, UA_NodeStoreEntry, node);
+        return UA_STATUSCODE_GOOD;
+    }
+
+    /* Keep the occupancy below 75% */
+    migrate(ns, UA_NODESTORE_MIGRATE);
+    if((hashedCount(ns) + 1) * 4 > ns->table.size * 3) {
+        if(resize(ns, ns->table.size * 2) != UA_STATUSCODE_GOOD)
+            return UA_STATUSCODE_BADINTERNALERROR;
+    }
+
+    UA_NodeId tempNodeid;
+    tempNodeid = node->nodeId;
+    tempNodeid.namespaceIndex = 0;
+    UA_UInt32 h;
+    if(UA_NodeId_isNull(&tempNodeid)) {
+        /* create a random nodeid */
+        if(node->nodeId.namespaceIndex == 0)
+            node->nodeId.namespaceIndex = 1;
+        UA_UInt32 identifier = hashedCount(ns)+1; // start value
+        UA_UInt32 size = ns->table.size;
+        UA_UInt32 increase = (1 + (identifier % (size - 2))) | 1; /* odd, so all slots are visited */
+        while(true) {
+            node->nodeId.identifier.numeric = identifier;
+            h = hashNodeId(&node->nodeId);
+            if(!findHashed(ns, &node->nodeId, h))
+                break;
+            identifier += increase;
+            if(identifier >= size)
+                identifier -= size;
+        }
+    } else {
+        h = hashNodeId(&node->nodeId);
+        if(findHashed(ns, &node->nodeId, h)) {
+            UA_NodeStore_deleteNode(node);
+            return UA_STATUSCODE_BADNODEIDEXISTS;
+        }
+    }
+
+    UA_NodeStoreEntry *entry = container_of(node, UA_NodeStoreEntry, node);
+    setSlot(&ns->table, findEmptySlot(&ns->table, h), entry, h);
+    ++ns->table.count;
+    UA_assert(&entry->node == node);
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode
+UA_NodeStore_reserve(UA_NodeStore *ns, size_t additional) {
+    /* Keep the occupancy below 75% after inserting */
+    size_t needed = hashedCount(ns) + additional;
+    UA_UInt32 nsize = ns->table.size;
+    while(needed * 4 > (size_t)nsize * 3) {
+        if(nsize >= ((UA_UInt32)1 << 31))
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        nsize *= 2;
+    }
+    if(nsize == ns->table.size)
+        return UA_STATUSCODE_GOOD;
+    return resize(ns, nsize);
+}
+
+void
+UA_NodeStore_insertBatch(UA_NodeStore *ns, UA_Node **nodes, size_t nodesSize,
+                         UA_StatusCode *results) {
+    /* If this fails, the nodestore grows during insert */
+    UA_NodeStore_reserve(ns, nodesSize);
+    for(size_t i = 0; i < nodesSize; ++i)
+        results[i] = UA_NodeStore_insert(ns, nodes[i]);
+}
+
+UA_StatusCode
+UA_NodeStore_replace(UA_NodeStore *ns, UA_Node *node) {
+    UA_NodeStoreEntry **slot = findSlot(ns, &node->nodeId);
+    if(!slot)
+        return UA_STATUSCODE_BADNODEIDUNKNOWN;
+    UA_NodeStoreEntry *newEntry = container_of(node, UA_NodeStoreEntry, node);
+    if(*slot != newEntry->orig) {
+        // the node was replaced since the copy was made
+        deleteEntry(newEntry);
+        return UA_STATUSCODE_BADINTERNALERROR;
+    }
+    releaseEntry(ns, *slot);
+    *slot = newEntry;
+    return UA_STATUSCODE_GOOD;
+}
+
+const UA_Node *
+UA_NodeStore_get(UA_NodeStore *ns, const UA_NodeId *nodeid) {
+    UA_NodeStoreEntry **slot = findSlot(ns, nodeid);
+    if(!slot)
+        return NULL;
+    return (const UA_Node*)&(*slot)->node;
+}
+
+UA_UInt32
+UA_NodeStore_getVersion(const UA_NodeStore *ns) {
+    return ns->version;
+}
+
+UA_UInt32
+UA_NodeStore_hash(const UA_NodeId *nodeid) {
+    return hashNodeId(nodeid);
+}
+
+const UA_Node *
+UA_NodeStore_getHashed(UA_NodeStore *ns, const UA_NodeId *nodeid, UA_UInt32 hash) {
+    if(isDense(nodeid))
+        return UA_NodeStore_get(ns, nodeid);
+    UA_NodeStoreEntry **slot = findHashed(ns, nodeid, hash);
+    if(!slot)
+        return NULL;
+    return (const UA_Node*)&(*slot)->node;
+}
+
+void
+UA_NodeStore_prefetch(UA_NodeStore *ns, const UA_NodeId *nodeid, UA_UInt32 hash,
+                      UA_Boolean entry) {
+    if(isDense(nodeid)) {
+        UA_NodeStoreEntry **slot = findDense(ns, nodeid);
+        if(!slot)
+            return;
+        if(entry)
+            UA_PREFETCH(*slot);
+        else
+            UA_PREFETCH(slot);
+        return;
+    }
+    UA_NodeStoreTable *t = &ns->table;
+    UA_UInt32 mask = t->size - 1;
+    UA_UInt32 idx = hash & mask;
+    if(!entry) {
+        UA_PREFETCH(&t->ctrl[idx]);
+        UA_PREFETCH(&t->hashes[idx]);
+        UA_PREFETCH(&t->entries[idx]);
+        return;
+    }
+    /* Load the first entry with the same hash in the probe sequence. The
+     * entries are not dereferenced. */
+    for(UA_UInt32 i = idx; t->ctrl[i] != UA_NODESTORE_EMPTY; i = (i + 1) & mask) {
+        if(t->hashes[i] == hash && t->entries[i]) {
+            UA_PREFETCH(t->entries[i]);
+            return;
+        }
+    }
+}
+
+UA_Node *
+UA_NodeStore_getCopy(UA_NodeStore *ns, const UA_NodeId *nodeid) {
+    UA_NodeStoreEntry **slot = findSlot(ns, nodeid);
+    if(!slot)
+        return NULL;
+    UA_NodeStoreEntry *entry = *slot;
+    UA_NodeStoreEntry *new = instantiateEntry(entry->node.nodeClass);
+    if(!new)
+        return NULL;
+    if(UA_Node_copyAnyNodeClass(&entry->node, &new->node) != UA_STATUSCODE_GOOD) {
+        deleteEntry(new);
+        return NULL;
+    }
+    /* The copy for editing keeps the value cache of the original */
+    if(new->node.nodeClass == UA_NODECLASS_VARIABLE)
+        UA_VariableNode_shareValueCache((const UA_VariableNode*)&entry->node,
+                                        (UA_VariableNode*)&new->node);
+    new->orig = entry; // store the pointer to the original
+    return &new->node;
+}
+
+UA_StatusCode
+UA_NodeStore_remove(UA_NodeStore *ns, const UA_NodeId *nodeid) {
+    if(isDense(nodeid)) {
+        UA_NodeStoreEntry **slot = findDense(ns, nodeid);
+        if(!slot || !*slot)
+            return UA_STATUSCODE_BADNODEIDUNKNOWN;
+        if(isPending(*slot))
+            ++ns->version;
+        else
+            releaseEntry(ns, *slot);
+        *slot = NULL;
+        return UA_STATUSCODE_GOOD;
+    }
+    migrate(ns, UA_NODESTORE_MIGRATE);
+    UA_UInt32 h = hashNodeId(nodeid);
+    UA_UInt32 idx = findNode(&ns->table, nodeid, h);
+    if(idx != UA_UINT32_MAX) {
+        releaseEntry(ns, ns->table.entries[idx]);
+        clearSlot(&ns->table, idx);
+        --ns->table.count;
+    } else {
+        /* Not yet migrated. The control byte remains. */
+        idx = findNode(&ns->old, nodeid, h);
+        if(idx == UA_UINT32_MAX)
+            return UA_STATUSCODE_BADNODEIDUNKNOWN;
+        releaseEntry(ns, ns->old.entries[idx]);
+        ns->old.entries[idx] = NULL;
+        --ns->old.count;
+    }
+    /* Downsize the hashmap if it is very empty */
+    if(!ns->old.entries && ns->table.count * 8 < ns->table.size &&
+       ns->table.size > UA_NODESTORE_MINSIZE)
+        resize(ns, ns->table.size / 2); // this can fail. we just continue with the bigger hashmap.
+    return UA_STATUSCODE_GOOD;
+}
+
+void
+UA_NodeStore_iterate(UA_NodeStore *ns, UA_NodeStore_nodeVisitor visitor) {
+    for(UA_UInt32 i = 0; i < ns->table.size + ns->old.size; ++i) {
+        UA_NodeStoreEntry *entry = entryAt(ns, i);
+        if(entry)
+            visitor((UA_Node*)&entry->node);
+    }
+    for(UA_UInt32 i = 0; i < ns->denseSize; ++i) {
+        if(ns->dense[i] && denseEntry(ns, &ns->dense[i]))
+            visitor((UA_Node*)&ns->dense[i]->node);
+    }
+}
+
+static void
+addEntryToReport(UA_NodeStore *ns, const UA_NodeStoreEntry *entry,
+                 UA_NodeMemoryReport *report) {
+    UA_Node_addToMemoryReport(&entry->node, entrySize(entry->node.nodeClass),
+                              isReadOnlyEntry(ns, entry), report);
+}
+
+void
+UA_NodeStore_memoryReport(UA_NodeStore *ns, UA_NodeMemoryReport *report) {
+    for(UA_UInt32 i = 0; i < ns->table.size + ns->old.size; ++i) {
+        UA_NodeStoreEntry *entry = entryAt(ns, i);
+        if(entry)
+            addEntryToReport(ns, entry, report);
+    }
+    /* Lazy nodes that are not yet materialised use no memory */
+    for(UA_UInt32 i = 0; i < ns->denseSize; ++i) {
+        if(ns->dense[i] && !isPending(ns->dense[i]))
+            addEntryToReport(ns, ns->dense[i], report);
     }
 }
 
+/***********************/
+/* Address-Space Image */
+/***********************/
+
+/* An image holds the nodes in their in-memory representation. Pointers are
+ * stored as offsets from the start of the image, and a table of all pointer
+ * locations is appended. Loading adds the address of the image to these
+ * locations and sets the pointers to the data types. The nodes are then used
+ * in place.
+ *
+ * Data without pointers (string contents, arrays of scalars) is kept in a
+ * separate section that is not written to during loading. So if the image is
+ * mapped from a file, these pages remain shared with the page cache. Nodes
+ * from the image are never freed. They are copied to the heap before they are
+ * edited (see UA_Server_editNode) and when they are removed, only the slot is
+ * cleared.
+ *
+ * Function pointers and handles (value callbacks, data sources, method
+ * callbacks, instance handles and lifecycle management) cannot be stored and
+ * are reset. They need to be attached again after loading. */
+
+#define UA_NODESTORE_IMAGE_MAGIC 0x474d4955 /* "UIMG" */
+#define UA_NODESTORE_IMAGE_VERSION 1
+#define UA_NODESTORE_IMAGE_BLOB ((UA_UInt64)1 << 63)
+
+typedef struct {
+    UA_UInt32 magic;
+    UA_UInt32 version;
+
+    /* An image can only be loaded by the same build of the library on the
+     * same architecture */
+    UA_UInt32 endianness; /* 0x01020304 */
+    UA_UInt32 pointerSize;
+    UA_UInt32 variableNodeSize;
+    UA_UInt32 typesCount;
+
+    UA_UInt64 size;
+    UA_UInt64 blobsOffset; /* The pointer-free section */
+
+    /* Array of offsets to UA_NodeStoreEntry */
+    UA_UInt64 nodesOffset;
+    UA_UInt64 nodesSize;
+
+    /* Array of UA_String with the namespace uris */
+    UA_UInt64 namespacesOffset;
+    UA_UInt64 namespacesSize;
+
+    /* Array of offsets of the pointers to relocate */
+    UA_UInt64 relocsOffset;
+    UA_UInt64 relocsSize;
+
+    /* Array of data type pointers to set: (offset << 16) | typeIndex */
+    UA_UInt64 typesOffset;
+    UA_UInt64 typesSize;
+} UA_NodeStoreImageHeader;
+
+typedef struct {
+    UA_Byte *structs; /* Starts with the header */
+    size_t structsSize;
+    size_t structsCap;
+    UA_Byte *blobs;
+    size_t blobsSize;
+    size_t blobsCap;
+    UA_UInt64 *relocs;
+    size_t relocsSize;
+    size_t relocsCap;
+    UA_UInt64 *types;
+    size_t typesSize;
+    size_t typesCap;
+} UA_ImageWriter;
+
+static UA_StatusCode
+growBuffer(void **buf, size_t *cap, size_t needed, size_t elemSize) {
+    if(needed <= *cap)
+        return UA_STATUSCODE_GOOD;
+    size_t ncap = *cap > 0 ? *cap : 1024;
+    while(ncap < needed)
+        ncap *= 2;
+    void *nbuf = UA_realloc(*buf, ncap * elemSize);
+    if(!nbuf)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    *buf = nbuf;
+    *cap = ncap;
+    return UA_STATUSCODE_GOOD;
+}
+
+/* Appends zeroed and aligned memory. The memory is only addressed via its
+ * offset, since the buffer may move with the next allocation. */
+static UA_StatusCode
+imageAlloc(UA_ImageWriter *w, UA_Boolean blob, size_t size, size_t *offset) {
+    UA_Byte **buf = blob ? &w->blobs : &w->structs;
+    size_t *bufSize = blob ? &w->blobsSize : &w->structsSize;
+    size_t *bufCap = blob ? &w->blobsCap : &w->structsCap;
+    size_t start = (*bufSize + 7) & ~(size_t)7;
+    UA_StatusCode retval = growBuffer((void**)buf, bufCap, start + size, 1);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    memset(*buf + *bufSize, 0, start + size - *bufSize);
+    *bufSize = start + size;
+    *offset = start;
+    return UA_STATUSCODE_GOOD;
+}
+
+/* Points the pointer at fieldOffset (in the structs) to the target */
 static UA_StatusCode
-UA_ObjectNode_copy(const UA_ObjectNode *src, UA_ObjectNode *dst) {
-    dst->eventNotifier = src->eventNotifier;
-    dst->instanceHandle = src->instanceHandle;
+imageSetPointer(UA_ImageWriter *w, size_t fieldOffset, size_t target, UA_Boolean blob) {
+    UA_StatusCode retval = growBuffer((void**)&w->relocs, &w->relocsCap,
+                                      w->relocsSize + 1, sizeof(UA_UInt64));
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    w->relocs[w->relocsSize++] = (UA_UInt64)fieldOffset | (blob ? UA_NODESTORE_IMAGE_BLOB : 0);
+    uintptr_t value = (uintptr_t)target;
+    memcpy(&w->structs[fieldOffset], &value, sizeof(uintptr_t));
     return UA_STATUSCODE_GOOD;
 }
 
 static UA_StatusCode
-UA_CommonVariableNode_copy(const UA_VariableNode *src, UA_VariableNode *dst) {
-    UA_StatusCode retval = UA_Array_copy(src->arrayDimensions,
-                                         src->arrayDimensionsSize,
-                                         (void**)&dst->arrayDimensions,
-                                         &UA_TYPES[UA_TYPES_INT32]);
+imageSetType(UA_ImageWriter *w, size_t fieldOffset, const UA_DataType *type) {
+    if(type < UA_TYPES || type >= &UA_TYPES[UA_TYPES_COUNT])
+        return UA_STATUSCODE_BADNOTSUPPORTED; /* custom types cannot be stored */
+    UA_StatusCode retval = growBuffer((void**)&w->types, &w->typesCap,
+                                      w->typesSize + 1, sizeof(UA_UInt64));
     if(retval != UA_STATUSCODE_GOOD)
         return retval;
-    dst->arrayDimensionsSize = src->arrayDimensionsSize;
-    retval = UA_NodeId_copy(&src->dataType, &dst->dataType);
-    dst->valueRank = src->valueRank;
-    dst->valueSource = src->valueSource;
-    if(src->valueSource == UA_VALUESOURCE_DATA) {
-        retval |= UA_DataValue_copy(&src->value.data.value,
-                                    &dst->value.data.value);
-        dst->value.data.callback = src->value.data.callback;
-    } else
-        dst->value.dataSource = src->value.dataSource;
-    return retval;
+    w->types[w->typesSize++] = ((UA_UInt64)fieldOffset << 16) | (UA_UInt64)(type - UA_TYPES);
+    memset(&w->structs[fieldOffset], 0, sizeof(const UA_DataType*));
+    return UA_STATUSCODE_GOOD;
 }
 
 static UA_StatusCode
-UA_VariableNode_copy(const UA_VariableNode *src, UA_VariableNode *dst) {
-    UA_StatusCode retval = UA_CommonVariableNode_copy(src, dst);
-    dst->accessLevel = src->accessLevel;
-    dst->userAccessLevel = src->userAccessLevel;
-    dst->minimumSamplingInterval = src->minimumSamplingInterval;
-    dst->historizing = src->historizing;
-    return retval;
-}
+flattenType(UA_ImageWriter *w, size_t offset, const void *src, const UA_DataType *type);
 
+/* Stores a copy of the array and points the pointer at fieldOffset to it */
 static UA_StatusCode
-UA_VariableTypeNode_copy(const UA_VariableTypeNode *src,
-                         UA_VariableTypeNode *dst) {
-    UA_StatusCode retval = UA_CommonVariableNode_copy((const UA_VariableNode*)src,
-                                                      (UA_VariableNode*)dst);
-    dst->isAbstract = src->isAbstract;
-    return retval;
+flattenArray(UA_ImageWriter *w, size_t fieldOffset, const void *src,
+             size_t size, const UA_DataType *type) {
+    if(src <= UA_EMPTY_ARRAY_SENTINEL || size == 0) {
+        void *value = src ? UA_EMPTY_ARRAY_SENTINEL : NULL;
+        memcpy(&w->structs[fieldOffset], &value, sizeof(void*));
+        return UA_STATUSCODE_GOOD;
+    }
+    UA_Boolean blob = type->fixedSize;
+    size_t offset;
+    UA_StatusCode retval = imageAlloc(w, blob, type->memSize * size, &offset);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    memcpy((blob ? w->blobs : w->structs) + offset, src, type->memSize * size);
+    for(size_t i = 0; i < size && !blob; ++i) {
+        retval = flattenType(w, offset + (i * type->memSize),
+                             (const UA_Byte*)src + (i * type->memSize), type);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+    }
+    return imageSetPointer(w, fieldOffset, offset, blob);
 }
 
 static UA_StatusCode
-UA_MethodNode_copy(const UA_MethodNode *src, UA_MethodNode *dst) {
-    dst->executable = src->executable;
-    dst->userExecutable = src->userExecutable;
-    dst->methodHandle  = src->methodHandle;
-    dst->attachedMethod = src->attachedMethod;
-    return UA_STATUSCODE_GOOD;
+flattenString(UA_ImageWriter *w, size_t offset, const UA_String *src) {
+    return flattenArray(w, offset + offsetof(UA_String, data), src->data,
+                        src->length, &UA_TYPES[UA_TYPES_BYTE]);
 }
 
 static UA_StatusCode
-UA_ObjectTypeNode_copy(const UA_ObjectTypeNode *src, UA_ObjectTypeNode *dst) {
-    dst->isAbstract = src->isAbstract;
-    dst->lifecycleManagement = src->lifecycleManagement;
-    return UA_STATUSCODE_GOOD;
+flattenNodeId(UA_ImageWriter *w, size_t offset, const UA_NodeId *src) {
+    if(src->identifierType != UA_NODEIDTYPE_STRING &&
+       src->identifierType != UA_NODEIDTYPE_BYTESTRING)
+        return UA_STATUSCODE_GOOD;
+    return flattenString(w, offset + offsetof(UA_NodeId, identifier.string),
+                         &src->identifier.string);
 }
 
 static UA_StatusCode
-UA_ReferenceTypeNode_copy(const UA_ReferenceTypeNode *src,
-                          UA_ReferenceTypeNode *dst) {
-    UA_StatusCode retval = UA_LocalizedText_copy(&src->inverseName,
-                                                 &dst->inverseName);
-    dst->isAbstract = src->isAbstract;
-    dst->symmetric = src->symmetric;
+flattenVariant(UA_ImageWriter *w, size_t offset, const UA_Variant *src) {
+    /* Image data is never freed */
+    ((UA_Variant*)&w->structs[offset])->storageType = UA_VARIANT_DATA_NODELETE;
+    if(!src->type)
+        return UA_STATUSCODE_GOOD;
+    UA_StatusCode retval = imageSetType(w, offset + offsetof(UA_Variant, type), src->type);
+    size_t length = src->arrayLength;
+    if(length == 0 && src->data > UA_EMPTY_ARRAY_SENTINEL)
+        length = 1; /* scalar */
+    if(retval == UA_STATUSCODE_GOOD)
+        retval = flattenArray(w, offset + offsetof(UA_Variant, data), src->data,
+                              length, src->type);
+    if(retval == UA_STATUSCODE_GOOD)
+        retval = flattenArray(w, offset + offsetof(UA_Variant, arrayDimensions),
+                              src->arrayDimensions, src->arrayDimensionsSize,
+                              &UA_TYPES[UA_TYPES_UINT32]);
     return retval;
 }
 
 static UA_StatusCode
-UA_DataTypeNode_copy(const UA_DataTypeNode *src, UA_DataTypeNode *dst) {
-    dst->isAbstract = src->isAbstract;
-    return UA_STATUSCODE_GOOD;
+flattenExtensionObject(UA_ImageWriter *w, size_t offset, const UA_ExtensionObject *src) {
+    if(src->encoding < UA_EXTENSIONOBJECT_DECODED) {
+        UA_StatusCode retval =
+            flattenNodeId(w, offset + offsetof(UA_ExtensionObject, content.encoded.typeId),
+                          &src->content.encoded.typeId);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+        return flattenString(w, offset + offsetof(UA_ExtensionObject, content.encoded.body),
+                             &src->content.encoded.body);
+    }
+    ((UA_ExtensionObject*)&w->structs[offset])->encoding = UA_EXTENSIONOBJECT_DECODED_NODELETE;
+    UA_StatusCode retval =
+        imageSetType(w, offset + offsetof(UA_ExtensionObject, content.decoded.type),
+                     src->content.decoded.type);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    return flattenArray(w, offset + offsetof(UA_ExtensionObject, content.decoded.data),
+                        src->content.decoded.data, 1, src->content.decoded.type);
 }
 
 static UA_StatusCode
-UA_ViewNode_copy(const UA_ViewNode *src, UA_ViewNode *dst) {
-    dst->containsNoLoops = src->containsNoLoops;
-    dst->eventNotifier = src->eventNotifier;
-    return UA_STATUSCODE_GOOD;
-}
-
-UA_StatusCode UA_Node_copyAnyNodeClass(const UA_Node *src, UA_Node *dst) {
-    if(src->nodeClass != dst->nodeClass)
-        return UA_STATUSCODE_BADINTERNALERROR;
-    
-    /* copy standard content */
-    UA_StatusCode retval = UA_NodeId_copy(&src->nodeId, &dst->nodeId);
-    dst->nodeClass = src->nodeClass;
-    retval |= UA_QualifiedName_copy(&src->browseName, &dst->browseName);
-    retval |= UA_LocalizedText_copy(&src->displayName, &dst->displayName);
-    retval |= UA_LocalizedText_copy(&src->description, &dst->description);
-    dst->writeMask = src->writeMask;
-    dst->userWriteMask = src->userWriteMask;
-    if(retval != UA_STATUSCODE_GOOD) {
-        UA_Node_deleteMembersAnyNodeClass(dst);
-        return retval;
-    }
-    retval |= UA_Array_copy(src->references, src->referencesSize,
-                            (void**)&dst->references,
-                            &UA_TYPES[UA_TYPES_REFERENCENODE]);
-    if(retval != UA_STATUSCODE_GOOD) {
-        UA_Node_deleteMembersAnyNodeClass(dst);
+flattenDiagnosticInfo(UA_ImageWriter *w, size_t offset, const UA_DiagnosticInfo *src) {
+    UA_StatusCode retval =
+        flattenString(w, offset + offsetof(UA_DiagnosticInfo, additionalInfo),
+                      &src->additionalInfo);
+    if(retval != UA_STATUSCODE_GOOD)
         return retval;
+    if(!src->hasInnerDiagnosticInfo || !src->innerDiagnosticInfo) {
+        ((UA_DiagnosticInfo*)&w->structs[offset])->innerDiagnosticInfo = NULL;
+        return UA_STATUSCODE_GOOD;
     }
-    dst->referencesSize = src->referencesSize;
+    return flattenArray(w, offset + offsetof(UA_DiagnosticInfo, innerDiagnosticInfo),
+                        src->innerDiagnosticInfo, 1, &UA_TYPES[UA_TYPES_DIAGNOSTICINFO]);
+}
 
-    /* copy unique content of the nodeclass */
-    switch(src->nodeClass) {
-    case UA_NODECLASS_OBJECT:
-        retval = UA_ObjectNode_copy((const UA_ObjectNode*)src,
-                                    (UA_ObjectNode*)dst);
-        break;
-    case UA_NODECLASS_VARIABLE:
-        retval = UA_VariableNode_copy((const UA_VariableNode*)src,
-                                      (UA_VariableNode*)dst);
-        break;
-    case UA_NODECLASS_METHOD:
-        retval = UA_MethodNode_copy((const UA_MethodNode*)src,
-                                    (UA_MethodNode*)dst);
-        break;
-    case UA_NODECLASS_OBJECTTYPE:
-        retval = UA_ObjectTypeNode_copy((const UA_ObjectTypeNode*)src,
-                                        (UA_ObjectTypeNode*)dst);
-        break;
-    case UA_NODECLASS_VARIABLETYPE:
-        retval = UA_VariableTypeNode_copy((const UA_VariableTypeNode*)src,
-                                          (UA_VariableTypeNode*)dst);
-        break;
-    case UA_NODECLASS_REFERENCETYPE:
-        retval = UA_ReferenceTypeNode_copy((const UA_ReferenceTypeNode*)src,
-                                           (UA_ReferenceTypeNode*)dst);
-        break;
-    case UA_NODECLASS_DATATYPE:
-        retval = UA_DataTypeNode_copy((const UA_DataTypeNode*)src,
-                                      (UA_DataTypeNode*)dst);
-        break;
-    case UA_NODECLASS_VIEW:
-        retval = UA_ViewNode_copy((const UA_ViewNode*)src, (UA_ViewNode*)dst);
-        break;
-    default:
-        break;
+/* The memory at offset already contains a shallow copy of src. Replace the
+ * pointers with pointers into the image. */
+static UA_StatusCode
+flattenType(UA_ImageWriter *w, size_t offset, const void *src, const UA_DataType *type) {
+    if(type->fixedSize)
+        return UA_STATUSCODE_GOOD;
+    if(type->builtin) {
+        switch(type->typeIndex) {
+        case UA_TYPES_STRING:
+        case UA_TYPES_BYTESTRING:
+        case UA_TYPES_XMLELEMENT:
+            return flattenString(w, offset, (const UA_String*)src);
+        case UA_TYPES_NODEID:
+            return flattenNodeId(w, offset, (const UA_NodeId*)src);
+        case UA_TYPES_EXPANDEDNODEID: {
+            const UA_ExpandedNodeId *e = (const UA_ExpandedNodeId*)src;
+            UA_StatusCode retval =
+                flattenNodeId(w, offset + offsetof(UA_ExpandedNodeId, nodeId), &e->nodeId);
+            if(retval != UA_STATUSCODE_GOOD)
+                return retval;
+            return flattenString(w, offset + offsetof(UA_ExpandedNodeId, namespaceUri),
+                                 &e->namespaceUri);
+        }
+        case UA_TYPES_LOCALIZEDTEXT: {
+            const UA_LocalizedText *t = (const UA_LocalizedText*)src;
+            UA_StatusCode retval =
+                flattenString(w, offset + offsetof(UA_LocalizedText, locale), &t->locale);
+            if(retval != UA_STATUSCODE_GOOD)
+                return retval;
+            return flattenString(w, offset + offsetof(UA_LocalizedText, text), &t->text);
+        }
+        case UA_TYPES_EXTENSIONOBJECT:
+            return flattenExtensionObject(w, offset, (const UA_ExtensionObject*)src);
+        case UA_TYPES_DATAVALUE:
+            return flattenVariant(w, offset + offsetof(UA_DataValue, value),
+                                  &((const UA_DataValue*)src)->value);
+        case UA_TYPES_VARIANT:
+            return flattenVariant(w, offset, (const UA_Variant*)src);
+        case UA_TYPES_DIAGNOSTICINFO:
+            return flattenDiagnosticInfo(w, offset, (const UA_DiagnosticInfo*)src);
+        default:
+            break;
+        }
     }
 
-    if(retval != UA_STATUSCODE_GOOD)
-        UA_Node_deleteMembersAnyNodeClass(dst);
-
-    return retval;
+    /* Structured types. Walk the members as in copy_noInit. */
+    size_t ptr = offset;
+    uintptr_t ptrs = (uintptr_t)src;
+    for(size_t i = 0; i < type->membersSize; ++i) {
+        const UA_DataTypeMember *m = &type->members[i];
+        const UA_DataType *typelists[2] = { UA_TYPES, &type[-type->typeIndex] };
+        const UA_DataType *mt = &typelists[!m->namespaceZero][m->memberTypeIndex];
+        ptr += m->padding;
+        ptrs += m->padding;
+        UA_StatusCode retval;
+        if(!m->isArray) {
+            retval = flattenType(w, ptr, (const void*)ptrs, mt);
+            ptr += mt->memSize;
+            ptrs += mt->memSize;
+        } else {
+            size_t size = *(const size_t*)ptrs;
+            ptr += sizeof(size_t);
+            ptrs += sizeof(size_t);
+            retval = flattenArray(w, ptr, *(void* const*)ptrs, size, mt);
+            ptr += sizeof(void*);
+            ptrs += sizeof(void*);
+        }
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+    }
+    return UA_STATUSCODE_GOOD;
 }
 
-/*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_nodestore.c" ***********************************/
-
-/* This Source Code Form is subject to the terms of the Mozilla Public
-*  License, v. 2.0. If a copy of the MPL was not distributed with this
-*  file, You can obtain one at http://mozilla.org/MPL/2.0/.*/
-
-
-#ifndef UA_ENABLE_MULTITHREADING /* conditional compilation */
-
-#define UA_NODESTORE_MINSIZE 64
-
-typedef struct UA_NodeStoreEntry {
-    struct UA_NodeStoreEntry *orig; // the version this is a copy from (or NULL)
-    UA_Node node;
-} UA_NodeStoreEntry;
+#define FLATTEN_MEMBER(NODETYPE, MEMBER, TYPEINDEX)                     \
+    flattenType(w, offset + offsetof(UA_NodeStoreEntry, node) +         \
+                offsetof(NODETYPE, MEMBER), &((const NODETYPE*)node)->MEMBER, \
+                &UA_TYPES[TYPEINDEX])
 
-#define UA_NODESTORE_TOMBSTONE ((UA_NodeStoreEntry*)0x01)
-
-struct UA_NodeStore {
-    UA_NodeStoreEntry **entries;
-    UA_UInt32 size;
-    UA_UInt32 count;
-    UA_UInt32 sizePrimeIndex;
-};
-
-/* The size of the hash-map is always a prime number. They are chosen to be
- * close to the next power of 2. So the size ca. doubles with each prime. */
-static UA_UInt32 const primes[] = {
-    7,         13,         31,         61,         127,         251,
-    509,       1021,       2039,       4093,       8191,        16381,
-    32749,     65521,      131071,     262139,     524287,      1048573,
-    2097143,   4194301,    8388593,    16777213,   33554393,    67108859,
-    134217689, 268435399,  536870909,  1073741789, 2147483647,  4294967291
-};
-
-static UA_UInt32 mod(UA_UInt32 h, UA_UInt32 size) { return h % size; }
-static UA_UInt32 mod2(UA_UInt32 h, UA_UInt32 size) { return 1 + (h % (size - 2)); }
-
-static UA_UInt16
-higher_prime_index(UA_UInt32 n) {
-    UA_UInt16 low  = 0;
-    UA_UInt16 high = (UA_UInt16)(sizeof(primes) / sizeof(UA_UInt32));
-    while(low != high) {
-        UA_UInt16 mid = (UA_UInt16)(low + ((high - low) / 2));
-        if(n > primes[mid])
-            low = (UA_UInt16)(mid + 1);
-        else
-            high = mid;
-    }
-    return low;
-}
+static UA_StatusCode
+flattenNode(UA_ImageWriter *w, const UA_Node *node, size_t *entryOffset) {
+    size_t size = entrySize(node->nodeClass);
+    size_t offset;
+    UA_StatusCode retval = imageAlloc(w, false, size, &offset);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    UA_NodeStoreEntry *entry = (UA_NodeStoreEntry*)&w->structs[offset];
+    memcpy(&entry->node, node, size - offsetof(UA_NodeStoreEntry, node));
+    entry->orig = NULL;
+    entry->node.referenceIndex = NULL;
+    entry->node.referencesCapacity = 0;
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    entry->node.encodedAttributes = NULL;
+#endif
 
-static UA_NodeStoreEntry *
-instantiateEntry(UA_NodeClass nodeClass) {
-    size_t size = sizeof(UA_NodeStoreEntry) - sizeof(UA_Node);
-    switch(nodeClass) {
+    /* Reset the function pointers and handles */
+    switch(node->nodeClass) {
     case UA_NODECLASS_OBJECT:
-        size += sizeof(UA_ObjectNode);
-        break;
-    case UA_NODECLASS_VARIABLE:
-        size += sizeof(UA_VariableNode);
-        break;
-    case UA_NODECLASS_METHOD:
-        size += sizeof(UA_MethodNode);
+        ((UA_ObjectNode*)&entry->node)->instanceHandle = NULL;
         break;
     case UA_NODECLASS_OBJECTTYPE:
-        size += sizeof(UA_ObjectTypeNode);
-        break;
-    case UA_NODECLASS_VARIABLETYPE:
-        size += sizeof(UA_VariableTypeNode);
-        break;
-    case UA_NODECLASS_REFERENCETYPE:
-        size += sizeof(UA_ReferenceTypeNode);
+        memset(&((UA_ObjectTypeNode*)&entry->node)->lifecycleManagement, 0,
+               sizeof(UA_ObjectLifecycleManagement));
         break;
-    case UA_NODECLASS_DATATYPE:
-        size += sizeof(UA_DataTypeNode);
+    case UA_NODECLASS_METHOD:
+        ((UA_MethodNode*)&entry->node)->attachedMethod = NULL;
+        ((UA_MethodNode*)&entry->node)->methodHandle = NULL;
         break;
-    case UA_NODECLASS_VIEW:
-        size += sizeof(UA_ViewNode);
+    case UA_NODECLASS_VARIABLE:
+    case UA_NODECLASS_VARIABLETYPE: {
+        UA_VariableNode *vn = (UA_VariableNode*)&entry->node;
+        if(vn->valueSource == UA_VALUESOURCE_DATA)
+            memset(&vn->value.data.callback, 0, sizeof(UA_ValueCallback));
+        else
+            memset(&vn->value.dataSource, 0, sizeof(UA_DataSource));
+        if(node->nodeClass == UA_NODECLASS_VARIABLE)
+            vn->valueCache = NULL;
         break;
-    default:
-        return NULL;
     }
-    UA_NodeStoreEntry *entry = UA_calloc(1, size);
-    if(!entry)
-        return NULL;
-    entry->node.nodeClass = nodeClass;
-    return entry;
-}
-
-static void
-deleteEntry(UA_NodeStoreEntry *entry) {
-    UA_Node_deleteMembersAnyNodeClass(&entry->node);
-    UA_free(entry);
-}
-
-/* returns slot of a valid node or null */
-static UA_NodeStoreEntry **
-findNode(const UA_NodeStore *ns, const UA_NodeId *nodeid) {
-    UA_UInt32 h = UA_NodeId_hash(nodeid);
-    UA_UInt32 size = ns->size;
-    UA_UInt32 idx = mod(h, size);
-    UA_UInt32 hash2 = mod2(h, size);
-
-    while(true) {
-        UA_NodeStoreEntry *e = ns->entries[idx];
-        if(!e)
-            return NULL;
-        if(e > UA_NODESTORE_TOMBSTONE &&
-           UA_NodeId_equal(&e->node.nodeId, nodeid))
-            return &ns->entries[idx];
-        idx += hash2;
-        if(idx >= size)
-            idx -= size;
+    default:
+        break;
     }
 
-    /* NOTREACHED */
-    return NULL;
-}
-
-/* returns an empty slot or null if the nodeid exists */
-static UA_NodeStoreEntry **
-findSlot(const UA_NodeStore *ns, const UA_NodeId *nodeid) {
-    UA_UInt32 h = UA_NodeId_hash(nodeid);
-    UA_UInt32 size = ns->size;
-    UA_UInt32 idx = mod(h, size);
-    UA_UInt32 hash2 = mod2(h, size);
+    /* Common attributes */
+    retval |= FLATTEN_MEMBER(UA_Node, nodeId, UA_TYPES_NODEID);
+    retval |= FLATTEN_MEMBER(UA_Node, browseName, UA_TYPES_QUALIFIEDNAME);
+    retval |= FLATTEN_MEMBER(UA_Node, displayName, UA_TYPES_LOCALIZEDTEXT);
+    retval |= FLATTEN_MEMBER(UA_Node, description, UA_TYPES_LOCALIZEDTEXT);
+    if(retval == UA_STATUSCODE_GOOD)
+        retval = flattenArray(w, offset + offsetof(UA_NodeStoreEntry, node) +
+                              offsetof(UA_Node, references), node->references,
+                              node->referencesSize, &UA_TYPES[UA_TYPES_REFERENCENODE]);
 
-    while(true) {
-        UA_NodeStoreEntry *e = ns->entries[idx];
-        if(e > UA_NODESTORE_TOMBSTONE &&
-           UA_NodeId_equal(&e->node.nodeId, nodeid))
-            return NULL;
-        if(ns->entries[idx] <= UA_NODESTORE_TOMBSTONE)
-            return &ns->entries[idx];
-        idx += hash2;
-        if(idx >= size)
-            idx -= size;
+    /* Attributes of the node class */
+    switch(node->nodeClass) {
+    case UA_NODECLASS_VARIABLE:
+    case UA_NODECLASS_VARIABLETYPE: {
+        const UA_VariableNode *vn = (const UA_VariableNode*)node;
+        retval |= FLATTEN_MEMBER(UA_VariableNode, dataType, UA_TYPES_NODEID);
+        if(retval == UA_STATUSCODE_GOOD)
+            retval = flattenArray(w, offset + offsetof(UA_NodeStoreEntry, node) +
+                                  offsetof(UA_VariableNode, arrayDimensions),
+                                  vn->arrayDimensions, vn->arrayDimensionsSize,
+                                  &UA_TYPES[UA_TYPES_UINT32]);
+        if(retval == UA_STATUSCODE_GOOD && vn->valueSource == UA_VALUESOURCE_DATA)
+            retval = FLATTEN_MEMBER(UA_VariableNode, value.data.value, UA_TYPES_DATAVALUE);
+        break;
     }
-
-    /* NOTREACHED */
-    return NULL;
+    case UA_NODECLASS_REFERENCETYPE:
+        retval |= FLATTEN_MEMBER(UA_ReferenceTypeNode, inverseName, UA_TYPES_LOCALIZEDTEXT);
+        break;
+    default:
+        break;
+    }
+    *entryOffset = offset;
+    return retval;
 }
 
-/* The occupancy of the table after the call will be about 50% */
 static UA_StatusCode
-expand(UA_NodeStore *ns) {
-    UA_UInt32 osize = ns->size;
-    UA_UInt32 count = ns->count;
-    /* Resize only when table after removal of unused elements is either too
-       full or too empty */
-    if(count * 2 < osize && (count * 8 > osize || osize <= UA_NODESTORE_MINSIZE))
-        return UA_STATUSCODE_GOOD;
-
-    UA_NodeStoreEntry **oentries = ns->entries;
-    UA_UInt32 nindex = higher_prime_index(count * 2);
-    UA_UInt32 nsize = primes[nindex];
-    UA_NodeStoreEntry **nentries = UA_calloc(nsize, sizeof(UA_NodeStoreEntry*));
-    if(!nentries)
-        return UA_STATUSCODE_BADOUTOFMEMORY;
+imageAddNode(UA_ImageWriter *w, UA_UInt64 **nodes, size_t *nodesSize,
+             size_t *nodesCap, const UA_NodeStoreEntry *entry) {
+    UA_StatusCode retval = growBuffer((void**)nodes, nodesCap, *nodesSize + 1,
+                                      sizeof(UA_UInt64));
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    size_t offset;
+    retval = flattenNode(w, &entry->node, &offset);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    (*nodes)[(*nodesSize)++] = offset;
+    return UA_STATUSCODE_GOOD;
+}
 
-    ns->entries = nentries;
-    ns->size = nsize;
-    ns->sizePrimeIndex = nindex;
+UA_StatusCode
+UA_NodeStore_saveImage(UA_NodeStore *ns, const UA_String *namespaces,
+                       size_t namespacesSize, UA_ByteString *image) {
+    UA_ImageWriter w;
+    memset(&w, 0, sizeof(UA_ImageWriter));
+    UA_UInt64 *nodes = NULL;
+    size_t nodesSize = 0, nodesCap = 0;
+
+    /* Reserve the header */
+    size_t offset;
+    UA_StatusCode retval = imageAlloc(&w, false, sizeof(UA_NodeStoreImageHeader), &offset);
+
+    /* Namespaces */
+    size_t namespacesOffset = 0;
+    if(retval == UA_STATUSCODE_GOOD && namespacesSize > 0) {
+        retval = imageAlloc(&w, false, sizeof(UA_String) * namespacesSize, &namespacesOffset);
+        for(size_t i = 0; i < namespacesSize && retval == UA_STATUSCODE_GOOD; ++i) {
+            memcpy(&w.structs[namespacesOffset + (i * sizeof(UA_String))],
+                   &namespaces[i], sizeof(UA_String));
+            retval = flattenString(&w, namespacesOffset + (i * sizeof(UA_String)),
+                                   &namespaces[i]);
+        }
+    }
 
-    /* recompute the position of every entry and insert the pointer */
-    for(size_t i = 0, j = 0; i < osize && j < count; ++i) {
-        if(oentries[i] <= UA_NODESTORE_TOMBSTONE)
+    /* Nodes */
+    for(UA_UInt32 i = 0; i < ns->denseSize && retval == UA_STATUSCODE_GOOD; ++i) {
+        if(!ns->dense[i])
             continue;
-        UA_NodeStoreEntry **e = findSlot(ns, &oentries[i]->node.nodeId);
-        UA_assert(e);
-        *e = oentries[i];
-        ++j;
+        if(!denseEntry(ns, &ns->dense[i]))
+            retval = UA_STATUSCODE_BADOUTOFMEMORY;
+        else
+            retval = imageAddNode(&w, &nodes, &nodesSize, &nodesCap, ns->dense[i]);
     }
+    for(UA_UInt32 i = 0; i < ns->table.size + ns->old.size &&
+            retval == UA_STATUSCODE_GOOD; ++i) {
+        UA_NodeStoreEntry *entry = entryAt(ns, i);
+        if(entry)
+            retval = imageAddNode(&w, &nodes, &nodesSize, &nodesCap, entry);
+    }
+    if(retval != UA_STATUSCODE_GOOD)
+        goto cleanup;
 
-    UA_free(oentries);
-    return UA_STATUSCODE_GOOD;
-}
-
-/**********************/
-/* Exported functions */
-/**********************/
+    /* Layout: header | structs | blobs | relocs | types | nodes */
+    size_t blobsOffset = (w.structsSize + 7) & ~(size_t)7;
+    size_t relocsOffset = (blobsOffset + w.blobsSize + 7) & ~(size_t)7;
+    size_t typesOffset = relocsOffset + (w.relocsSize * sizeof(UA_UInt64));
+    size_t nodesOffset = typesOffset + (w.typesSize * sizeof(UA_UInt64));
+    size_t total = nodesOffset + (nodesSize * sizeof(UA_UInt64));
 
-UA_NodeStore *
-UA_NodeStore_new(void) {
-    UA_NodeStore *ns = UA_malloc(sizeof(UA_NodeStore));
-    if(!ns)
-        return NULL;
-    ns->sizePrimeIndex = higher_prime_index(UA_NODESTORE_MINSIZE);
-    ns->size = primes[ns->sizePrimeIndex];
-    ns->count = 0;
-    ns->entries = UA_calloc(ns->size, sizeof(UA_NodeStoreEntry*));
-    if(!ns->entries) {
-        UA_free(ns);
-        return NULL;
-    }
-    return ns;
-}
+    /* Pointers into the blobs become offsets from the start of the image */
+    for(size_t i = 0; i < w.relocsSize; ++i) {
+        if(!(w.relocs[i] & UA_NODESTORE_IMAGE_BLOB))
+            continue;
+        w.relocs[i] &= ~UA_NODESTORE_IMAGE_BLOB;
+        uintptr_t value;
+        memcpy(&value, &w.structs[w.relocs[i]], sizeof(uintptr_t));
+        value += blobsOffset;
+        memcpy(&w.structs[w.relocs[i]], &value, sizeof(uintptr_t));
+    }
+
+    UA_NodeStoreImageHeader *header = (UA_NodeStoreImageHeader*)w.structs;
+    header->magic = UA_NODESTORE_IMAGE_MAGIC;
+    header->version = UA_NODESTORE_IMAGE_VERSION;
+    header->endianness = 0x01020304;
+    header->pointerSize = (UA_UInt32)sizeof(void*);
+    header->variableNodeSize = (UA_UInt32)sizeof(UA_VariableNode);
+    header->typesCount = UA_TYPES_COUNT;
+    header->size = total;
+    header->blobsOffset = blobsOffset;
+    header->nodesOffset = nodesOffset;
+    header->nodesSize = nodesSize;
+    header->namespacesOffset = namespacesOffset;
+    header->namespacesSize = namespacesSize;
+    header->relocsOffset = relocsOffset;
+    header->relocsSize = w.relocsSize;
+    header->typesOffset = typesOffset;
+    header->typesSize = w.typesSize;
+
+    retval = UA_ByteString_allocBuffer(image, total);
+    if(retval != UA_STATUSCODE_GOOD)
+        goto cleanup;
+    memset(image->data, 0, total);
+    memcpy(image->data, w.structs, w.structsSize);
+    if(w.blobsSize > 0)
+        memcpy(&image->data[blobsOffset], w.blobs, w.blobsSize);
+    if(w.relocsSize > 0)
+        memcpy(&image->data[relocsOffset], w.relocs, w.relocsSize * sizeof(UA_UInt64));
+    if(w.typesSize > 0)
+        memcpy(&image->data[typesOffset], w.types, w.typesSize * sizeof(UA_UInt64));
+    if(nodesSize > 0)
+        memcpy(&image->data[nodesOffset], nodes, nodesSize * sizeof(UA_UInt64));
 
-void
-UA_NodeStore_delete(UA_NodeStore *ns) {
-    UA_UInt32 size = ns->size;
-    UA_NodeStoreEntry **entries = ns->entries;
-    for(UA_UInt32 i = 0; i < size; ++i) {
-        if(entries[i] > UA_NODESTORE_TOMBSTONE)
-            deleteEntry(entries[i]);
-    }
-    UA_free(ns->entries);
-    UA_free(ns);
+ cleanup:
+    UA_free(w.structs);
+    UA_free(w.blobs);
+    UA_free(w.relocs);
+    UA_free(w.types);
+    UA_free(nodes);
+    return retval;
 }
 
-UA_Node *
-UA_NodeStore_newNode(UA_NodeClass nodeClass) {
-    UA_NodeStoreEntry *entry = instantiateEntry(nodeClass);
-    if(!entry)
-        return NULL;
-    return &entry->node;
+static UA_Boolean
+imageRangeValid(size_t imageSize, UA_UInt64 offset, UA_UInt64 count, size_t elemSize) {
+    if(offset > imageSize || count > (imageSize - offset) / elemSize)
+        return false;
+    return (offset % 8) == 0;
 }
 
-void
-UA_NodeStore_deleteNode(UA_Node *node) {
-    UA_NodeStoreEntry *entry = container_of(node, UA_NodeStoreEntry, node);
-    UA_assert(&entry->node == node);
-    deleteEntry(entry);
+/* Inserts a node that is not owned by the nodestore. Nodes with an existing
+ * nodeid are rejected before insert would delete them. */
+static UA_StatusCode
+insertReadOnly(UA_NodeStore *ns, UA_Node *node) {
+    if(UA_NodeStore_get(ns, &node->nodeId))
+        return UA_STATUSCODE_BADNODEIDEXISTS;
+    return UA_NodeStore_insert(ns, node);
 }
 
 UA_StatusCode
-UA_NodeStore_insert(UA_NodeStore *ns, UA_Node *node) {
-    if(ns->size * 3 <= ns->count * 4) {
-        if(expand(ns) != UA_STATUSCODE_GOOD)
-            return UA_STATUSCODE_BADINTERNALERROR;
+UA_NodeStore_loadImage(UA_NodeStore *ns, UA_Byte *image, size_t imageSize,
+                       const UA_String **namespaces, size_t *namespacesSize) {
+    if(hashedCount(ns) > 0 || ns->denseSize > 0 || ns->image)
+        return UA_STATUSCODE_BADINTERNALERROR; /* load only into an empty nodestore */
+
+    /* Check the header */
+    const UA_NodeStoreImageHeader *header = (const UA_NodeStoreImageHeader*)image;
+    if(imageSize < sizeof(UA_NodeStoreImageHeader) || ((uintptr_t)image % 8) != 0)
+        return UA_STATUSCODE_BADDECODINGERROR;
+    if(header->magic != UA_NODESTORE_IMAGE_MAGIC ||
+       header->version != UA_NODESTORE_IMAGE_VERSION ||
+       header->endianness != 0x01020304 ||
+       header->pointerSize != sizeof(void*) ||
+       header->variableNodeSize != sizeof(UA_VariableNode) ||
+       header->typesCount != UA_TYPES_COUNT)
+        return UA_STATUSCODE_BADNOTSUPPORTED;
+    if(header->size != imageSize ||
+       !imageRangeValid(imageSize, header->relocsOffset, header->relocsSize, sizeof(UA_UInt64)) ||
+       !imageRangeValid(imageSize, header->typesOffset, header->typesSize, sizeof(UA_UInt64)) ||
+       !imageRangeValid(imageSize, header->nodesOffset, header->nodesSize, sizeof(UA_UInt64)) ||
+       !imageRangeValid(imageSize, header->namespacesOffset, header->namespacesSize,
+                        sizeof(UA_String)))
+        return UA_STATUSCODE_BADDECODINGERROR;
+
+    /* Relocate the pointers. Only the structs before the blobs are written. */
+    const UA_UInt64 *relocs = (const UA_UInt64*)&image[header->relocsOffset];
+    for(size_t i = 0; i < header->relocsSize; ++i) {
+        if(relocs[i] > header->blobsOffset - sizeof(uintptr_t))
+            return UA_STATUSCODE_BADDECODINGERROR;
+        uintptr_t value;
+        memcpy(&value, &image[relocs[i]], sizeof(uintptr_t));
+        if(value >= imageSize)
+            return UA_STATUSCODE_BADDECODINGERROR;
+        value += (uintptr_t)image;
+        memcpy(&image[relocs[i]], &value, sizeof(uintptr_t));
+    }
+    const UA_UInt64 *types = (const UA_UInt64*)&image[header->typesOffset];
+    for(size_t i = 0; i < header->typesSize; ++i) {
+        UA_UInt64 offset = types[i] >> 16;
+        UA_UInt64 index = types[i] & 0xffff;
+        if(offset > header->blobsOffset - sizeof(void*) || index >= UA_TYPES_COUNT)
+            return UA_STATUSCODE_BADDECODINGERROR;
+        const UA_DataType *type = &UA_TYPES[index];
+        memcpy(&image[offset], &type, sizeof(void*));
     }
 
-    UA_NodeId tempNodeid;
-    tempNodeid = node->nodeId;
-    tempNodeid.namespaceIndex = 0;
-    UA_NodeStoreEntry **entry;
-    if(UA_NodeId_isNull(&tempNodeid)) {
-        /* create a random nodeid */
-        if(node->nodeId.namespaceIndex == 0)
-            node->nodeId.namespaceIndex = 1;
-        UA_UInt32 identifier = ns->count+1; // start value
-        UA_UInt32 size = ns->size;
-        UA_UInt32 increase = mod2(identifier, size);
-        while(true) {
-            node->nodeId.identifier.numeric = identifier;
-            entry = findSlot(ns, &node->nodeId);
-            if(entry)
-                break;
-            identifier += increase;
-            if(identifier >= size)
-                identifier -= size;
-        }
-    } else {
-        entry = findSlot(ns, &node->nodeId);
-        if(!entry) {
-            UA_NodeStore_deleteNode(node);
-            return UA_STATUSCODE_BADNODEIDEXISTS;
-        }
+    /* Insert the nodes. From now on, the nodestore knows not to free them. */
+    ns->image = image;
+    ns->imageSize = imageSize;
+    const UA_UInt64 *nodes = (const UA_UInt64*)&image[header->nodesOffset];
+    for(size_t i = 0; i < header->nodesSize; ++i) {
+        if(nodes[i] > header->blobsOffset - sizeof(UA_NodeStoreEntry))
+            return UA_STATUSCODE_BADDECODINGERROR;
+        UA_NodeStoreEntry *entry = (UA_NodeStoreEntry*)&image[nodes[i]];
+        UA_StatusCode retval = insertReadOnly(ns, &entry->node);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
     }
 
-    *entry = container_of(node, UA_NodeStoreEntry, node);
-    ++ns->count;
-    UA_assert(&(*entry)->node == node);
+    *namespaces = (const UA_String*)&image[header->namespacesOffset];
+    *namespacesSize = header->namespacesSize;
     return UA_STATUSCODE_GOOD;
 }
 
 UA_StatusCode
-UA_NodeStore_replace(UA_NodeStore *ns, UA_Node *node) {
-    UA_NodeStoreEntry **entry = findNode(ns, &node->nodeId);
-    if(!entry)
-        return UA_STATUSCODE_BADNODEIDUNKNOWN;
-    UA_NodeStoreEntry *newEntry = container_of(node, UA_NodeStoreEntry, node);
-    if(*entry != newEntry->orig) {
-        // the node was replaced since the copy was made
-        deleteEntry(newEntry);
+UA_NodeStore_insertConst(UA_NodeStore *ns, const void *nodes, size_t nodesSize,
+                         const UA_Node * const *nodeList, size_t nodeListSize) {
+    if(ns->constNodes)
         return UA_STATUSCODE_BADINTERNALERROR;
+    ns->constNodes = (const UA_Byte*)nodes;
+    ns->constNodesSize = nodesSize;
+    for(size_t i = 0; i < nodeListSize; ++i) {
+        UA_StatusCode retval = insertReadOnly(ns, (UA_Node*)(uintptr_t)nodeList[i]);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
     }
-    deleteEntry(*entry);
-    *entry = newEntry;
     return UA_STATUSCODE_GOOD;
 }
 
-const UA_Node *
-UA_NodeStore_get(UA_NodeStore *ns, const UA_NodeId *nodeid) {
-    UA_NodeStoreEntry **entry = findNode(ns, nodeid);
-    if(!entry)
-        return NULL;
-    return (const UA_Node*)&(*entry)->node;
+UA_Boolean
+UA_NodeStore_isReadOnly(UA_NodeStore *ns, const UA_Node *node) {
+    return isReadOnlyEntry(ns, container_of(node, UA_NodeStoreEntry, node));
 }
 
-UA_Node *
-UA_NodeStore_getCopy(UA_NodeStore *ns, const UA_NodeId *nodeid) {
-    UA_NodeStoreEntry **slot = findNode(ns, nodeid);
-    if(!slot)
-        return NULL;
-    UA_NodeStoreEntry *entry = *slot;
-    UA_NodeStoreEntry *new = instantiateEntry(entry->node.nodeClass);
-    if(!new)
-        return NULL;
-    if(UA_Node_copyAnyNodeClass(&entry->node, &new->node) != UA_STATUSCODE_GOOD) {
-        deleteEntry(new);
-        return NULL;
+#ifdef UA_ENABLE_LAZY_NAMESPACE0
+UA_StatusCode
+UA_NodeStore_insertLazy(UA_NodeStore *ns, const UA_LazyNamespace *lazy) {
+    if(ns->lazy)
+        return UA_STATUSCODE_BADINTERNALERROR;
+
+    /* Grow the dense array once */
+    UA_UInt32 maxId = 0;
+    for(size_t i = 0; i < lazy->nodesSize; ++i) {
+        UA_NodeId id = UA_NODEID_NUMERIC(0, lazy->nodes[i].id);
+        if(id.identifier.numeric == 0 || !isDense(&id))
+            return UA_STATUSCODE_BADINTERNALERROR;
+        if(id.identifier.numeric > maxId)
+            maxId = id.identifier.numeric;
     }
-    new->orig = entry; // store the pointer to the original
-    return &new->node;
-}
+    if(maxId >= ns->denseSize && growDense(ns, maxId) != UA_STATUSCODE_GOOD)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
 
-UA_StatusCode
-UA_NodeStore_remove(UA_NodeStore *ns, const UA_NodeId *nodeid) {
-    UA_NodeStoreEntry **slot = findNode(ns, nodeid);
-    if(!slot)
-        return UA_STATUSCODE_BADNODEIDUNKNOWN;
-    deleteEntry(*slot);
-    *slot = UA_NODESTORE_TOMBSTONE;
-    --ns->count;
-    /* Downsize the hashmap if it is very empty */
-    if(ns->count * 8 < ns->size && ns->size > 32)
-        expand(ns); // this can fail. we just continue with the bigger hashmap.
+    ns->lazy = lazy;
+    for(size_t i = 0; i < lazy->nodesSize; ++i) {
+        UA_NodeStoreEntry **slot = &ns->dense[lazy->nodes[i].id];
+        if(*slot)
+            return UA_STATUSCODE_BADNODEIDEXISTS;
+        *slot = pendingEntry(i);
+    }
     return UA_STATUSCODE_GOOD;
 }
 
-void
-UA_NodeStore_iterate(UA_NodeStore *ns, UA_NodeStore_nodeVisitor visitor) {
-    for(UA_UInt32 i = 0; i < ns->size; ++i) {
-        if(ns->entries[i] > UA_NODESTORE_TOMBSTONE)
-            visitor((UA_Node*)&ns->entries[i]->node);
-    }
-}
+/* Namespace 0 as a table of lazy nodes (generated with gen_namespace0.c) */
+# include "ua_namespace0_lazy.c"
+#endif
+
+#ifdef UA_ENABLE_STATIC_NAMESPACE0
+/* Namespace 0 as constant nodestore entries (generated with gen_namespace0.c) */
+# include "ua_namespace0_static.c"
+#endif
 
 #endif /* UA_ENABLE_MULTITHREADING */
 
@@ -19416,7 +23006,7 @@ struct nodeEntry {
     UA_Node node; ///< Might be cast from any _bigger_ UA_Node* type. Allocate enough memory!
 };
 
-static struct nodeEntry * instantiateEntry(UA_NodeClass class) {
+static size_t entrySize(UA_NodeClass class) {
     size_t size = sizeof(struct nodeEntry) - sizeof(UA_Node);
     switch(class) {
     case UA_NODECLASS_OBJECT:
@@ -19444,8 +23034,15 @@ static struct nodeEntry * instantiateEntry(UA_NodeClass class) {
         size += sizeof(UA_ViewNode);
         break;
     default:
-        return NULL;
+        return 0;
     }
+    return size;
+}
+
+static struct nodeEntry * instantiateEntry(UA_NodeClass class) {
+    size_t size = entrySize(class);
+    if(size == 0)
+        return NULL;
     struct nodeEntry *entry = UA_calloc(1, size);
     if(!entry)
         return NULL;
@@ -19506,6 +23103,13 @@ void UA_NodeStore_deleteNode(UA_Node *node) {
 UA_StatusCode UA_NodeStore_insert(UA_NodeStore *ns, UA_Node *node) {
     UA_ASSERT_RCU_LOCKED();
     struct nodeEntry *entry = container_of(node, struct nodeEntry, node);
+    /* Attach the value slot before the node becomes visible */
+    if(node->nodeClass == UA_NODECLASS_VARIABLE && !((UA_VariableNode*)node)->valueSlot) {
+        if(UA_VariableNode_initValueSlot((UA_VariableNode*)node) != UA_STATUSCODE_GOOD) {
+            deleteEntry(&entry->rcu_head);
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        }
+    }
     struct cds_lfht *ht = (struct cds_lfht*)ns;
     cds_lfht_node_init(&entry->htn);
     struct cds_lfht_node *result;
@@ -19600,6 +23204,27 @@ const UA_Node * UA_NodeStore_get(UA_NodeStore *ns, const UA_NodeId *nodeid) {
     return &found_entry->node;
 }
 
+UA_UInt32 UA_NodeStore_hash(const UA_NodeId *nodeid) {
+    return UA_NodeId_hash(nodeid);
+}
+
+void UA_NodeStore_prefetch(UA_NodeStore *ns, const UA_NodeId *nodeid, UA_UInt32 hash,
+                           UA_Boolean entry) {
+    /* The buckets of the lock-free hash map are not exposed */
+}
+
+const UA_Node * UA_NodeStore_getHashed(UA_NodeStore *ns, const UA_NodeId *nodeid,
+                                       UA_UInt32 hash) {
+    UA_ASSERT_RCU_LOCKED();
+    struct cds_lfht *ht = (struct cds_lfht*)ns;
+    struct cds_lfht_iter iter;
+    cds_lfht_lookup(ht, hash, compare, nodeid, &iter);
+    struct nodeEntry *found_entry = (struct nodeEntry*)iter.node;
+    if(!found_entry)
+        return NULL;
+    return &found_entry->node;
+}
+
 UA_Node * UA_NodeStore_getCopy(UA_NodeStore *ns, const UA_NodeId *nodeid) {
     UA_ASSERT_RCU_LOCKED();
     struct cds_lfht *ht = (struct cds_lfht*)ns;
@@ -19616,10 +23241,30 @@ UA_Node * UA_NodeStore_getCopy(UA_NodeStore *ns, const UA_NodeId *nodeid) {
         deleteEntry(&new->rcu_head);
         return NULL;
     }
+    /* The copy writes values to the slot of the original and shares the
+     * value cache */
+    if(new->node.nodeClass == UA_NODECLASS_VARIABLE) {
+        UA_VariableNode_shareValueSlot((const UA_VariableNode*)&entry->node,
+                                       (UA_VariableNode*)&new->node);
+        UA_VariableNode_shareValueCache((const UA_VariableNode*)&entry->node,
+                                        (UA_VariableNode*)&new->node);
+    }
     new->orig = entry;
     return &new->node;
 }
 
+UA_StatusCode UA_NodeStore_reserve(UA_NodeStore *ns, size_t additional) {
+    /* The lock-free hash map resizes itself in the background */
+    return UA_STATUSCODE_GOOD;
+}
+
+void UA_NodeStore_insertBatch(UA_NodeStore *ns, UA_Node **nodes, size_t nodesSize,
+                              UA_StatusCode *results) {
+    UA_ASSERT_RCU_LOCKED();
+    for(size_t i = 0; i < nodesSize; ++i)
+        results[i] = UA_NodeStore_insert(ns, nodes[i]);
+}
+
 void UA_NodeStore_iterate(UA_NodeStore *ns, UA_NodeStore_nodeVisitor visitor) {
     UA_ASSERT_RCU_LOCKED();
     struct cds_lfht *ht = (struct cds_lfht*)ns;
@@ -19632,6 +23277,20 @@ void UA_NodeStore_iterate(UA_NodeStore *ns, UA_NodeStore_nodeVisitor visitor) {
     }
 }
 
+void UA_NodeStore_memoryReport(UA_NodeStore *ns, UA_NodeMemoryReport *report) {
+    UA_ASSERT_RCU_LOCKED();
+    struct cds_lfht *ht = (struct cds_lfht*)ns;
+    struct cds_lfht_iter iter;
+    cds_lfht_first(ht, &iter);
+    while(iter.node != NULL) {
+        struct nodeEntry *found_entry = (struct nodeEntry*)iter.node;
+        UA_Node_addToMemoryReport(&found_entry->node,
+                                  entrySize(found_entry->node.nodeClass),
+                                  false, report);
+        cds_lfht_next(ht, &iter);
+    }
+}
+
 #endif /* UA_ENABLE_MULTITHREADING */
 
 /*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_services_discovery.c" ***********************************/
@@ -19720,42 +23379,260 @@ void Service_GetEndpoints(UA_Server *server, UA_Session *session, const UA_GetEn
         return;
     }
 
-    /* Clone the endpoint for each networklayer? */
-    size_t clone_times = 1;
-    UA_Boolean nl_endpointurl = false;
-    if(endpointUrl->length == 0) {
-        clone_times = server->config.networkLayersSize;
-        nl_endpointurl = true;
+    /* Clone the endpoint for each networklayer? */
+    size_t clone_times = 1;
+    UA_Boolean nl_endpointurl = false;
+    if(endpointUrl->length == 0) {
+        clone_times = server->config.networkLayersSize;
+        nl_endpointurl = true;
+    }
+
+    response->endpoints = UA_Array_new(relevant_count * clone_times, &UA_TYPES[UA_TYPES_ENDPOINTDESCRIPTION]);
+    if(!response->endpoints) {
+        response->responseHeader.serviceResult = UA_STATUSCODE_BADOUTOFMEMORY;
+        return;
+    }
+    response->endpointsSize = relevant_count * clone_times;
+
+    size_t k = 0;
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    for(size_t i = 0; i < clone_times; ++i) {
+        if(nl_endpointurl)
+            endpointUrl = &server->config.networkLayers[i].discoveryUrl;
+        for(size_t j = 0; j < server->endpointDescriptionsSize; ++j) {
+            if(!relevant_endpoints[j])
+                continue;
+            retval |= UA_EndpointDescription_copy(&server->endpointDescriptions[j], &response->endpoints[k]);
+            retval |= UA_String_copy(endpointUrl, &response->endpoints[k].endpointUrl);
+            ++k;
+        }
+    }
+
+    if(retval != UA_STATUSCODE_GOOD) {
+        response->responseHeader.serviceResult = retval;
+        UA_Array_delete(response->endpoints, response->endpointsSize, &UA_TYPES[UA_TYPES_ENDPOINTDESCRIPTION]);
+        response->endpoints = NULL;
+        response->endpointsSize = 0;
+        return;
+    }
+}
+
+/*******************/
+/* Discovery Cache */
+/*******************/
+
+static UA_Boolean
+stringArraysEqual(size_t aSize, const UA_String *a, size_t bSize, const UA_String *b) {
+    if(aSize != bSize)
+        return false;
+    for(size_t i = 0; i < aSize; ++i) {
+        if(!UA_String_equal(&a[i], &b[i]))
+            return false;
+    }
+    return true;
+}
+
+static void
+deleteDiscoveryResponse(UA_DiscoveryResponse *dr) {
+    UA_String_deleteMembers(&dr->endpointUrl);
+    UA_Array_delete(dr->localeIds, dr->localeIdsSize, &UA_TYPES[UA_TYPES_STRING]);
+    UA_Array_delete(dr->uris, dr->urisSize, &UA_TYPES[UA_TYPES_STRING]);
+    UA_ByteString_deleteMembers(&dr->body);
+    memset(dr, 0, sizeof(UA_DiscoveryResponse));
+}
+
+void
+clearDiscoveryCache(UA_Server *server) {
+    UA_DiscoveryCache *cache = &server->discoveryCache;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    for(size_t i = 0; i < cache->responsesSize; ++i)
+        deleteDiscoveryResponse(&cache->responses[i]);
+    cache->responsesSize = 0;
+    cache->next = 0;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+}
+
+/* The key of the cache is taken from the request. Points into the request. */
+static void
+discoveryResponseKey(const UA_DataType *requestType, const void *request,
+                     UA_DiscoveryResponse *key) {
+    memset(key, 0, sizeof(UA_DiscoveryResponse));
+    key->requestType = requestType;
+    if(requestType == &UA_TYPES[UA_TYPES_GETENDPOINTSREQUEST]) {
+        const UA_GetEndpointsRequest *req = (const UA_GetEndpointsRequest*)request;
+        key->endpointUrl = req->endpointUrl;
+        key->localeIdsSize = req->localeIdsSize;
+        key->localeIds = req->localeIds;
+        key->urisSize = req->profileUrisSize;
+        key->uris = req->profileUris;
+    } else {
+        const UA_FindServersRequest *req = (const UA_FindServersRequest*)request;
+        key->endpointUrl = req->endpointUrl;
+        key->localeIdsSize = req->localeIdsSize;
+        key->localeIds = req->localeIds;
+        key->urisSize = req->serverUrisSize;
+        key->uris = req->serverUris;
+    }
+}
+
+static UA_DiscoveryResponse *
+findDiscoveryResponse(UA_DiscoveryCache *cache, const UA_DiscoveryResponse *key) {
+    for(size_t i = 0; i < cache->responsesSize; ++i) {
+        UA_DiscoveryResponse *dr = &cache->responses[i];
+        if(dr->requestType == key->requestType &&
+           UA_String_equal(&dr->endpointUrl, &key->endpointUrl) &&
+           stringArraysEqual(dr->localeIdsSize, dr->localeIds,
+                             key->localeIdsSize, key->localeIds) &&
+           stringArraysEqual(dr->urisSize, dr->uris, key->urisSize, key->uris))
+            return dr;
+    }
+    return NULL;
+}
+
+/* Copies the key and the body into the cache. Replaces the oldest entry if the
+ * cache is full. */
+static void
+insertDiscoveryResponse(UA_DiscoveryCache *cache, const UA_DiscoveryResponse *key,
+                        const UA_ByteString *body) {
+    UA_DiscoveryResponse *dr;
+    if(cache->responsesSize < UA_DISCOVERYCACHE_SIZE) {
+        dr = &cache->responses[cache->responsesSize];
+    } else {
+        dr = &cache->responses[cache->next];
+        deleteDiscoveryResponse(dr);
+        cache->next = (cache->next + 1) % UA_DISCOVERYCACHE_SIZE;
+    }
+    dr->requestType = key->requestType;
+    UA_StatusCode retval = UA_String_copy(&key->endpointUrl, &dr->endpointUrl);
+    retval |= UA_Array_copy(key->localeIds, key->localeIdsSize, (void**)&dr->localeIds,
+                            &UA_TYPES[UA_TYPES_STRING]);
+    if(retval == UA_STATUSCODE_GOOD)
+        dr->localeIdsSize = key->localeIdsSize;
+    retval |= UA_Array_copy(key->uris, key->urisSize, (void**)&dr->uris,
+                            &UA_TYPES[UA_TYPES_STRING]);
+    if(retval == UA_STATUSCODE_GOOD)
+        dr->urisSize = key->urisSize;
+    retval |= UA_ByteString_copy(body, &dr->body);
+    if(retval != UA_STATUSCODE_GOOD) {
+        deleteDiscoveryResponse(dr);
+        return;
+    }
+    if(dr == &cache->responses[cache->responsesSize])
+        ++cache->responsesSize;
+}
+
+/* Encodes the response without the ResponseHeader */
+static UA_StatusCode
+encodeResponseBody(const void *response, const UA_DataType *responseType,
+                   UA_ByteString *body) {
+    size_t headerSize = UA_calcSizeBinary((void*)(uintptr_t)response,
+                                          &UA_TYPES[UA_TYPES_RESPONSEHEADER]);
+    size_t size = UA_calcSizeBinary((void*)(uintptr_t)response, responseType);
+    UA_StatusCode retval = UA_ByteString_allocBuffer(body, size);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    size_t offset = 0;
+    retval = UA_encodeBinary(response, responseType, NULL, NULL, body, &offset);
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_ByteString_deleteMembers(body);
+        return retval;
     }
+    memmove(body->data, &body->data[headerSize], size - headerSize);
+    body->length = size - headerSize;
+    return UA_STATUSCODE_GOOD;
+}
 
-    response->endpoints = UA_Array_new(relevant_count * clone_times, &UA_TYPES[UA_TYPES_ENDPOINTDESCRIPTION]);
-    if(!response->endpoints) {
-        response->responseHeader.serviceResult = UA_STATUSCODE_BADOUTOFMEMORY;
-        return;
+void
+sendDiscoveryResponse(UA_Server *server, UA_Session *session,
+                      UA_SecureChannel *channel, UA_UInt32 requestId,
+                      const UA_DataType *requestType, const void *request) {
+    UA_DiscoveryCache *cache = &server->discoveryCache;
+    UA_DiscoveryResponse key;
+    discoveryResponseKey(requestType, request, &key);
+    const UA_DataType *responseType = &UA_TYPES[UA_TYPES_GETENDPOINTSRESPONSE];
+    if(requestType == &UA_TYPES[UA_TYPES_FINDSERVERSREQUEST])
+        responseType = &UA_TYPES[UA_TYPES_FINDSERVERSRESPONSE];
+
+    /* Look up the encoded response. With multithreading, the entry may be
+     * replaced after the lock is released. So the body is copied. */
+    UA_ByteString body;
+    UA_ByteString_init(&body);
+    UA_Boolean cached = false;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    UA_DiscoveryResponse *dr = findDiscoveryResponse(cache, &key);
+    if(dr) {
+#ifdef UA_ENABLE_MULTITHREADING
+        cached = (UA_ByteString_copy(&dr->body, &body) == UA_STATUSCODE_GOOD);
+#else
+        body = dr->body;
+        cached = true;
+#endif
     }
-    response->endpointsSize = relevant_count * clone_times;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
 
-    size_t k = 0;
-    UA_StatusCode retval = UA_STATUSCODE_GOOD;
-    for(size_t i = 0; i < clone_times; ++i) {
-        if(nl_endpointurl)
-            endpointUrl = &server->config.networkLayers[i].discoveryUrl;
-        for(size_t j = 0; j < server->endpointDescriptionsSize; ++j) {
-            if(!relevant_endpoints[j])
-                continue;
-            retval |= UA_EndpointDescription_copy(&server->endpointDescriptions[j], &response->endpoints[k]);
-            retval |= UA_String_copy(endpointUrl, &response->endpoints[k].endpointUrl);
-            ++k;
+    UA_ResponseHeader responseHeader;
+    UA_ResponseHeader_init(&responseHeader);
+    responseHeader.requestHandle = ((const UA_RequestHeader*)request)->requestHandle;
+    UA_StatusCode retval;
+    if(!cached) {
+        /* Call the service */
+        void *response = UA_alloca(responseType->memSize);
+        UA_init(response, responseType);
+        if(requestType == &UA_TYPES[UA_TYPES_GETENDPOINTSREQUEST])
+            Service_GetEndpoints(server, session, (const UA_GetEndpointsRequest*)request,
+                                 (UA_GetEndpointsResponse*)response);
+        else
+            Service_FindServers(server, session, (const UA_FindServersRequest*)request,
+                                (UA_FindServersResponse*)response);
+
+        /* Encode and cache the successful response. Otherwise send the
+         * response as usual. */
+        UA_ResponseHeader *rh = (UA_ResponseHeader*)response;
+        retval = rh->serviceResult;
+        if(retval == UA_STATUSCODE_GOOD)
+            retval = encodeResponseBody(response, responseType, &body);
+        if(retval == UA_STATUSCODE_GOOD) {
+#ifdef UA_ENABLE_MULTITHREADING
+            pthread_mutex_lock(&cache->mutex);
+#endif
+            if(!findDiscoveryResponse(cache, &key))
+                insertDiscoveryResponse(cache, &key, &body);
+#ifdef UA_ENABLE_MULTITHREADING
+            pthread_mutex_unlock(&cache->mutex);
+#endif
+        } else {
+            rh->requestHandle = responseHeader.requestHandle;
+            rh->timestamp = UA_DateTime_now();
+            retval = UA_SecureChannel_sendBinaryMessage(channel, requestId,
+                                                        response, responseType);
+            UA_deleteMembers(response, responseType);
+            goto finish;
         }
+        UA_deleteMembers(response, responseType);
     }
 
-    if(retval != UA_STATUSCODE_GOOD) {
-        response->responseHeader.serviceResult = retval;
-        UA_Array_delete(response->endpoints, response->endpointsSize, &UA_TYPES[UA_TYPES_ENDPOINTDESCRIPTION]);
-        response->endpoints = NULL;
-        response->endpointsSize = 0;
-        return;
-    }
+    /* Send the encoded response */
+    responseHeader.timestamp = UA_DateTime_now();
+    retval = UA_SecureChannel_sendEncodedResponse(channel, requestId, responseType,
+                                                  &responseHeader, &body);
+#ifndef UA_ENABLE_MULTITHREADING
+    if(!cached)
+#endif
+        UA_ByteString_deleteMembers(&body);
+
+ finish:
+    if(retval != UA_STATUSCODE_GOOD)
+        UA_LOG_INFO_CHANNEL(server->config.logger, channel,
+                            "Could not send the message over the SecureChannel "
+                            "with StatusCode %s", UA_StatusCode_name(retval));
 }
 
 /*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_services_securechannel.c" ***********************************/
@@ -20124,8 +24001,7 @@ typeCheckValue(UA_Server *server, const UA_NodeId *targetDataTypeId,
         goto check_array;
 
     /* Has the value a subtype of the required type? */
-    const UA_NodeId subtypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE);
-    if(isNodeInTree(server->nodestore, &value->type->typeId, targetDataTypeId, &subtypeId, 1))
+    if(isSubtypeOf(server, &value->type->typeId, targetDataTypeId))
         goto check_array;
 
     /* Try to convert to a matching value if this is wanted */
@@ -20330,9 +24206,7 @@ writeDataTypeAttribute(UA_Server *server, UA_VariableNode *node,
         return UA_STATUSCODE_BADINTERNALERROR;
 
     /* Does the new type match the constraints of the variabletype? */
-    UA_NodeId subtypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASSUBTYPE);
-    if(!isNodeInTree(server->nodestore, dataType,
-                     constraintDataType, &subtypeId, 1))
+    if(!isSubtypeOf(server, dataType, constraintDataType))
         return UA_STATUSCODE_BADTYPEMISMATCH;
 
     /* Check if the current value would match the new type */
@@ -20373,34 +24247,78 @@ readValueAttributeFromNode(UA_Server *server, const UA_VariableNode *vn, UA_Data
                            UA_NumericRange *rangeptr) {
     if(vn->value.data.callback.onRead) {
         UA_RCU_UNLOCK();
-        vn->value.data.callback.onRead(vn->value.data.callback.handle,
-                                       vn->nodeId, &vn->value.data.value.value, rangeptr);
+        vn->value.data.callback.onRead(vn->value.data.callback.handle, vn->nodeId,
+                                       &UA_VariableNode_getValue(vn)->value, rangeptr);
         UA_RCU_LOCK();
 #ifdef UA_ENABLE_MULTITHREADING
         /* Reopen the node to see the changes (multithreading only) */
         vn = (const UA_VariableNode*)UA_NodeStore_get(server->nodestore, &vn->nodeId);
 #endif
     }
+    const UA_DataValue *value = UA_VariableNode_getValue(vn);
     if(rangeptr)
-        return UA_Variant_copyRange(&vn->value.data.value.value, &v->value, *rangeptr);
-    *v = vn->value.data.value;
+        return UA_Variant_copyRange(&value->value, &v->value, *rangeptr);
+    *v = *value;
     v->value.storageType = UA_VARIANT_DATA_NODELETE;
     return UA_STATUSCODE_GOOD;
 }
 
+/* Reads the full value from the data source and caches it. The requested
+ * range is copied from the full value. */
+static UA_StatusCode
+readValueAttributeToCache(const UA_VariableNode *vn, UA_DataValue *v,
+                          UA_NumericRange *rangeptr) {
+    /* The node may be replaced while the lock is released */
+    struct UA_ValueCache *cache = UA_ValueCache_retain(vn->valueCache);
+    UA_DataValue full;
+    UA_DataValue_init(&full);
+    UA_DateTime readTime = UA_DateTime_nowMonotonic();
+    UA_RCU_UNLOCK();
+    UA_StatusCode retval =
+        vn->value.dataSource.read(vn->value.dataSource.handle, vn->nodeId,
+                                  true, NULL, &full);
+    UA_RCU_LOCK();
+    if(retval == UA_STATUSCODE_GOOD) {
+        UA_ValueCache_update(cache, &full, readTime);
+        if(rangeptr) {
+            retval = UA_Variant_copyRange(&full.value, &v->value, *rangeptr);
+            UA_Variant_deleteMembers(&full.value);
+            UA_Variant_init(&full.value);
+            if(retval == UA_STATUSCODE_GOOD) {
+                UA_Variant range = v->value;
+                *v = full;
+                v->value = range;
+            } else {
+                UA_DataValue_deleteMembers(&full);
+            }
+        } else {
+            *v = full;
+        }
+    }
+    UA_ValueCache_release(cache);
+    return retval;
+}
+
 static UA_StatusCode
 readValueAttributeFromDataSource(const UA_VariableNode *vn, UA_DataValue *v,
                                  UA_TimestampsToReturn timestamps,
-                                 UA_NumericRange *rangeptr) {
+                                 UA_NumericRange *rangeptr, UA_Double maxAge) {
     if(!vn->value.dataSource.read)
         return UA_STATUSCODE_BADINTERNALERROR;
     UA_Boolean sourceTimeStamp = (timestamps == UA_TIMESTAMPSTORETURN_SOURCE ||
                                   timestamps == UA_TIMESTAMPSTORETURN_BOTH);
 
+    /* Use the cache if the request accepts older values */
+    UA_StatusCode retval;
+    if(maxAge > 0.0 && vn->nodeClass == UA_NODECLASS_VARIABLE && vn->valueCache) {
+        if(UA_ValueCache_read(vn->valueCache, maxAge, rangeptr, v, &retval))
+            return retval;
+        return readValueAttributeToCache(vn, v, rangeptr);
+    }
+
     UA_RCU_UNLOCK();
-    UA_StatusCode retval =
-        vn->value.dataSource.read(vn->value.dataSource.handle, vn->nodeId,
-                                  sourceTimeStamp, rangeptr, v);
+    retval = vn->value.dataSource.read(vn->value.dataSource.handle, vn->nodeId,
+                                       sourceTimeStamp, rangeptr, v);
     UA_RCU_LOCK();
     return retval;
 }
@@ -20408,7 +24326,7 @@ readValueAttributeFromDataSource(const UA_VariableNode *vn, UA_DataValue *v,
 static UA_StatusCode
 readValueAttributeComplete(UA_Server *server, const UA_VariableNode *vn,
                            UA_TimestampsToReturn timestamps, const UA_String *indexRange,
-                           UA_DataValue *v) {
+                           UA_Double maxAge, UA_DataValue *v) {
     /* Compute the index range */
     UA_NumericRange range;
     UA_NumericRange *rangeptr = NULL;
@@ -20424,7 +24342,7 @@ readValueAttributeComplete(UA_Server *server, const UA_VariableNode *vn,
     if(vn->valueSource == UA_VALUESOURCE_DATA)
         retval = readValueAttributeFromNode(server, vn, v, rangeptr);
     else
-        retval = readValueAttributeFromDataSource(vn, v, timestamps, rangeptr);
+        retval = readValueAttributeFromDataSource(vn, v, timestamps, rangeptr, maxAge);
 
     /* Clean up */
     if(rangeptr)
@@ -20434,26 +24352,91 @@ readValueAttributeComplete(UA_Server *server, const UA_VariableNode *vn,
 
 UA_StatusCode
 readValueAttribute(UA_Server *server, const UA_VariableNode *vn, UA_DataValue *v) {
-    return readValueAttributeComplete(server, vn, UA_TIMESTAMPSTORETURN_NEITHER, NULL, v);
+    return readValueAttributeComplete(server, vn, UA_TIMESTAMPSTORETURN_NEITHER, NULL, 0.0, v);
+}
+
+/* The members of value are moved into the node */
+static UA_StatusCode
+moveValueIntoNode(UA_VariableNode *node, UA_DataValue *value) {
+#ifdef UA_ENABLE_MULTITHREADING
+    return UA_VariableNode_publishValue(node, NULL, value);
+#else
+    UA_DataValue_deleteMembers(&node->value.data.value);
+    node->value.data.value = *value;
+    return UA_STATUSCODE_GOOD;
+#endif
+}
+
+/* Overwrites the stored value without allocation if the new value has the
+ * same fixed-size type and shape. Returns false if the value has to be copied.
+ * With multithreading, readers may still use the published value. */
+static UA_Boolean
+writeValueInPlace(UA_VariableNode *node, const UA_DataValue *value) {
+#ifdef UA_ENABLE_MULTITHREADING
+    return false;
+#else
+    UA_DataValue *target = &node->value.data.value;
+    const UA_Variant *src = &value->value;
+    UA_Variant *dst = &target->value;
+    if(!value->hasValue || !target->hasValue || !src->type || src->type != dst->type ||
+       !src->type->fixedSize || dst->storageType != UA_VARIANT_DATA ||
+       src->arrayLength != dst->arrayLength)
+        return false;
+    size_t count = src->arrayLength;
+    if(count == 0) {
+        if(!UA_Variant_isScalar(src) || !UA_Variant_isScalar(dst))
+            return false;
+        count = 1;
+    }
+    if(src->arrayDimensionsSize != dst->arrayDimensionsSize ||
+       (src->arrayDimensionsSize > 0 &&
+        memcmp(src->arrayDimensions, dst->arrayDimensions,
+               sizeof(UA_UInt32) * src->arrayDimensionsSize) != 0))
+        return false;
+    memmove(dst->data, src->data, src->type->memSize * count);
+    UA_Variant stored = *dst;
+    *target = *value;
+    target->value = stored;
+    return true;
+#endif
 }
 
 static UA_StatusCode
 writeValueAttributeWithoutRange(UA_VariableNode *node, const UA_DataValue *value) {
-    UA_DataValue old_value = node->value.data.value; /* keep the pointers for restoring */
-    UA_StatusCode retval = UA_DataValue_copy(value, &node->value.data.value);
-    if(retval == UA_STATUSCODE_GOOD)
-        UA_DataValue_deleteMembers(&old_value);
-    else
-        node->value.data.value = old_value;
+    if(writeValueInPlace(node, value))
+        return UA_STATUSCODE_GOOD;
+    UA_DataValue new_value;
+    UA_StatusCode retval = UA_DataValue_copy(value, &new_value);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    return moveValueIntoNode(node, &new_value);
+}
+
+UA_StatusCode
+moveValueAttribute(UA_Server *server, UA_VariableNode *node, UA_Variant *value) {
+    UA_StatusCode retval = typeCheckValue(server, &node->dataType, node->valueRank,
+                                          node->arrayDimensionsSize, node->arrayDimensions,
+                                          value, NULL, NULL);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+
+    /* Set the source timestamp as in writeValueAttribute */
+    UA_DataValue dv;
+    UA_DataValue_init(&dv);
+    dv.value = *value;
+    dv.hasValue = true;
+    dv.sourceTimestamp = UA_DateTime_now();
+    dv.hasSourceTimestamp = true;
+    retval = moveValueIntoNode(node, &dv);
+    UA_Variant_init(value);
     return retval;
 }
 
 static UA_StatusCode
-writeValueAttributeWithRange(UA_VariableNode *node, const UA_DataValue *value,
-                             const UA_NumericRange *rangeptr) {
+writeRangeIntoDataValue(UA_DataValue *target, const UA_DataValue *value,
+                        const UA_NumericRange *rangeptr) {
     /* Value on both sides? */
-    if(value->status != node->value.data.value.status ||
-       !value->hasValue || !node->value.data.value.hasValue)
+    if(value->status != target->status || !value->hasValue || !target->hasValue)
         return UA_STATUSCODE_BADINDEXRANGEINVALID;
 
     /* Make scalar a one-entry array for range matching */
@@ -20466,21 +24449,47 @@ writeValueAttributeWithRange(UA_VariableNode *node, const UA_DataValue *value,
     }
 
     /* Write the value */
-    UA_StatusCode retval = UA_Variant_setRangeCopy(&node->value.data.value.value,
-                                                   v->data, v->arrayLength, *rangeptr);
+    UA_StatusCode retval = UA_Variant_setRangeCopy(&target->value, v->data,
+                                                   v->arrayLength, *rangeptr);
     if(retval != UA_STATUSCODE_GOOD)
         return retval;
 
     /* Write the status and timestamps */
-    node->value.data.value.hasStatus = value->hasStatus;
-    node->value.data.value.status = value->status;
-    node->value.data.value.hasSourceTimestamp = value->hasSourceTimestamp;
-    node->value.data.value.sourceTimestamp = value->sourceTimestamp;
-    node->value.data.value.hasSourcePicoseconds = value->hasSourcePicoseconds;
-    node->value.data.value.sourcePicoseconds = value->sourcePicoseconds;
+    target->hasStatus = value->hasStatus;
+    target->status = value->status;
+    target->hasSourceTimestamp = value->hasSourceTimestamp;
+    target->sourceTimestamp = value->sourceTimestamp;
+    target->hasSourcePicoseconds = value->hasSourcePicoseconds;
+    target->sourcePicoseconds = value->sourcePicoseconds;
     return UA_STATUSCODE_GOOD;
 }
 
+static UA_StatusCode
+writeValueAttributeWithRange(UA_VariableNode *node, const UA_DataValue *value,
+                             const UA_NumericRange *rangeptr) {
+#ifdef UA_ENABLE_MULTITHREADING
+    /* Modify a copy of the current value and publish it if no other write
+     * happened in between */
+    UA_StatusCode retval;
+    do {
+        const UA_DataValue *current = UA_VariableNode_getValue(node);
+        UA_DataValue new_value;
+        retval = UA_DataValue_copy(current, &new_value);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+        retval = writeRangeIntoDataValue(&new_value, value, rangeptr);
+        if(retval != UA_STATUSCODE_GOOD) {
+            UA_DataValue_deleteMembers(&new_value);
+            return retval;
+        }
+        retval = UA_VariableNode_publishValue(node, current, &new_value);
+    } while(retval == UA_STATUSCODE_BADINTERNALERROR);
+    return retval;
+#else
+    return writeRangeIntoDataValue(&node->value.data.value, value, rangeptr);
+#endif
+}
+
 UA_StatusCode
 writeValueAttribute(UA_Server *server, UA_VariableNode *node,
                     const UA_DataValue *value, const UA_String *indexRange) {
@@ -20535,7 +24544,8 @@ writeValueAttribute(UA_Server *server, UA_VariableNode *node,
             UA_RCU_UNLOCK();
             writtenNode->value.data.callback.onWrite(writtenNode->value.data.callback.handle,
                                                      writtenNode->nodeId,
-                                                     &writtenNode->value.data.value.value, rangeptr);
+                                                     &UA_VariableNode_getValue(writtenNode)->value,
+                                                     rangeptr);
             UA_RCU_LOCK();
         }
     } else {
@@ -20544,6 +24554,8 @@ writeValueAttribute(UA_Server *server, UA_VariableNode *node,
             retval = node->value.dataSource.write(node->value.dataSource.handle,
                                                   node->nodeId, &editableValue.value, rangeptr);
             UA_RCU_LOCK();
+            if(node->valueCache)
+                UA_ValueCache_clear(node->valueCache);
         } else {
             retval = UA_STATUSCODE_BADWRITENOTSUPPORTED;
         }
@@ -20617,9 +24629,26 @@ static const UA_String binEncoding = {sizeof("Default Binary")-1, (UA_Byte*)"Def
         break;                                                  \
     }
 
-void Service_Read_single(UA_Server *server, UA_Session *session,
-                         const UA_TimestampsToReturn timestamps,
-                         const UA_ReadValueId *id, UA_DataValue *v) {
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+/* Nodes from an image or from constant memory are not changed */
+static UA_Boolean
+canCacheAttributes(UA_Server *server, const UA_Node *node) {
+#ifndef UA_ENABLE_MULTITHREADING
+    return !UA_NodeStore_isReadOnly(server->nodestore, node);
+#else
+    return true;
+#endif
+}
+#endif
+
+/* Reads the attribute from the node that was looked up for the ReadValueId.
+ * node is NULL if the NodeId is unknown. If encoded is not NULL, the value of
+ * attributes other than the Value may be returned in binary encoding instead.
+ * Then, v->hasValue is set but v->value remains empty. */
+static void
+readNode(UA_Server *server, UA_Session *session, const UA_TimestampsToReturn timestamps,
+         UA_Double maxAge, const UA_ReadValueId *id, const UA_Node *node, UA_DataValue *v,
+         const UA_ByteString **encoded) {
     UA_LOG_DEBUG_SESSION(server->config.logger, session,
                          "Read the attribute %i", id->attributeId);
 
@@ -20638,14 +24667,23 @@ void Service_Read_single(UA_Server *server, UA_Session *session,
         return;
     }
 
-    /* Get the node */
-    const UA_Node *node = UA_NodeStore_get(server->nodestore, &id->nodeId);
     if(!node) {
         v->hasStatus = true;
         v->status = UA_STATUSCODE_BADNODEIDUNKNOWN;
         return;
     }
 
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    /* The attribute was already encoded */
+    if(encoded && id->attributeId != UA_ATTRIBUTEID_VALUE) {
+        *encoded = UA_Node_findEncodedAttribute(node, id->attributeId);
+        if(*encoded) {
+            v->hasValue = true;
+            goto timestamps;
+        }
+    }
+#endif
+
     /* Read the attribute */
     UA_StatusCode retval = UA_STATUSCODE_GOOD;
     switch(id->attributeId) {
@@ -20658,9 +24696,16 @@ void Service_Read_single(UA_Server *server, UA_Session *session,
     case UA_ATTRIBUTEID_BROWSENAME:
         forceVariantSetScalar(&v->value, &node->browseName, &UA_TYPES[UA_TYPES_QUALIFIEDNAME]);
         break;
-    case UA_ATTRIBUTEID_DISPLAYNAME:
-        forceVariantSetScalar(&v->value, &node->displayName, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
+    case UA_ATTRIBUTEID_DISPLAYNAME: {
+        UA_LocalizedText displayName;
+        UA_Node_getDisplayName(node, &displayName);
+        if(displayName.text.data == node->displayName.text.data)
+            forceVariantSetScalar(&v->value, &node->displayName, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
+        else
+            retval = UA_Variant_setScalarCopy(&v->value, &displayName,
+                                              &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
         break;
+    }
     case UA_ATTRIBUTEID_DESCRIPTION:
         forceVariantSetScalar(&v->value, &node->description, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT]);
         break;
@@ -20696,7 +24741,7 @@ void Service_Read_single(UA_Server *server, UA_Session *session,
     case UA_ATTRIBUTEID_VALUE:
         CHECK_NODECLASS(UA_NODECLASS_VARIABLE | UA_NODECLASS_VARIABLETYPE);
         retval = readValueAttributeComplete(server, (const UA_VariableNode*)node,
-                                            timestamps, &id->indexRange, v);
+                                            timestamps, &id->indexRange, maxAge, v);
         break;
     case UA_ATTRIBUTEID_DATATYPE:
         CHECK_NODECLASS(UA_NODECLASS_VARIABLE | UA_NODECLASS_VARIABLETYPE);
@@ -20755,6 +24800,19 @@ void Service_Read_single(UA_Server *server, UA_Session *session,
 
     v->hasValue = true;
 
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    /* Encode the attribute for the next Reads */
+    if(encoded && id->attributeId != UA_ATTRIBUTEID_VALUE &&
+       canCacheAttributes(server, node)) {
+        *encoded = UA_Node_addEncodedAttribute(node, id->attributeId, &v->value);
+        if(*encoded) {
+            UA_Variant_deleteMembers(&v->value);
+            UA_Variant_init(&v->value);
+        }
+    }
+
+ timestamps:
+#endif
     /* Create server timestamp */
     if(timestamps == UA_TIMESTAMPSTORETURN_SERVER ||
        timestamps == UA_TIMESTAMPSTORETURN_BOTH) {
@@ -20775,8 +24833,159 @@ void Service_Read_single(UA_Server *server, UA_Session *session,
     }
 }
 
-void Service_Read(UA_Server *server, UA_Session *session,
-                  const UA_ReadRequest *request, UA_ReadResponse *response) {
+void Service_Read_single(UA_Server *server, UA_Session *session,
+                         const UA_TimestampsToReturn timestamps, UA_Double maxAge,
+                         const UA_ReadValueId *id, UA_DataValue *v) {
+    readNode(server, session, timestamps, maxAge, id,
+             UA_Server_getSessionNode(server, session, &id->nodeId), v, NULL);
+}
+
+/* Large requests are read in groups. The slots and the nodes of the whole
+ * group are prefetched from the nodestore before the first node is looked up.
+ * So the cache misses of a group overlap instead of stalling every single
+ * read. */
+#define UA_READ_PREFETCH 16
+
+static void
+readBatch(UA_Server *server, UA_Session *session, const UA_TimestampsToReturn timestamps,
+          UA_Double maxAge, const UA_ReadValueId *ids, UA_DataValue *results,
+          const UA_ByteString **encoded, size_t size, const UA_Boolean *skip) {
+    const UA_NodeId *nodeIds[UA_READ_PREFETCH];
+    UA_UInt32 hashes[UA_READ_PREFETCH];
+    const UA_Node *nodes[UA_READ_PREFETCH];
+    for(size_t i = 0; i < size; i += UA_READ_PREFETCH) {
+        size_t n = size - i;
+        if(n > UA_READ_PREFETCH)
+            n = UA_READ_PREFETCH;
+
+        /* Hash the NodeIds (registered nodes are already hashed) */
+        for(size_t j = 0; j < n; ++j) {
+            const UA_NodeId *nodeId = &ids[i+j].nodeId;
+            const UA_RegisteredNode *reg = UA_Session_getRegisteredNode(session, nodeId);
+            if(reg) {
+                nodeIds[j] = &reg->nodeId;
+                hashes[j] = reg->hash;
+            } else {
+                nodeIds[j] = nodeId;
+                hashes[j] = UA_NodeStore_hash(nodeId);
+            }
+            UA_NodeStore_prefetch(server->nodestore, nodeIds[j], hashes[j], false);
+        }
+        for(size_t j = 0; j < n; ++j)
+            UA_NodeStore_prefetch(server->nodestore, nodeIds[j], hashes[j], true);
+
+        /* Look up the nodes */
+        for(size_t j = 0; j < n; ++j)
+            nodes[j] = UA_NodeStore_getHashed(server->nodestore, nodeIds[j], hashes[j]);
+
+        /* Read the attributes */
+        for(size_t j = 0; j < n; ++j) {
+            if(!skip || !skip[i+j])
+                readNode(server, session, timestamps, maxAge, &ids[i+j], nodes[j],
+                         &results[i+j], encoded ? &encoded[i+j] : NULL);
+        }
+    }
+}
+
+#ifdef UA_ENABLE_MULTITHREADING
+
+/* Very large requests are split into chunks that idle worker threads can
+ * read. The thread processing the request reads chunks as well and waits
+ * only for chunks that other workers have started. The batch is freed by the
+ * last job or the request, whichever finishes last. */
+#define UA_READ_PARALLEL_MINSIZE 4096
+#define UA_READ_CHUNKSIZE 1024
+
+typedef struct {
+    UA_Session *session;
+    const UA_ReadRequest *request;
+    UA_ReadResponse *response;
+    const UA_ByteString **encoded;
+    const UA_Boolean *skip;
+    UA_UInt32 chunksSize;
+    volatile UA_UInt32 nextChunk;
+    volatile UA_UInt32 doneChunks;
+    volatile UA_UInt32 refCount;
+} UA_ReadChunks;
+
+/* Returns false when no chunk was left */
+static UA_Boolean
+readChunk(UA_Server *server, UA_ReadChunks *chunks) {
+    UA_UInt32 chunk = UA_atomic_add(&chunks->nextChunk, 1) - 1;
+    if(chunk >= chunks->chunksSize)
+        return false;
+    size_t first = (size_t)chunk * UA_READ_CHUNKSIZE;
+    size_t size = chunks->request->nodesToReadSize - first;
+    if(size > UA_READ_CHUNKSIZE)
+        size = UA_READ_CHUNKSIZE;
+    readBatch(server, chunks->session, chunks->request->timestampsToReturn,
+              chunks->request->maxAge, &chunks->request->nodesToRead[first], &chunks->response->results[first],
+              chunks->encoded ? &chunks->encoded[first] : NULL,
+              size, chunks->skip ? &chunks->skip[first] : NULL);
+    UA_atomic_add(&chunks->doneChunks, 1);
+    return true;
+}
+
+static void
+releaseReadChunks(UA_ReadChunks *chunks) {
+    if(UA_atomic_add(&chunks->refCount, (UA_UInt32)-1) == 0)
+        UA_free(chunks);
+}
+
+static void
+readChunksJob(UA_Server *server, UA_ReadChunks *chunks) {
+    while(readChunk(server, chunks)) {}
+    releaseReadChunks(chunks);
+}
+
+/* Returns false if the request is not read in parallel */
+static UA_Boolean
+readParallel(UA_Server *server, UA_Session *session, const UA_ReadRequest *request,
+             UA_ReadResponse *response, const UA_ByteString **encoded,
+             const UA_Boolean *skip) {
+    size_t size = request->nodesToReadSize;
+    if(size < UA_READ_PARALLEL_MINSIZE || server->config.nThreads < 2 || !server->workers)
+        return false;
+    UA_ReadChunks *chunks = UA_malloc(sizeof(UA_ReadChunks));
+    if(!chunks)
+        return false;
+    chunks->session = session;
+    chunks->request = request;
+    chunks->response = response;
+    chunks->encoded = encoded;
+    chunks->skip = skip;
+    chunks->chunksSize = (UA_UInt32)((size + UA_READ_CHUNKSIZE - 1) / UA_READ_CHUNKSIZE);
+    chunks->nextChunk = 0;
+    chunks->doneChunks = 0;
+    chunks->refCount = 1;
+
+    /* One job per additional worker */
+    UA_UInt32 helpers = chunks->chunksSize - 1;
+    if(helpers > (UA_UInt32)server->config.nThreads - 1)
+        helpers = (UA_UInt32)server->config.nThreads - 1;
+    for(UA_UInt32 i = 0; i < helpers; ++i) {
+        UA_Job job;
+        job.type = UA_JOBTYPE_METHODCALL;
+        job.job.methodCall.method = (void (*)(UA_Server*, void*))readChunksJob;
+        job.job.methodCall.data = chunks;
+        UA_atomic_add(&chunks->refCount, 1);
+        dispatchJob(server, &job);
+    }
+    pthread_cond_broadcast(&server->dispatchQueue_condition);
+
+    /* Read along and wait for the chunks that other workers have taken */
+    while(readChunk(server, chunks)) {}
+    while(chunks->doneChunks < chunks->chunksSize)
+        UA_atomic_sync();
+    releaseReadChunks(chunks);
+    return true;
+}
+
+#endif
+
+static void
+readService(UA_Server *server, UA_Session *session, const UA_ReadRequest *request,
+            UA_ReadResponse *response, const UA_ByteString **encoded) {
     UA_LOG_DEBUG_SESSION(server->config.logger, session, "Processing ReadRequest");
     if(request->nodesToReadSize <= 0) {
         response->responseHeader.serviceResult = UA_STATUSCODE_BADNOTHINGTODO;
@@ -20824,13 +25033,16 @@ void Service_Read(UA_Server *server, UA_Session *session,
     }
 #endif
 
-    for(size_t i = 0;i < size;++i) {
 #ifdef UA_ENABLE_EXTERNAL_NAMESPACES
-        if(!isExternal[i])
+    const UA_Boolean *skip = isExternal;
+#else
+    const UA_Boolean *skip = NULL;
 #endif
-            Service_Read_single(server, session, request->timestampsToReturn,
-                                &request->nodesToRead[i], &response->results[i]);
-    }
+#ifdef UA_ENABLE_MULTITHREADING
+    if(!readParallel(server, session, request, response, encoded, skip))
+#endif
+        readBatch(server, session, request->timestampsToReturn, request->maxAge,
+                  request->nodesToRead, response->results, encoded, size, skip);
 
 #ifdef UA_ENABLE_NONSTANDARD_STATELESS
     /* Add an expiry header for caching */
@@ -20874,6 +25086,261 @@ void Service_Read(UA_Server *server, UA_Session *session,
 #endif
 }
 
+void Service_Read(UA_Server *server, UA_Session *session,
+                  const UA_ReadRequest *request, UA_ReadResponse *response) {
+    readService(server, session, request, response, NULL);
+}
+
+/* Large Read responses are encoded while the nodes are read. Only a window of
+ * the results is held in memory at any time. */
+#define UA_READ_STREAMING_MINSIZE 256
+#define UA_READ_STREAMING_WINDOW 64
+
+/* Encodes the DataValue. If encoding is not NULL, it contains the value of an
+ * attribute besides the Value in binary encoding. It is copied between the
+ * encoding mask and the server timestamp of the DataValue. */
+static UA_StatusCode
+encodeReadResult(const UA_DataValue *v, const UA_ByteString *encoding,
+                 UA_exchangeEncodeBuffer exchangeCallback, void *exchangeHandle,
+                 UA_ByteString *dst, size_t *offset) {
+    if(!encoding)
+        return UA_encodeBinary(v, &UA_TYPES[UA_TYPES_DATAVALUE],
+                               exchangeCallback, exchangeHandle, dst, offset);
+
+    /* Only the value and the server timestamp are set */
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    UA_Byte encodingMask = (UA_Byte)(0x01 | (v->hasServerTimestamp << 3));
+    if(*offset + 1 + encoding->length <= dst->length) {
+        /* Fits into the current chunk */
+        dst->data[*offset] = encodingMask;
+        memcpy(&dst->data[*offset + 1], encoding->data, encoding->length);
+        *offset += 1 + encoding->length;
+    } else {
+        retval = UA_encodeBinary(&encodingMask, &UA_TYPES[UA_TYPES_BYTE],
+                                 exchangeCallback, exchangeHandle, dst, offset);
+        if(retval == UA_STATUSCODE_GOOD)
+            retval = UA_encodeBinaryRaw(encoding, exchangeCallback, exchangeHandle,
+                                        dst, offset);
+    }
+    if(retval == UA_STATUSCODE_GOOD && v->hasServerTimestamp)
+        retval = UA_encodeBinary(&v->serverTimestamp, &UA_TYPES[UA_TYPES_DATETIME],
+                                 exchangeCallback, exchangeHandle, dst, offset);
+    return retval;
+}
+
+typedef struct {
+    UA_Server *server;
+    UA_Session *session;
+    const UA_ReadRequest *request;
+    size_t windowSize;
+    UA_DataValue *results; /* windowSize entries */
+    const UA_ByteString **encoded; /* windowSize entries or NULL */
+} UA_ReadStream;
+
+/* Encodes the ReadResponse after the ResponseHeader. The nodes are read and
+ * encoded one window at a time. */
+static UA_StatusCode
+streamReadResults(const UA_ReadStream *s, UA_exchangeEncodeBuffer exchangeCallback,
+                  void *exchangeHandle, UA_ByteString *dst, size_t *offset) {
+    const UA_ReadRequest *request = s->request;
+    size_t size = request->nodesToReadSize;
+    UA_Int32 resultsSize = (UA_Int32)size;
+    UA_StatusCode retval = UA_encodeBinary(&resultsSize, &UA_TYPES[UA_TYPES_INT32],
+                                           exchangeCallback, exchangeHandle, dst, offset);
+    for(size_t first = 0; first < size && retval == UA_STATUSCODE_GOOD;
+        first += s->windowSize) {
+        size_t n = size - first;
+        if(n > s->windowSize)
+            n = s->windowSize;
+
+        /* Read the window */
+#ifdef UA_ENABLE_MULTITHREADING
+        UA_ReadRequest part = *request; /* shallow copy */
+        part.nodesToRead = &request->nodesToRead[first];
+        part.nodesToReadSize = n;
+        UA_ReadResponse partResponse;
+        UA_ReadResponse_init(&partResponse);
+        partResponse.results = s->results;
+        partResponse.resultsSize = n;
+        if(!readParallel(s->server, s->session, &part, &partResponse, s->encoded, NULL))
+#endif
+            readBatch(s->server, s->session, request->timestampsToReturn, request->maxAge,
+                      &request->nodesToRead[first], s->results, s->encoded, n, NULL);
+
+        /* Encode and release the window */
+        for(size_t i = 0; i < n; ++i) {
+            if(retval == UA_STATUSCODE_GOOD)
+                retval = encodeReadResult(&s->results[i], s->encoded ? s->encoded[i] : NULL,
+                                          exchangeCallback, exchangeHandle, dst, offset);
+            UA_DataValue_deleteMembers(&s->results[i]);
+            UA_DataValue_init(&s->results[i]);
+        }
+        if(s->encoded)
+            memset(s->encoded, 0, sizeof(const UA_ByteString*) * n);
+    }
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+
+    /* The Read service returns no diagnostic infos */
+    UA_Int32 diagnosticInfosSize = -1;
+    return UA_encodeBinary(&diagnosticInfosSize, &UA_TYPES[UA_TYPES_INT32],
+                           exchangeCallback, exchangeHandle, dst, offset);
+}
+
+/* Requests with an invalid parameter are answered by the Read service */
+static UA_Boolean
+canStreamRead(UA_Server *server, UA_Session *session, const UA_ReadRequest *request) {
+    if(request->nodesToReadSize < UA_READ_STREAMING_MINSIZE ||
+       request->timestampsToReturn > UA_TIMESTAMPSTORETURN_NEITHER ||
+       request->maxAge < 0)
+        return false;
+#ifdef UA_ENABLE_EXTERNAL_NAMESPACES
+    if(server->externalNamespacesSize > 0)
+        return false;
+#endif
+#ifdef UA_ENABLE_NONSTANDARD_STATELESS
+    /* The expiry header is added after reading */
+    if(session->sessionId.namespaceIndex == 0 &&
+       session->sessionId.identifierType == UA_NODEIDTYPE_NUMERIC &&
+       session->sessionId.identifier.numeric == 0)
+        return false;
+#endif
+    return true;
+}
+
+static UA_StatusCode
+streamReadResponse(UA_Server *server, UA_Session *session, UA_SecureChannel *channel,
+                   UA_UInt32 requestId, const UA_ReadRequest *request) {
+    UA_LOG_DEBUG_SESSION(server->config.logger, session,
+                         "Processing ReadRequest as a stream");
+    UA_ReadStream s;
+    s.server = server;
+    s.session = session;
+    s.request = request;
+    s.windowSize = UA_READ_STREAMING_WINDOW;
+#ifdef UA_ENABLE_MULTITHREADING
+    /* Windows are large enough to be read in parallel */
+    if(server->config.nThreads >= 2 && server->workers)
+        s.windowSize = UA_READ_PARALLEL_MINSIZE;
+#endif
+    if(s.windowSize > request->nodesToReadSize)
+        s.windowSize = request->nodesToReadSize;
+
+    UA_ReadResponse response;
+    UA_ReadResponse_init(&response);
+    response.responseHeader.requestHandle = request->requestHeader.requestHandle;
+    response.responseHeader.timestamp = UA_DateTime_now();
+    s.results = (UA_DataValue*)UA_Array_new(s.windowSize, &UA_TYPES[UA_TYPES_DATAVALUE]);
+    if(!s.results) {
+        response.responseHeader.serviceResult = UA_STATUSCODE_BADOUTOFMEMORY;
+        return UA_SecureChannel_sendBinaryMessage(channel, requestId, &response,
+                                                  &UA_TYPES[UA_TYPES_READRESPONSE]);
+    }
+    s.encoded = NULL;
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+    /* Without the table, the attributes are encoded as usual */
+    s.encoded = (const UA_ByteString**)
+        UA_calloc(s.windowSize, sizeof(const UA_ByteString*));
+#endif
+
+    UA_StatusCode retval =
+        UA_SecureChannel_sendCustomResponse(channel, requestId,
+                                            &UA_TYPES[UA_TYPES_READRESPONSE],
+                                            &response.responseHeader,
+                                            (UA_SecureChannel_encodeBody)streamReadResults, &s);
+    UA_Array_delete(s.results, s.windowSize, &UA_TYPES[UA_TYPES_DATAVALUE]);
+    UA_free(s.encoded);
+    return retval;
+}
+
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+
+typedef struct {
+    const UA_ReadResponse *response;
+    const UA_ByteString **encoded;
+} UA_ReadResults;
+
+/* Encodes the ReadResponse after the ResponseHeader */
+static UA_StatusCode
+encodeReadResults(const UA_ReadResults *r, UA_exchangeEncodeBuffer exchangeCallback,
+                  void *exchangeHandle, UA_ByteString *dst, size_t *offset) {
+    const UA_ReadResponse *response = r->response;
+    UA_Int32 resultsSize = (UA_Int32)response->resultsSize;
+    UA_StatusCode retval = UA_encodeBinary(&resultsSize, &UA_TYPES[UA_TYPES_INT32],
+                                           exchangeCallback, exchangeHandle, dst, offset);
+    for(size_t i = 0; i < response->resultsSize && retval == UA_STATUSCODE_GOOD; ++i)
+        retval = encodeReadResult(&response->results[i], r->encoded[i],
+                                  exchangeCallback, exchangeHandle, dst, offset);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+
+    /* The Read service returns no diagnostic infos */
+    UA_Int32 diagnosticInfosSize = -1;
+    if(response->diagnosticInfos == UA_EMPTY_ARRAY_SENTINEL)
+        diagnosticInfosSize = 0;
+    return UA_encodeBinary(&diagnosticInfosSize, &UA_TYPES[UA_TYPES_INT32],
+                           exchangeCallback, exchangeHandle, dst, offset);
+}
+
+static UA_StatusCode
+spliceReadResponse(UA_Server *server, UA_Session *session, UA_SecureChannel *channel,
+                   UA_UInt32 requestId, const UA_ReadRequest *request) {
+    /* Read with the encoded attributes of the nodes */
+    UA_ReadResponse response;
+    UA_ReadResponse_init(&response);
+    const UA_ByteString **encoded = NULL;
+    if(request->nodesToReadSize > 0)
+        encoded = (const UA_ByteString**)
+            UA_calloc(request->nodesToReadSize, sizeof(const UA_ByteString*));
+    readService(server, session, request, &response, encoded);
+    response.responseHeader.requestHandle = request->requestHeader.requestHandle;
+    response.responseHeader.timestamp = UA_DateTime_now();
+
+    /* Encode as usual if no encoded attribute is used */
+    UA_Boolean splice = false;
+    if(encoded && response.diagnosticInfosSize == 0) {
+        for(size_t i = 0; i < response.resultsSize && !splice; ++i)
+            splice = (encoded[i] != NULL);
+    }
+    UA_StatusCode retval;
+    if(splice) {
+        UA_ReadResults results = {&response, encoded};
+        retval = UA_SecureChannel_sendCustomResponse(channel, requestId,
+                                                     &UA_TYPES[UA_TYPES_READRESPONSE],
+                                                     &response.responseHeader,
+                                                     (UA_SecureChannel_encodeBody)encodeReadResults,
+                                                     &results);
+    } else {
+        retval = UA_SecureChannel_sendBinaryMessage(channel, requestId, &response,
+                                                    &UA_TYPES[UA_TYPES_READRESPONSE]);
+    }
+    UA_free(encoded);
+    UA_ReadResponse_deleteMembers(&response);
+    return retval;
+}
+
+#endif /* UA_ENABLE_ATTRIBUTE_CACHE */
+
+UA_Boolean
+sendReadResponse(UA_Server *server, UA_Session *session, UA_SecureChannel *channel,
+                 UA_UInt32 requestId, const UA_ReadRequest *request) {
+    UA_StatusCode retval;
+    if(canStreamRead(server, session, request)) {
+        retval = streamReadResponse(server, session, channel, requestId, request);
+    } else {
+#ifdef UA_ENABLE_ATTRIBUTE_CACHE
+        retval = spliceReadResponse(server, session, channel, requestId, request);
+#else
+        return false;
+#endif
+    }
+    if(retval != UA_STATUSCODE_GOOD)
+        UA_LOG_INFO_CHANNEL(server->config.logger, channel,
+                            "Could not send the message over the SecureChannel "
+                            "with StatusCode %s", UA_StatusCode_name(retval));
+    return true;
+}
+
 /* Exposes the Read service to local users */
 UA_DataValue
 UA_Server_read(UA_Server *server, const UA_ReadValueId *item,
@@ -20881,7 +25348,24 @@ UA_Server_read(UA_Server *server, const UA_ReadValueId *item,
     UA_DataValue dv;
     UA_DataValue_init(&dv);
     UA_RCU_LOCK();
-    Service_Read_single(server, &adminSession, timestamps, item, &dv);
+    Service_Read_single(server, &adminSession, timestamps, 0.0, item, &dv);
+    UA_RCU_UNLOCK();
+    return dv;
+}
+
+UA_DataValue
+UA_Server_readByHandle(UA_Server *server, UA_NodeHandle *handle,
+                       const UA_AttributeId attributeId,
+                       UA_TimestampsToReturn timestamps) {
+    UA_ReadValueId item;
+    UA_ReadValueId_init(&item);
+    item.nodeId = handle->nodeId;
+    item.attributeId = attributeId;
+    UA_DataValue dv;
+    UA_DataValue_init(&dv);
+    UA_RCU_LOCK();
+    readNode(server, &adminSession, timestamps, 0.0, &item,
+             UA_Server_getHandleNode(server, handle), &dv, NULL);
     UA_RCU_UNLOCK();
     return dv;
 }
@@ -20975,18 +25459,26 @@ CopyAttributeIntoNode(UA_Server *server, UA_Session *session,
         break;
     case UA_ATTRIBUTEID_BROWSENAME:
         CHECK_DATATYPE_SCALAR(QUALIFIEDNAME);
+#ifdef UA_ENABLE_COMPACT_NODES
+        /* A DisplayName without text is the old BrowseName. Keep it. */
+        if(!node->displayName.text.data && node->browseName.name.data) {
+            retval = UA_String_copy(&node->browseName.name, &node->displayName.text);
+            if(retval != UA_STATUSCODE_GOOD)
+                break;
+        }
+#endif
         UA_QualifiedName_deleteMembers(&node->browseName);
         UA_QualifiedName_copy(value, &node->browseName);
         break;
     case UA_ATTRIBUTEID_DISPLAYNAME:
         CHECK_DATATYPE_SCALAR(LOCALIZEDTEXT);
-        UA_LocalizedText_deleteMembers(&node->displayName);
-        UA_LocalizedText_copy(value, &node->displayName);
+        UA_Node_deleteText(&node->displayName);
+        UA_Node_copyText(value, &node->displayName);
         break;
     case UA_ATTRIBUTEID_DESCRIPTION:
         CHECK_DATATYPE_SCALAR(LOCALIZEDTEXT);
-        UA_LocalizedText_deleteMembers(&node->description);
-        UA_LocalizedText_copy(value, &node->description);
+        UA_Node_deleteText(&node->description);
+        UA_Node_copyText(value, &node->description);
         break;
     case UA_ATTRIBUTEID_WRITEMASK:
         CHECK_DATATYPE_SCALAR(UINT32);
@@ -21008,8 +25500,8 @@ CopyAttributeIntoNode(UA_Server *server, UA_Session *session,
     case UA_ATTRIBUTEID_INVERSENAME:
         CHECK_NODECLASS_WRITE(UA_NODECLASS_REFERENCETYPE);
         CHECK_DATATYPE_SCALAR(LOCALIZEDTEXT);
-        UA_LocalizedText_deleteMembers(&((UA_ReferenceTypeNode*)node)->inverseName);
-        UA_LocalizedText_copy(value, &((UA_ReferenceTypeNode*)node)->inverseName);
+        UA_Node_deleteText(&((UA_ReferenceTypeNode*)node)->inverseName);
+        UA_Node_copyText(value, &((UA_ReferenceTypeNode*)node)->inverseName);
         break;
     case UA_ATTRIBUTEID_CONTAINSNOLOOPS:
         CHECK_NODECLASS_WRITE(UA_NODECLASS_VIEW);
@@ -21084,6 +25576,90 @@ CopyAttributeIntoNode(UA_Server *server, UA_Session *session,
     return retval;
 }
 
+typedef struct {
+    const UA_NodeId *referenceTypeId;
+    const UA_NodeId *child;
+    const UA_QualifiedName *browseName;
+} UA_ChildName;
+
+static UA_StatusCode
+setChildName(UA_Server *server, UA_Session *session, UA_Node *parent,
+             const UA_ChildName *data) {
+    size_t pos = UA_Node_findReference(parent, data->referenceTypeId, false, data->child);
+    UA_Node_setReferenceTargetName(parent, pos, data->browseName);
+    return UA_STATUSCODE_GOOD;
+}
+
+/* Updates the BrowseName of the node in the index of the children of its
+ * parents */
+static void
+renameChildReferences(UA_Server *server, UA_Session *session, const UA_NodeId *nodeId) {
+    const UA_Node *node = UA_NodeStore_get(server->nodestore, nodeId);
+    if(!node)
+        return;
+    UA_ReferenceIterator it;
+    UA_ReferenceIterator_init(&it, node, UA_BROWSEDIRECTION_INVERSE, NULL, 0);
+    const UA_ReferenceNode *ref;
+    while((ref = UA_ReferenceIterator_next(&it))) {
+        /* Editing the node itself would invalidate the iterator */
+        if(ref->targetId.serverIndex != 0 || UA_NodeId_equal(&ref->targetId.nodeId, nodeId))
+            continue;
+        const UA_Node *parent = UA_NodeStore_get(server->nodestore, &ref->targetId.nodeId);
+        if(!parent || !parent->referenceIndex)
+            continue;
+        UA_ChildName data = {&ref->referenceTypeId, nodeId, &node->browseName};
+        UA_Server_editNode(server, session, &ref->targetId.nodeId,
+                           (UA_EditNodeCallback)setChildName, &data);
+    }
+}
+
+/* If handle is not NULL, the node is taken from the handle and the NodeId of
+ * the WriteValue is ignored */
+static UA_StatusCode
+writeNode(UA_Server *server, UA_Session *session, const UA_WriteValue *wvalue,
+          UA_NodeHandle *handle) {
+#ifdef UA_ENABLE_MULTITHREADING
+    /* Writing the value of a VariableNode does not change the structure of the
+     * node. The value is published in the value slot without copying and
+     * replacing the node. */
+    if(wvalue->attributeId == UA_ATTRIBUTEID_VALUE) {
+        const UA_Node *node = handle ? UA_Server_getHandleNode(server, handle) :
+            UA_Server_getSessionNode(server, session, &wvalue->nodeId);
+        if(!node)
+            return UA_STATUSCODE_BADNODEIDUNKNOWN;
+        if(node->nodeClass == UA_NODECLASS_VARIABLE &&
+           ((const UA_VariableNode*)node)->valueSlot) {
+            UA_StatusCode retval =
+                writeValueAttribute(server, (UA_VariableNode*)(uintptr_t)node,
+                                    &wvalue->value, &wvalue->indexRange);
+            if(retval != UA_STATUSCODE_GOOD)
+                UA_LOG_INFO_SESSION(server->config.logger, session,
+                                    "WriteRequest returned status code %s",
+                                    UA_StatusCode_name(retval));
+            return retval;
+        }
+    }
+#endif
+    UA_StatusCode retval;
+    if(handle)
+        retval = UA_Server_editNodeByHandle(server, session, handle,
+                                            (UA_EditNodeCallback)CopyAttributeIntoNode, wvalue);
+    else
+        retval = UA_Server_editNode(server, session, &wvalue->nodeId,
+                                    (UA_EditNodeCallback)CopyAttributeIntoNode, wvalue);
+    if(retval == UA_STATUSCODE_GOOD && wvalue->attributeId == UA_ATTRIBUTEID_BROWSENAME) {
+        renameChildReferences(server, session, handle ? &handle->nodeId :
+                              UA_Session_resolveNodeId(session, &wvalue->nodeId));
+        invalidateInstantiationPlans(server);
+    }
+    return retval;
+}
+
+static UA_StatusCode
+Service_Write_single(UA_Server *server, UA_Session *session, const UA_WriteValue *wvalue) {
+    return writeNode(server, session, wvalue, NULL);
+}
+
 void
 Service_Write(UA_Server *server, UA_Session *session,
               const UA_WriteRequest *request, UA_WriteResponse *response) {
@@ -21102,9 +25678,7 @@ Service_Write(UA_Server *server, UA_Session *session,
 
 #ifndef UA_ENABLE_EXTERNAL_NAMESPACES
     for(size_t i = 0;i < request->nodesToWriteSize;++i) {
-        response->results[i] = UA_Server_editNode(server, session, &request->nodesToWrite[i].nodeId,
-                                                  (UA_EditNodeCallback)CopyAttributeIntoNode,
-                                                  &request->nodesToWrite[i]);
+        response->results[i] = Service_Write_single(server, session, &request->nodesToWrite[i]);
     }
 #else
     UA_Boolean isExternal[request->nodesToWriteSize];
@@ -21129,9 +25703,7 @@ Service_Write(UA_Server *server, UA_Session *session,
     for(size_t i = 0;i < request->nodesToWriteSize;++i) {
         if(isExternal[i])
             continue;
-        response->results[i] = UA_Server_editNode(server, session, &request->nodesToWrite[i].nodeId,
-                                                  (UA_EditNodeCallback)CopyAttributeIntoNode,
-                                                  &request->nodesToWrite[i]);
+        response->results[i] = Service_Write_single(server, session, &request->nodesToWrite[i]);
     }
 #endif
 }
@@ -21139,9 +25711,7 @@ Service_Write(UA_Server *server, UA_Session *session,
 UA_StatusCode
 UA_Server_write(UA_Server *server, const UA_WriteValue *value) {
     UA_RCU_LOCK();
-    UA_StatusCode retval =
-        UA_Server_editNode(server, &adminSession, &value->nodeId,
-                           (UA_EditNodeCallback)CopyAttributeIntoNode, value);
+    UA_StatusCode retval = Service_Write_single(server, &adminSession, value);
     UA_RCU_UNLOCK();
     return retval;
 }
@@ -21166,6 +25736,131 @@ __UA_Server_write(UA_Server *server, const UA_NodeId *nodeId,
     return UA_Server_write(server, &wvalue);
 }
 
+UA_StatusCode
+UA_Server_writeByHandle(UA_Server *server, UA_NodeHandle *handle,
+                        const UA_AttributeId attributeId, const UA_Variant value) {
+    UA_WriteValue wvalue;
+    UA_WriteValue_init(&wvalue);
+    wvalue.nodeId = handle->nodeId;
+    wvalue.attributeId = attributeId;
+    wvalue.value.hasValue = true;
+    wvalue.value.value = value;
+    UA_RCU_LOCK();
+    UA_StatusCode retval = writeNode(server, &adminSession, &wvalue, handle);
+    UA_RCU_UNLOCK();
+    return retval;
+}
+
+/*****************/
+/* Update Values */
+/*****************/
+
+/* Values from the local application are trusted. The type check is skipped if
+ * the value has exactly the data type of the node and a matching rank. */
+static UA_Boolean
+isTrustedValue(const UA_VariableNode *node, const UA_Variant *value) {
+    if(!value->type)
+        return true; /* status only */
+    if(!UA_NodeId_equal(&node->dataType, &value->type->typeId))
+        return false;
+    if(node->valueRank == -2)
+        return true;
+    if(node->valueRank == -1 || node->valueRank == -3)
+        return UA_Variant_isScalar(value);
+    return false;
+}
+
+static UA_StatusCode
+updateValue(UA_Server *server, UA_Session *session, UA_VariableNode *node,
+            const UA_ValueUpdate *update) {
+    if(node->nodeClass != UA_NODECLASS_VARIABLE)
+        return UA_STATUSCODE_BADNODECLASSINVALID;
+
+    /* Value, status and source timestamp are set together */
+    UA_DataValue value;
+    UA_DataValue_init(&value);
+    value.hasValue = (update->value.type != NULL);
+    value.value = update->value;
+    value.value.storageType = UA_VARIANT_DATA_NODELETE;
+    value.hasStatus = (update->status != UA_STATUSCODE_GOOD);
+    value.status = update->status;
+    value.hasSourceTimestamp = true;
+    value.sourceTimestamp = update->sourceTimestamp;
+    if(value.sourceTimestamp == 0)
+        value.sourceTimestamp = UA_DateTime_now();
+
+    /* Data sources and values of another type take the complete write */
+    if(node->valueSource != UA_VALUESOURCE_DATA || !isTrustedValue(node, &update->value))
+        return writeValueAttribute(server, node, &value, NULL);
+
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    if(!update->value.type) {
+        /* Only the status and the timestamp change. Keep the value. */
+        const UA_DataValue *current = UA_VariableNode_getValue(node);
+        value.hasValue = current->hasValue;
+        retval = UA_Variant_copy(&current->value, &value.value);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+        retval = moveValueIntoNode(node, &value);
+    } else if(!writeValueInPlace(node, &value)) {
+        retval = UA_Variant_copy(&update->value, &value.value);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+        retval = moveValueIntoNode(node, &value);
+    }
+    if(retval != UA_STATUSCODE_GOOD || !node->value.data.callback.onWrite)
+        return retval;
+
+    /* Callback after writing */
+    const UA_VariableNode *writtenNode = node;
+#ifdef UA_ENABLE_MULTITHREADING
+    writtenNode = (const UA_VariableNode*)UA_NodeStore_get(server->nodestore, &node->nodeId);
+#endif
+    UA_RCU_UNLOCK();
+    writtenNode->value.data.callback.onWrite(writtenNode->value.data.callback.handle,
+                                             writtenNode->nodeId,
+                                             &UA_VariableNode_getValue(writtenNode)->value,
+                                             NULL);
+    UA_RCU_LOCK();
+    return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode
+UA_Server_updateValues(UA_Server *server, size_t updatesSize,
+                       const UA_ValueUpdate *updates, UA_StatusCode *results) {
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    UA_RCU_LOCK();
+    for(size_t i = 0; i < updatesSize; ++i) {
+        const UA_ValueUpdate *update = &updates[i];
+        UA_StatusCode res;
+#ifdef UA_ENABLE_MULTITHREADING
+        /* Publish in the value slot without replacing the node */
+        const UA_Node *node = update->handle ?
+            UA_Server_getHandleNode(server, update->handle) :
+            UA_NodeStore_get(server->nodestore, &update->nodeId);
+        if(!node)
+            res = UA_STATUSCODE_BADNODEIDUNKNOWN;
+        else if(node->nodeClass == UA_NODECLASS_VARIABLE &&
+                ((const UA_VariableNode*)node)->valueSlot)
+            res = updateValue(server, &adminSession,
+                              (UA_VariableNode*)(uintptr_t)node, update);
+        else
+#endif
+        if(update->handle)
+            res = UA_Server_editNodeByHandle(server, &adminSession, update->handle,
+                                             (UA_EditNodeCallback)updateValue, update);
+        else
+            res = UA_Server_editNode(server, &adminSession, &update->nodeId,
+                                     (UA_EditNodeCallback)updateValue, update);
+        if(results)
+            results[i] = res;
+        if(retval == UA_STATUSCODE_GOOD)
+            retval = res;
+    }
+    UA_RCU_UNLOCK();
+    return retval;
+}
+
 /*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_services_nodemanagement.c" ***********************************/
 
 /* This Source Code Form is subject to the terms of the Mozilla Public
@@ -21261,8 +25956,7 @@ checkParentReference(UA_Server *server, UA_Session *session, UA_NodeClass nodeCl
     /* Test if the referencetype is hierarchical */
     const UA_NodeId hierarchicalReference =
         UA_NODEID_NUMERIC(0, UA_NS0ID_HIERARCHICALREFERENCES);
-    if(!isNodeInTree(server->nodestore, referenceTypeId,
-                     &hierarchicalReference, &subtypeId, 1)) {
+    if(!isSubtypeOf(server, referenceTypeId, &hierarchicalReference)) {
         UA_LOG_INFO_SESSION(server->config.logger, session,
                             "AddNodes: Reference type is not hierarchical");
         return UA_STATUSCODE_BADREFERENCETYPEIDINVALID;
@@ -21271,13 +25965,275 @@ checkParentReference(UA_Server *server, UA_Session *session, UA_NodeClass nodeCl
     return UA_STATUSCODE_GOOD;
 }
 
+/***********************/
+/* Instantiation Plans */
+/***********************/
+
+static UA_Boolean
+mandatoryChild(UA_Server *server, UA_Session *session, const UA_NodeId *childNodeId) {
+    const UA_NodeId mandatoryId = UA_NODEID_NUMERIC(0, UA_NS0ID_MODELLINGRULE_MANDATORY);
+    const UA_NodeId hasModellingRuleId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASMODELLINGRULE);
+
+    /* Get the child */
+    const UA_Node *child = UA_NodeStore_get(server->nodestore, childNodeId);
+    if(!child)
+        return false;
+
+    /* Look for the reference making the child mandatory */
+    return (UA_Node_findReference(child, &hasModellingRuleId, false, &mandatoryId) <
+            child->referencesSize);
+}
+
+static void
+deleteInstantiationPlan(UA_InstantiationPlan *plan) {
+    for(size_t i = 0; i < plan->membersSize; ++i) {
+        UA_InstantiationMember *member = &plan->members[i];
+        UA_NodeId_deleteMembers(&member->nodeId);
+        UA_NodeId_deleteMembers(&member->referenceTypeId);
+        UA_QualifiedName_deleteMembers(&member->browseName);
+    }
+    UA_free(plan->members);
+    UA_NodeId_deleteMembers(&plan->source);
+    UA_free(plan);
+}
+
+static void
+releaseInstantiationPlan(UA_Server *server, UA_InstantiationPlan *plan) {
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&server->instantiationPlans.mutex);
+#endif
+    UA_Boolean unused = (--plan->refCount == 0);
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&server->instantiationPlans.mutex);
+#endif
+    if(unused)
+        deleteInstantiationPlan(plan);
+}
+
+static UA_InstantiationPlan **
+findInstantiationPlan(UA_InstantiationPlan **plans, size_t plansSize,
+                      const UA_NodeId *source) {
+    size_t mask = plansSize - 1;
+    size_t s = UA_NodeId_hash(source) & mask;
+    while(plans[s] && !UA_NodeId_equal(&plans[s]->source, source))
+        s = (s + 1) & mask;
+    return &plans[s];
+}
+
+/* Appends the mandatory Aggregates children of the node to the plan */
+static UA_StatusCode
+addInstantiationMembers(UA_Server *server, UA_Session *session,
+                        UA_InstantiationPlan *plan, const UA_NodeId *nodeId) {
+    UA_BrowseDescription bd;
+    UA_BrowseDescription_init(&bd);
+    bd.nodeId = *nodeId;
+    bd.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_AGGREGATES);
+    bd.includeSubtypes = true;
+    bd.browseDirection = UA_BROWSEDIRECTION_FORWARD;
+    bd.nodeClassMask = UA_NODECLASS_OBJECT | UA_NODECLASS_VARIABLE | UA_NODECLASS_METHOD;
+    bd.resultMask = UA_BROWSERESULTMASK_REFERENCETYPEID | UA_BROWSERESULTMASK_NODECLASS |
+        UA_BROWSERESULTMASK_BROWSENAME;
+
+    UA_BrowseResult br;
+    UA_BrowseResult_init(&br);
+    Service_Browse_single(server, session, NULL, &bd, 0, &br);
+    UA_StatusCode retval = br.statusCode;
+    if(retval != UA_STATUSCODE_GOOD || br.referencesSize == 0)
+        goto cleanup;
+
+    UA_InstantiationMember *members = (UA_InstantiationMember*)
+        UA_realloc(plan->members, (plan->membersSize + br.referencesSize) *
+                   sizeof(UA_InstantiationMember));
+    if(!members) {
+        retval = UA_STATUSCODE_BADOUTOFMEMORY;
+        goto cleanup;
+    }
+    plan->members = members;
+
+    /* Take over the content of the reference descriptions */
+    for(size_t i = 0; i < br.referencesSize; ++i) {
+        UA_ReferenceDescription *rd = &br.references[i];
+        if(!mandatoryChild(server, session, &rd->nodeId.nodeId))
+            continue;
+        UA_InstantiationMember *member = &plan->members[plan->membersSize++];
+        member->nodeId = rd->nodeId.nodeId;
+        member->referenceTypeId = rd->referenceTypeId;
+        member->browseName = rd->browseName;
+        member->nodeClass = rd->nodeClass;
+        UA_NodeId_init(&rd->nodeId.nodeId);
+        UA_NodeId_init(&rd->referenceTypeId);
+        UA_QualifiedName_init(&rd->browseName);
+    }
+
+ cleanup:
+    UA_BrowseResult_deleteMembers(&br);
+    return retval;
+}
+
+/* The plan of a type contains the members of the type and its supertypes in
+ * the order of the type hierarchy. The plan of an instance declaration contains
+ * only its own members. */
+static UA_StatusCode
+buildInstantiationPlan(UA_Server *server, UA_Session *session, const UA_Node *source,
+                       UA_InstantiationPlan **outPlan) {
+    UA_InstantiationPlan *plan = (UA_InstantiationPlan*)
+        UA_calloc(1, sizeof(UA_InstantiationPlan));
+    if(!plan)
+        return UA_STATUSCODE_BADOUTOFMEMORY;
+    plan->refCount = 1;
+    UA_StatusCode retval = UA_NodeId_copy(&source->nodeId, &plan->source);
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_free(plan);
+        return retval;
+    }
+
+    if(source->nodeClass == UA_NODECLASS_OBJECTTYPE ||
+       source->nodeClass == UA_NODECLASS_VARIABLETYPE) {
+        UA_NodeId *hierarchy = NULL;
+        size_t hierarchySize = 0;
+        retval = getTypeHierarchy(server->nodestore, source, true,
+                                  &hierarchy, &hierarchySize);
+        for(size_t i = 0; i < hierarchySize && retval == UA_STATUSCODE_GOOD; ++i)
+            retval = addInstantiationMembers(server, session, plan, &hierarchy[i]);
+        UA_Array_delete(hierarchy, hierarchySize, &UA_TYPES[UA_TYPES_NODEID]);
+    } else {
+        retval = addInstantiationMembers(server, session, plan, &source->nodeId);
+    }
+
+    if(retval != UA_STATUSCODE_GOOD) {
+        deleteInstantiationPlan(plan);
+        return retval;
+    }
+    *outPlan = plan;
+    return UA_STATUSCODE_GOOD;
+}
+
+/* Returns the cached plan for the source node or builds and caches a new one.
+ * The plan needs to be released after use. */
+static UA_StatusCode
+getInstantiationPlan(UA_Server *server, UA_Session *session, const UA_Node *source,
+                     UA_InstantiationPlan **outPlan) {
+    UA_InstantiationPlanCache *cache = &server->instantiationPlans;
+    UA_InstantiationPlan *plan = NULL;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    if(cache->plansCount > 0)
+        plan = *findInstantiationPlan(cache->plans, cache->plansSize, &source->nodeId);
+    if(plan)
+        ++plan->refCount;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+    if(plan) {
+        *outPlan = plan;
+        return UA_STATUSCODE_GOOD;
+    }
+
+    /* Build the plan outside the lock. Browsing may take a while. */
+    UA_StatusCode retval = buildInstantiationPlan(server, session, source, &plan);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    *outPlan = plan;
+
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    /* Grow the table. If this fails, the plan is used once without caching. */
+    if((cache->plansCount + 1) * 2 > cache->plansSize) {
+        size_t size = cache->plansSize > 0 ? cache->plansSize * 2 : 16;
+        UA_InstantiationPlan **plans = (UA_InstantiationPlan**)
+            UA_calloc(size, sizeof(UA_InstantiationPlan*));
+        if(!plans)
+            goto finish;
+        for(size_t i = 0; i < cache->plansSize; ++i) {
+            if(cache->plans[i])
+                *findInstantiationPlan(plans, size, &cache->plans[i]->source) =
+                    cache->plans[i];
+        }
+        UA_free(cache->plans);
+        cache->plans = plans;
+        cache->plansSize = size;
+    }
+
+    /* Another thread may have inserted a plan in the meantime */
+    UA_InstantiationPlan **slot =
+        findInstantiationPlan(cache->plans, cache->plansSize, &source->nodeId);
+    if(*slot) {
+        ++(*slot)->refCount;
+        *outPlan = *slot;
+    } else {
+        ++plan->refCount;
+        *slot = plan;
+        ++cache->plansCount;
+        plan = NULL;
+    }
+
+ finish:
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+    if(plan && plan != *outPlan)
+        deleteInstantiationPlan(plan);
+    return UA_STATUSCODE_GOOD;
+}
+
+static void
+dropInstantiationPlans(UA_InstantiationPlanCache *cache) {
+    for(size_t i = 0; i < cache->plansSize; ++i) {
+        UA_InstantiationPlan *plan = cache->plans[i];
+        if(!plan)
+            continue;
+        if(--plan->refCount == 0)
+            deleteInstantiationPlan(plan);
+        cache->plans[i] = NULL;
+    }
+    cache->plansCount = 0;
+}
+
+void
+invalidateInstantiationPlans(UA_Server *server) {
+    UA_InstantiationPlanCache *cache = &server->instantiationPlans;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    dropInstantiationPlans(cache);
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+}
+
+static UA_Boolean
+isInstantiationPlanSource(UA_Server *server, const UA_NodeId *nodeId) {
+    UA_InstantiationPlanCache *cache = &server->instantiationPlans;
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    UA_Boolean found = (cache->plansCount > 0 &&
+                        *findInstantiationPlan(cache->plans, cache->plansSize, nodeId));
+#ifdef UA_ENABLE_MULTITHREADING
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+    return found;
+}
+
+void
+deleteInstantiationPlans(UA_Server *server) {
+    UA_InstantiationPlanCache *cache = &server->instantiationPlans;
+    dropInstantiationPlans(cache);
+    UA_free(cache->plans);
+    cache->plans = NULL;
+    cache->plansSize = 0;
+}
+
 /************/
 /* Add Node */
 /************/
 
 static void
 Service_AddNodes_single(UA_Server *server, UA_Session *session,
-                        const UA_AddNodesItem *item, UA_AddNodesResult *result,
+                        const UA_AddNodesItem *item, UA_Boolean move,
+                        UA_AddNodesResult *result,
                         UA_InstantiationCallback *instantiationCallback);
 
 static UA_StatusCode
@@ -21285,6 +26241,11 @@ copyChildNodesToNode(UA_Server *server, UA_Session *session,
                      const UA_NodeId *sourceNodeId, const UA_NodeId *destinationNodeId,
                      UA_InstantiationCallback *instantiationCallback);
 
+static UA_StatusCode
+applyInstantiationPlan(UA_Server *server, UA_Session *session,
+                       const UA_InstantiationPlan *plan, const UA_NodeId *destinationNodeId,
+                       UA_InstantiationCallback *instantiationCallback);
+
 /* copy an existing variable under the given parent. then instantiate the
  * variable for its type */
 static UA_StatusCode
@@ -21341,7 +26302,7 @@ copyExistingVariable(UA_Server *server, UA_Session *session, const UA_NodeId *va
     /* Add the variable and instantiate the children */
     UA_AddNodesResult res;
     UA_AddNodesResult_init(&res);
-    Service_AddNodes_single(server, session, &item, &res, instantiationCallback);
+    Service_AddNodes_single(server, session, &item, false, &res, instantiationCallback);
     if(res.statusCode != UA_STATUSCODE_GOOD) {
         retval = res.statusCode;
         goto cleanup;
@@ -21399,7 +26360,7 @@ copyExistingObject(UA_Server *server, UA_Session *session, const UA_NodeId *obje
     /* add the new object */
     UA_AddNodesResult res;
     UA_AddNodesResult_init(&res);
-    Service_AddNodes_single(server, session, &item, &res, instantiationCallback);
+    Service_AddNodes_single(server, session, &item, false, &res, instantiationCallback);
     if(res.statusCode != UA_STATUSCODE_GOOD)
         return res.statusCode;
 
@@ -21425,38 +26386,36 @@ setObjectInstanceHandle(UA_Server *server, UA_Session *session,
     return UA_STATUSCODE_GOOD;
 }
 
+/* See if the type node is correct */
 static UA_StatusCode
-instantiateNode(UA_Server *server, UA_Session *session, const UA_NodeId *nodeId,
-                UA_NodeClass nodeClass, const UA_NodeId *typeId,
-                UA_InstantiationCallback *instantiationCallback) {
-    /* see if the type node is correct */
-    const UA_Node *typenode = UA_NodeStore_get(server->nodestore, typeId);
-    if(!typenode)
+checkTypeDefinition(UA_Server *server, UA_NodeClass nodeClass, const UA_NodeId *typeId,
+                    const UA_Node **typenode) {
+    const UA_Node *type = UA_NodeStore_get(server->nodestore, typeId);
+    if(!type)
         return UA_STATUSCODE_BADTYPEDEFINITIONINVALID;
     if(nodeClass == UA_NODECLASS_VARIABLE) {
-        if(typenode->nodeClass != UA_NODECLASS_VARIABLETYPE ||
-           ((const UA_VariableTypeNode*)typenode)->isAbstract)
+        if(type->nodeClass != UA_NODECLASS_VARIABLETYPE ||
+           ((const UA_VariableTypeNode*)type)->isAbstract)
             return UA_STATUSCODE_BADTYPEDEFINITIONINVALID;
     } else if(nodeClass == UA_NODECLASS_OBJECT) {
-        if(typenode->nodeClass != UA_NODECLASS_OBJECTTYPE ||
-           ((const UA_ObjectTypeNode*)typenode)->isAbstract)
+        if(type->nodeClass != UA_NODECLASS_OBJECTTYPE ||
+           ((const UA_ObjectTypeNode*)type)->isAbstract)
             return UA_STATUSCODE_BADTYPEDEFINITIONINVALID;
     } else {
         return UA_STATUSCODE_BADTYPEDEFINITIONINVALID;
     }
+    *typenode = type;
+    return UA_STATUSCODE_GOOD;
+}
 
-    /* Get the hierarchy of the type and all its supertypes */
-    UA_NodeId *hierarchy = NULL;
-    size_t hierarchySize = 0;
-    UA_StatusCode retval =
-        getTypeHierarchy(server->nodestore, typenode, true, &hierarchy, &hierarchySize);
-    if(retval != UA_STATUSCODE_GOOD)
-        return retval;
-
+/* Copy the members of the type hierarchy and call the object constructor */
+static UA_StatusCode
+instantiateChildren(UA_Server *server, UA_Session *session, const UA_NodeId *nodeId,
+                    const UA_Node *typenode, const UA_InstantiationPlan *plan,
+                    UA_InstantiationCallback *instantiationCallback) {
     /* Copy members of the type and supertypes */
-    for(size_t i = 0; i < hierarchySize; ++i)
-        retval |= copyChildNodesToNode(server, session, &hierarchy[i], nodeId, instantiationCallback);
-    UA_Array_delete(hierarchy, hierarchySize, &UA_TYPES[UA_TYPES_NODEID]);
+    UA_StatusCode retval = applyInstantiationPlan(server, session, plan, nodeId,
+                                                  instantiationCallback);
     if(retval != UA_STATUSCODE_GOOD)
         return retval;
 
@@ -21469,6 +26428,29 @@ instantiateNode(UA_Server *server, UA_Session *session, const UA_NodeId *nodeId,
                                (UA_EditNodeCallback)setObjectInstanceHandle,
                                olm->constructor);
     }
+    return UA_STATUSCODE_GOOD;
+}
+
+static UA_StatusCode
+instantiateNode(UA_Server *server, UA_Session *session, const UA_NodeId *nodeId,
+                UA_NodeClass nodeClass, const UA_NodeId *typeId,
+                UA_InstantiationCallback *instantiationCallback) {
+    const UA_Node *typenode;
+    UA_StatusCode retval = checkTypeDefinition(server, nodeClass, typeId, &typenode);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+
+    /* Get the members of the type and all its supertypes */
+    UA_InstantiationPlan *plan;
+    retval = getInstantiationPlan(server, session, typenode, &plan);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+
+    retval = instantiateChildren(server, session, nodeId, typenode, plan,
+                                 instantiationCallback);
+    releaseInstantiationPlan(server, plan);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
 
     /* Add a hasType reference */
     UA_AddReferencesItem addref;
@@ -21516,96 +26498,83 @@ instanceFindAggregateByBrowsename(UA_Server *server, UA_Session *session,
     return retval;
 }
 
-static UA_Boolean
-mandatoryChild(UA_Server *server, UA_Session *session, const UA_NodeId *childNodeId) {
-    const UA_NodeId mandatoryId = UA_NODEID_NUMERIC(0, UA_NS0ID_MODELLINGRULE_MANDATORY);
-    const UA_NodeId hasModellingRuleId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASMODELLINGRULE);
-
-    /* Get the child */
-    const UA_Node *child = UA_NodeStore_get(server->nodestore, childNodeId);
-    if(!child)
-        return false;
-
-    /* Look for the reference making the child mandatory */
-    for(size_t i = 0; i < child->referencesSize; ++i) {
-        UA_ReferenceNode *ref = &child->references[i];
-        if(!UA_NodeId_equal(&hasModellingRuleId, &ref->referenceTypeId))
-            continue;
-        if(!UA_NodeId_equal(&mandatoryId, &ref->targetId.nodeId))
+/* Search for an instance of "browseName" among the Aggregates children of the
+ * node. Uses the index over the BrowseNames of the children if available. */
+static UA_StatusCode
+findInstanceMember(UA_Server *server, UA_Session *session, const UA_NodeId *instance,
+                   const UA_QualifiedName *browseName, UA_NodeId *outInstanceNodeId) {
+    const UA_NodeId aggregatesId = UA_NODEID_NUMERIC(0, UA_NS0ID_AGGREGATES);
+    const UA_Node *aggregates = UA_NodeStore_get(server->nodestore, &aggregatesId);
+    const UA_TypeClosure *closure = aggregates ? getTypeClosure(server, aggregates) : NULL;
+    if(!closure)
+        return instanceFindAggregateByBrowsename(server, session, instance,
+                                                 browseName, outInstanceNodeId);
+
+    const UA_Node *node = UA_NodeStore_get(server->nodestore, instance);
+    if(!node)
+        return UA_STATUSCODE_BADNODEIDUNKNOWN;
+    UA_ReferenceIterator it;
+    UA_ReferenceIterator_initSubtypes(&it, node, UA_BROWSEDIRECTION_FORWARD, closure);
+    UA_ReferenceIterator_setTargetName(&it, browseName);
+    const UA_ReferenceNode *ref;
+    while((ref = UA_ReferenceIterator_next(&it))) {
+        if(ref->targetId.serverIndex != 0)
             continue;
-        if(ref->isInverse)
+        const UA_Node *target = UA_NodeStore_get(server->nodestore, &ref->targetId.nodeId);
+        if(!target || !(target->nodeClass & (UA_NODECLASS_OBJECT | UA_NODECLASS_VARIABLE |
+                                             UA_NODECLASS_METHOD)))
             continue;
-        return true;
+        if(target->browseName.namespaceIndex == browseName->namespaceIndex &&
+           UA_String_equal(&target->browseName.name, &browseName->name))
+            return UA_NodeId_copy(&target->nodeId, outInstanceNodeId);
     }
-    return false;
+    return UA_STATUSCODE_GOOD;
 }
 
-/* Copy any children of Node sourceNodeId to another node destinationNodeId
- * Used at 2 places:
- *  (1) During instantiation, when any children of the Type are copied
+/* Copy the mandatory members of the plan to the node destinationNodeId. Used
+ * at 2 places:
+ *  (1) During instantiation, when the members of the Type are copied
  *  (2) During instantiation to copy any *nested* instances to the new node
  *      (2.1) Might call instantiation of a type first
  *      (2.2) *Should* then overwrite nested contents in definition --> this scenario is currently not handled!
  */
 static UA_StatusCode
-copyChildNodesToNode(UA_Server* server, UA_Session* session,
-                     const UA_NodeId* sourceNodeId, const UA_NodeId* destinationNodeId,
-                     UA_InstantiationCallback* instantiationCallback) {
-    /* Browse to get all children */
-    UA_BrowseDescription bd;
-    UA_BrowseDescription_init(&bd);
-    bd.nodeId = *sourceNodeId;
-    bd.referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_AGGREGATES);
-    bd.includeSubtypes = true;
-    bd.browseDirection = UA_BROWSEDIRECTION_FORWARD;
-    bd.nodeClassMask = UA_NODECLASS_OBJECT | UA_NODECLASS_VARIABLE | UA_NODECLASS_METHOD;
-    bd.resultMask = UA_BROWSERESULTMASK_REFERENCETYPEID | UA_BROWSERESULTMASK_NODECLASS |
-        UA_BROWSERESULTMASK_BROWSENAME;
-
-    UA_BrowseResult br;
-    UA_BrowseResult_init(&br);
-    Service_Browse_single(server, session, NULL, &bd, 0, &br);
-    if(br.statusCode != UA_STATUSCODE_GOOD)
-        return br.statusCode;
-
-    /* Copy all children */
+applyInstantiationPlan(UA_Server *server, UA_Session *session,
+                       const UA_InstantiationPlan *plan, const UA_NodeId *destinationNodeId,
+                       UA_InstantiationCallback *instantiationCallback) {
     UA_StatusCode retval = UA_STATUSCODE_GOOD;
     UA_NodeId existingChild = UA_NODEID_NULL;
-    for(size_t i = 0; i < br.referencesSize; ++i) {
-        UA_ReferenceDescription *rd = &br.references[i];
-
-        /* Is the child mandatory? If not, skip */
-        if(!mandatoryChild(server, session, &rd->nodeId.nodeId))
-            continue;
+    for(size_t i = 0; i < plan->membersSize; ++i) {
+        const UA_InstantiationMember *member = &plan->members[i];
 
         /* TODO: If a child is optional, check whether optional children that
          * were manually added fit the constraints. */
 
         /* Check for deduplication */
-        retval = instanceFindAggregateByBrowsename(server, session, destinationNodeId,
-                                                   &rd->browseName, &existingChild);
+        retval = findInstanceMember(server, session, destinationNodeId,
+                                    &member->browseName, &existingChild);
         if(retval != UA_STATUSCODE_GOOD)
             break;
 
         if(UA_NodeId_equal(&UA_NODEID_NULL, &existingChild)) {
             /* New node in child */
-            if(rd->nodeClass == UA_NODECLASS_METHOD) {
+            if(member->nodeClass == UA_NODECLASS_METHOD) {
                 /* add a reference to the method in the objecttype */
                 UA_AddReferencesItem newItem;
                 UA_AddReferencesItem_init(&newItem);
                 newItem.sourceNodeId = *destinationNodeId;
-                newItem.referenceTypeId = rd->referenceTypeId;
+                newItem.referenceTypeId = member->referenceTypeId;
                 newItem.isForward = true;
-                newItem.targetNodeId = rd->nodeId;
+                newItem.targetNodeId.nodeId = member->nodeId;
                 newItem.targetNodeClass = UA_NODECLASS_METHOD;
                 retval = addReference(server, session, &newItem);
-            } else if(rd->nodeClass == UA_NODECLASS_VARIABLE)
-                retval = copyExistingVariable(server, session, &rd->nodeId.nodeId,
-                                              &rd->referenceTypeId, destinationNodeId,
+            } else if(member->nodeClass == UA_NODECLASS_VARIABLE)
+                retval = copyExistingVariable(server, session, &member->nodeId,
+                                              &member->referenceTypeId, destinationNodeId,
                                               instantiationCallback);
-            else if(rd->nodeClass == UA_NODECLASS_OBJECT)
-                retval = copyExistingObject(server, session, &rd->nodeId.nodeId,
-                                            &rd->referenceTypeId, destinationNodeId,
+            else if(member->nodeClass == UA_NODECLASS_OBJECT)
+                retval = copyExistingObject(server, session, &member->nodeId,
+                                            &member->referenceTypeId, destinationNodeId,
                                             instantiationCallback);
         } else {
             /* Preexistent node in child
@@ -21614,12 +26583,12 @@ copyChildNodesToNode(UA_Server* server, UA_Session* session,
              *   supertypes would instantiate
              * - Always copy contents of template *into* existant node (merge
              *   contents of e.g. Folders like ParameterSet) */
-            if(rd->nodeClass == UA_NODECLASS_METHOD) {
+            if(member->nodeClass == UA_NODECLASS_METHOD) {
                 /* Do nothing, existent method wins */
-            } else if(rd->nodeClass == UA_NODECLASS_VARIABLE ||
-                      rd->nodeClass == UA_NODECLASS_OBJECT) {
-                if(!UA_NodeId_equal(&rd->nodeId.nodeId, &existingChild))
-                    retval = copyChildNodesToNode(server, session, &rd->nodeId.nodeId,
+            } else if(member->nodeClass == UA_NODECLASS_VARIABLE ||
+                      member->nodeClass == UA_NODECLASS_OBJECT) {
+                if(!UA_NodeId_equal(&member->nodeId, &existingChild))
+                    retval = copyChildNodesToNode(server, session, &member->nodeId,
                                                   &existingChild, instantiationCallback);
             }
             UA_NodeId_deleteMembers(&existingChild);
@@ -21627,7 +26596,25 @@ copyChildNodesToNode(UA_Server* server, UA_Session* session,
         if(retval != UA_STATUSCODE_GOOD)
             break;
     }
-    UA_BrowseResult_deleteMembers(&br);
+    return retval;
+}
+
+/* Copy the mandatory children of Node sourceNodeId to another node
+ * destinationNodeId */
+static UA_StatusCode
+copyChildNodesToNode(UA_Server* server, UA_Session* session,
+                     const UA_NodeId* sourceNodeId, const UA_NodeId* destinationNodeId,
+                     UA_InstantiationCallback* instantiationCallback) {
+    const UA_Node *source = UA_NodeStore_get(server->nodestore, sourceNodeId);
+    if(!source)
+        return UA_STATUSCODE_BADNODEIDUNKNOWN;
+    UA_InstantiationPlan *plan;
+    UA_StatusCode retval = getInstantiationPlan(server, session, source, &plan);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    retval = applyInstantiationPlan(server, session, plan, destinationNodeId,
+                                    instantiationCallback);
+    releaseInstantiationPlan(server, plan);
     return retval;
 }
 
@@ -21731,14 +26718,30 @@ Service_AddNodes_existing(UA_Server *server, UA_Session *session, UA_Node *node,
 /* Create nodes from attribute description */
 /*******************************************/
 
+/* If move is set, the strings and values of the attributes are moved into the
+ * node instead of being copied */
 static UA_StatusCode
 copyStandardAttributes(UA_Node *node, const UA_AddNodesItem *item,
-                       const UA_NodeAttributes *attr) {
+                       UA_NodeAttributes *attr, UA_Boolean move) {
     UA_StatusCode retval;
     retval  = UA_NodeId_copy(&item->requestedNewNodeId.nodeId, &node->nodeId);
     retval |= UA_QualifiedName_copy(&item->browseName, &node->browseName);
-    retval |= UA_LocalizedText_copy(&attr->displayName, &node->displayName);
-    retval |= UA_LocalizedText_copy(&attr->description, &node->description);
+#ifdef UA_ENABLE_COMPACT_NODES
+    /* Leave out the text if the DisplayName is the same as the BrowseName */
+    if(UA_String_equal(&attr->displayName.text, &item->browseName.name)) {
+        UA_LocalizedText displayName = attr->displayName;
+        displayName.text = UA_STRING_NULL;
+        retval |= UA_Node_copyText(&displayName, &node->displayName);
+    } else
+#endif
+    if(move)
+        UA_Node_moveText(&attr->displayName, &node->displayName);
+    else
+        retval |= UA_Node_copyText(&attr->displayName, &node->displayName);
+    if(move)
+        UA_Node_moveText(&attr->description, &node->description);
+    else
+        retval |= UA_Node_copyText(&attr->description, &node->description);
     node->writeMask = attr->writeMask;
     node->userWriteMask = attr->userWriteMask;
     return retval;
@@ -21747,7 +26750,7 @@ copyStandardAttributes(UA_Node *node, const UA_AddNodesItem *item,
 static UA_StatusCode
 copyCommonVariableAttributes(UA_Server *server, UA_VariableNode *node,
                              const UA_AddNodesItem *item,
-                             const UA_VariableAttributes *attr) {
+                             UA_VariableAttributes *attr, UA_Boolean move) {
     const UA_NodeId basevartype = UA_NODEID_NUMERIC(0, UA_NS0ID_BASEVARIABLETYPE);
     const UA_NodeId basedatavartype = UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATAVARIABLETYPE);
     const UA_NodeId *typeDef = &item->typeDefinition.nodeId;
@@ -21781,7 +26784,10 @@ copyCommonVariableAttributes(UA_Server *server, UA_VariableNode *node,
     /* Set the array dimensions. Check only against the vt. */
     retval = compatibleArrayDimensions(vt->arrayDimensionsSize, vt->arrayDimensions,
                                        attr->arrayDimensionsSize, attr->arrayDimensions);
-    if(retval == UA_STATUSCODE_GOOD) {
+    if(retval == UA_STATUSCODE_GOOD && move && attr->arrayDimensionsSize > 0) {
+        node->arrayDimensions = attr->arrayDimensions;
+        attr->arrayDimensions = NULL;
+    } else if(retval == UA_STATUSCODE_GOOD) {
         retval = UA_Array_copy(attr->arrayDimensions, attr->arrayDimensionsSize,
                                (void**)&node->arrayDimensions, &UA_TYPES[UA_TYPES_UINT32]);
     }
@@ -21792,6 +26798,8 @@ copyCommonVariableAttributes(UA_Server *server, UA_VariableNode *node,
         return retval;
     }
     node->arrayDimensionsSize = attr->arrayDimensionsSize;
+    if(move)
+        attr->arrayDimensionsSize = 0;
 
     /* Set the valuerank */
     if(attr->valueRank != 0 || !UA_Variant_isScalar(&attr->value))
@@ -21805,6 +26813,12 @@ copyCommonVariableAttributes(UA_Server *server, UA_VariableNode *node,
         return retval;
     }
 
+    /* Move the value into the node. Values that are converted to the DataType
+     * of the node are copied below. */
+    if(move && attr->value.type && attr->value.storageType == UA_VARIANT_DATA &&
+       moveValueAttribute(server, node, &attr->value) == UA_STATUSCODE_GOOD)
+        return UA_STATUSCODE_GOOD;
+
     /* Set the value */
     UA_DataValue value;
     UA_DataValue_init(&value);
@@ -21836,21 +26850,21 @@ copyCommonVariableAttributes(UA_Server *server, UA_VariableNode *node,
 static UA_StatusCode
 copyVariableNodeAttributes(UA_Server *server, UA_VariableNode *vnode,
                            const UA_AddNodesItem *item,
-                           const UA_VariableAttributes *attr) {
+                           UA_VariableAttributes *attr, UA_Boolean move) {
     vnode->accessLevel = attr->accessLevel;
     vnode->userAccessLevel = attr->userAccessLevel;
     vnode->historizing = attr->historizing;
     vnode->minimumSamplingInterval = attr->minimumSamplingInterval;
-    return copyCommonVariableAttributes(server, vnode, item, attr);
+    return copyCommonVariableAttributes(server, vnode, item, attr, move);
 }
 
 static UA_StatusCode
 copyVariableTypeNodeAttributes(UA_Server *server, UA_VariableTypeNode *vtnode,
                                const UA_AddNodesItem *item,
-                               const UA_VariableTypeAttributes *attr) {
+                               UA_VariableTypeAttributes *attr, UA_Boolean move) {
     vtnode->isAbstract = attr->isAbstract;
     return copyCommonVariableAttributes(server, (UA_VariableNode*)vtnode, item,
-                                        (const UA_VariableAttributes*)attr);
+                                        (UA_VariableAttributes*)attr, move);
 }
 
 static UA_StatusCode
@@ -21861,10 +26875,13 @@ copyObjectNodeAttributes(UA_ObjectNode *onode, const UA_ObjectAttributes *attr)
 
 static UA_StatusCode
 copyReferenceTypeNodeAttributes(UA_ReferenceTypeNode *rtnode,
-                                const UA_ReferenceTypeAttributes *attr) {
+                                UA_ReferenceTypeAttributes *attr, UA_Boolean move) {
     rtnode->isAbstract = attr->isAbstract;
     rtnode->symmetric = attr->symmetric;
-    return UA_LocalizedText_copy(&attr->inverseName, &rtnode->inverseName);
+    if(!move)
+        return UA_Node_copyText(&attr->inverseName, &rtnode->inverseName);
+    UA_Node_moveText(&attr->inverseName, &rtnode->inverseName);
+    return UA_STATUSCODE_GOOD;
 }
 
 static UA_StatusCode
@@ -21895,7 +26912,8 @@ copyDataTypeNodeAttributes(UA_DataTypeNode *dtnode,
     }
 
 static UA_StatusCode
-createNodeFromAttributes(UA_Server *server, const UA_AddNodesItem *item, UA_Node **newNode) {
+createNodeFromAttributes(UA_Server *server, const UA_AddNodesItem *item,
+                         UA_Boolean move, UA_Node **newNode) {
     /* Check that we can read the attributes */
     if(item->nodeAttributes.encoding < UA_EXTENSIONOBJECT_DECODED ||
        !item->nodeAttributes.content.decoded.type)
@@ -21909,7 +26927,7 @@ createNodeFromAttributes(UA_Server *server, const UA_AddNodesItem *item, UA_Node
 
     /* Copy the attributes into the node */
     void *data = item->nodeAttributes.content.decoded.data;
-    UA_StatusCode retval = copyStandardAttributes(node, item, data);
+    UA_StatusCode retval = copyStandardAttributes(node, item, data, move);
     switch(item->nodeClass) {
     case UA_NODECLASS_OBJECT:
         CHECK_ATTRIBUTES(OBJECTATTRIBUTES);
@@ -21917,7 +26935,7 @@ createNodeFromAttributes(UA_Server *server, const UA_AddNodesItem *item, UA_Node
         break;
     case UA_NODECLASS_VARIABLE:
         CHECK_ATTRIBUTES(VARIABLEATTRIBUTES);
-        retval |= copyVariableNodeAttributes(server, node, item, data);
+        retval |= copyVariableNodeAttributes(server, node, item, data, move);
         break;
     case UA_NODECLASS_OBJECTTYPE:
         CHECK_ATTRIBUTES(OBJECTTYPEATTRIBUTES);
@@ -21925,11 +26943,11 @@ createNodeFromAttributes(UA_Server *server, const UA_AddNodesItem *item, UA_Node
         break;
     case UA_NODECLASS_VARIABLETYPE:
         CHECK_ATTRIBUTES(VARIABLETYPEATTRIBUTES);
-        retval |= copyVariableTypeNodeAttributes(server, node, item, data);
+        retval |= copyVariableTypeNodeAttributes(server, node, item, data, move);
         break;
     case UA_NODECLASS_REFERENCETYPE:
         CHECK_ATTRIBUTES(REFERENCETYPEATTRIBUTES);
-        retval |= copyReferenceTypeNodeAttributes(node, data);
+        retval |= copyReferenceTypeNodeAttributes(node, data, move);
         break;
     case UA_NODECLASS_DATATYPE:
         CHECK_ATTRIBUTES(DATATYPEATTRIBUTES);
@@ -21952,119 +26970,570 @@ createNodeFromAttributes(UA_Server *server, const UA_AddNodesItem *item, UA_Node
     return retval;
 }
 
+/* If move is set, the members of the attributes are moved into the node where
+ * possible */
 static void
 Service_AddNodes_single(UA_Server *server, UA_Session *session,
-                        const UA_AddNodesItem *item, UA_AddNodesResult *result,
+                        const UA_AddNodesItem *item, UA_Boolean move,
+                        UA_AddNodesResult *result,
                         UA_InstantiationCallback *instantiationCallback) {
     /* Create the node from the attributes*/
     UA_Node *node = NULL;
-    result->statusCode = createNodeFromAttributes(server, item, &node);
+    result->statusCode = createNodeFromAttributes(server, item, move, &node);
+    if(result->statusCode != UA_STATUSCODE_GOOD) {
+        UA_LOG_INFO_SESSION(server->config.logger, session,
+                            "Could not add node with error code %s",
+                            UA_StatusCode_name(result->statusCode));
+        return;
+    }
+
+    /* Run consistency checks and add the node. The parent, reference type and
+     * type definition may be registered aliases of the session. */
+    UA_assert(node != NULL);
+    result->statusCode =
+        Service_AddNodes_existing(server, session, node,
+                                  UA_Session_resolveNodeId(session, &item->parentNodeId.nodeId),
+                                  UA_Session_resolveNodeId(session, &item->referenceTypeId),
+                                  UA_Session_resolveNodeId(session, &item->typeDefinition.nodeId),
+                                  instantiationCallback, &result->addedNodeId);
     if(result->statusCode != UA_STATUSCODE_GOOD) {
         UA_LOG_INFO_SESSION(server->config.logger, session,
                             "Could not add node with error code %s",
                             UA_StatusCode_name(result->statusCode));
+    }
+}
+
+void Service_AddNodes(UA_Server *server, UA_Session *session,
+                      const UA_AddNodesRequest *request,
+                      UA_AddNodesResponse *response) {
+    UA_LOG_DEBUG_SESSION(server->config.logger, session, "Processing AddNodesRequest");
+    if(request->nodesToAddSize <= 0) {
+        response->responseHeader.serviceResult = UA_STATUSCODE_BADNOTHINGTODO;
+        return;
+    }
+    size_t size = request->nodesToAddSize;
+
+    response->results = UA_Array_new(size, &UA_TYPES[UA_TYPES_ADDNODESRESULT]);
+    if(!response->results) {
+        response->responseHeader.serviceResult = UA_STATUSCODE_BADOUTOFMEMORY;
+        return;
+    }
+
+#ifdef UA_ENABLE_EXTERNAL_NAMESPACES
+#ifdef _MSC_VER
+    UA_Boolean *isExternal = UA_alloca(size);
+    UA_UInt32 *indices = UA_alloca(sizeof(UA_UInt32)*size);
+#else
+    UA_Boolean isExternal[size];
+    UA_UInt32 indices[size];
+#endif
+    memset(isExternal, false, sizeof(UA_Boolean) * size);
+    for(size_t j = 0; j <server->externalNamespacesSize; ++j) {
+        size_t indexSize = 0;
+        for(size_t i = 0;i < size;++i) {
+            if(request->nodesToAdd[i].requestedNewNodeId.nodeId.namespaceIndex !=
+               server->externalNamespaces[j].index)
+                continue;
+            isExternal[i] = true;
+            indices[indexSize] = (UA_UInt32)i;
+            ++indexSize;
+        }
+        if(indexSize == 0)
+            continue;
+        UA_ExternalNodeStore *ens = &server->externalNamespaces[j].externalNodeStore;
+        ens->addNodes(ens->ensHandle, &request->requestHeader,
+                      request->nodesToAdd, indices, (UA_UInt32)indexSize,
+                      response->results, response->diagnosticInfos);
+    }
+#endif
+
+    response->resultsSize = size;
+    for(size_t i = 0; i < size; ++i) {
+#ifdef UA_ENABLE_EXTERNAL_NAMESPACES
+        if(!isExternal[i])
+#endif
+            Service_AddNodes_single(server, session, &request->nodesToAdd[i], false,
+                                    &response->results[i], NULL);
+    }
+}
+
+static UA_StatusCode
+addNode(UA_Server *server, const UA_NodeClass nodeClass,
+        const UA_NodeId requestedNewNodeId, const UA_NodeId parentNodeId,
+        const UA_NodeId referenceTypeId, const UA_QualifiedName browseName,
+        const UA_NodeId typeDefinition, const UA_NodeAttributes *attr,
+        const UA_DataType *attributeType, UA_Boolean move,
+        UA_InstantiationCallback *instantiationCallback, UA_NodeId *outNewNodeId) {
+    /* prepare the item */
+    UA_AddNodesItem item;
+    UA_AddNodesItem_init(&item);
+    item.parentNodeId.nodeId = parentNodeId;
+    item.referenceTypeId = referenceTypeId;
+    item.requestedNewNodeId.nodeId = requestedNewNodeId;
+    item.browseName = browseName;
+    item.nodeClass = nodeClass;
+    item.typeDefinition.nodeId = typeDefinition;
+    item.nodeAttributes = (UA_ExtensionObject){
+        .encoding = UA_EXTENSIONOBJECT_DECODED_NODELETE,
+        .content.decoded = {attributeType, (void*)(uintptr_t)attr}};
+
+    /* run the service */
+    UA_AddNodesResult result;
+    UA_AddNodesResult_init(&result);
+    UA_RCU_LOCK();
+    Service_AddNodes_single(server, &adminSession, &item, move, &result,
+                            instantiationCallback);
+    UA_RCU_UNLOCK();
+
+    /* prepare the output */
+    if(outNewNodeId && result.statusCode == UA_STATUSCODE_GOOD)
+        *outNewNodeId = result.addedNodeId;
+    else
+        UA_NodeId_deleteMembers(&result.addedNodeId);
+    return result.statusCode;
+}
+
+UA_StatusCode
+__UA_Server_addNode(UA_Server *server, const UA_NodeClass nodeClass,
+                    const UA_NodeId requestedNewNodeId, const UA_NodeId parentNodeId,
+                    const UA_NodeId referenceTypeId, const UA_QualifiedName browseName,
+                    const UA_NodeId typeDefinition, const UA_NodeAttributes *attr,
+                    const UA_DataType *attributeType,
+                    UA_InstantiationCallback *instantiationCallback, UA_NodeId *outNewNodeId) {
+    return addNode(server, nodeClass, requestedNewNodeId, parentNodeId, referenceTypeId,
+                   browseName, typeDefinition, attr, attributeType, false,
+                   instantiationCallback, outNewNodeId);
+}
+
+UA_StatusCode
+__UA_Server_addNodeMove(UA_Server *server, const UA_NodeClass nodeClass,
+                        const UA_NodeId requestedNewNodeId, const UA_NodeId parentNodeId,
+                        const UA_NodeId referenceTypeId, const UA_QualifiedName browseName,
+                        const UA_NodeId typeDefinition, UA_NodeAttributes *attr,
+                        const UA_DataType *attributeType,
+                        UA_InstantiationCallback *instantiationCallback,
+                        UA_NodeId *outNewNodeId) {
+    UA_StatusCode retval =
+        addNode(server, nodeClass, requestedNewNodeId, parentNodeId, referenceTypeId,
+                browseName, typeDefinition, attr, attributeType, true,
+                instantiationCallback, outNewNodeId);
+    /* Delete what was not moved into the node */
+    UA_deleteMembers(attr, attributeType);
+    return retval;
+}
+
+/************************/
+/* Add Nodes in a Batch */
+/************************/
+
+/* Drops the cached subtype closures and instantiation plans affected by an
+ * added or removed reference */
+static void
+subtypeReferenceChanged(UA_Server *server, const UA_NodeId *sourceId,
+                        const UA_NodeId *referenceTypeId, UA_Boolean isForward,
+                        const UA_NodeId *targetId) {
+    const UA_NodeId *parentId = isForward ? sourceId : targetId;
+    UA_Boolean ns0 = (referenceTypeId->namespaceIndex == 0 &&
+                      referenceTypeId->identifierType == UA_NODEIDTYPE_NUMERIC);
+    if(ns0 && referenceTypeId->identifier.numeric == UA_NS0ID_HASSUBTYPE)
+        invalidateTypeClosures(server, parentId);
+
+    /* The plans depend on the type hierarchy, the modelling rules and the
+     * members of the types and instance declarations */
+    if(server->instantiationPlans.plansCount == 0)
+        return;
+    if(ns0 && (referenceTypeId->identifier.numeric == UA_NS0ID_HASSUBTYPE ||
+               referenceTypeId->identifier.numeric == UA_NS0ID_HASMODELLINGRULE)) {
+        invalidateInstantiationPlans(server);
+        return;
+    }
+    const UA_NodeId aggregatesId = UA_NODEID_NUMERIC(0, UA_NS0ID_AGGREGATES);
+    if(!isSubtypeOf(server, referenceTypeId, &aggregatesId))
+        return;
+    const UA_Node *parent = UA_NodeStore_get(server->nodestore, parentId);
+    if((parent && (parent->nodeClass == UA_NODECLASS_OBJECTTYPE ||
+                   parent->nodeClass == UA_NODECLASS_VARIABLETYPE)) ||
+       isInstantiationPlanSource(server, parentId))
+        invalidateInstantiationPlans(server);
+}
+
+/* References that are appended to a node with a single reallocation */
+typedef struct {
+    size_t referencesSize;
+    UA_ReferenceNode *references;
+} UA_ReferenceList;
+
+static UA_StatusCode
+addReferenceList(UA_Server *server, UA_Session *session, UA_Node *node,
+                 const UA_ReferenceList *list) {
+    UA_StatusCode retval = UA_Node_growReferences(node, list->referencesSize);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+    UA_ReferenceNode *refs = &node->references[node->referencesSize];
+    size_t i = 0;
+    for(; i < list->referencesSize; ++i) {
+        retval = UA_ReferenceNode_copy(&list->references[i], &refs[i]);
+        if(retval != UA_STATUSCODE_GOOD)
+            break;
+    }
+    if(retval != UA_STATUSCODE_GOOD) {
+        for(size_t j = 0; j < i; ++j)
+            UA_ReferenceNode_deleteMembers(&refs[j]);
+        return retval;
+    }
+    size_t first = node->referencesSize;
+    node->referencesSize += list->referencesSize;
+    UA_Node_indexReferences(node, first);
+    if(server)
+        UA_Node_nameReferenceTargets(node, server->nodestore);
+    return UA_STATUSCODE_GOOD;
+}
+
+/* The references to the parent and the type definition are added to the new
+ * node before it is inserted */
+static UA_StatusCode
+addBatchNodeReferences(UA_Node *node, const UA_AddNodesItem *item,
+                       const UA_NodeId *typeDefinition) {
+    UA_ReferenceNode refs[2];
+    UA_ReferenceList list = {0, refs};
+    if(!UA_NodeId_isNull(&item->parentNodeId.nodeId)) {
+        UA_ReferenceNode_init(&refs[list.referencesSize]);
+        refs[list.referencesSize].referenceTypeId = item->referenceTypeId;
+        refs[list.referencesSize].isInverse = true;
+        refs[list.referencesSize].targetId.nodeId = item->parentNodeId.nodeId;
+        ++list.referencesSize;
+    }
+    if(typeDefinition) {
+        UA_ReferenceNode_init(&refs[list.referencesSize]);
+        refs[list.referencesSize].referenceTypeId = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
+        refs[list.referencesSize].targetId.nodeId = *typeDefinition;
+        ++list.referencesSize;
+    }
+    if(list.referencesSize == 0)
+        return UA_STATUSCODE_GOOD;
+    return addReferenceList(NULL, NULL, node, &list);
+}
+
+/* The references pointing back to the new nodes are collected and added with
+ * one edit for each run of nodes with the same parent (or type definition) */
+typedef struct {
+    UA_NodeId target;
+    UA_ReferenceList list;
+    size_t capacity;
+} UA_PendingReferences;
+
+static UA_StatusCode
+flushPendingReferences(UA_Server *server, UA_Session *session,
+                       UA_PendingReferences *pending) {
+    if(pending->list.referencesSize == 0)
+        return UA_STATUSCODE_GOOD;
+    UA_StatusCode retval =
+        UA_Server_editNode(server, session, &pending->target,
+                           (UA_EditNodeCallback)addReferenceList, &pending->list);
+    for(size_t i = 0; i < pending->list.referencesSize; ++i) {
+        const UA_ReferenceNode *ref = &pending->list.references[i];
+        subtypeReferenceChanged(server, &pending->target, &ref->referenceTypeId,
+                                !ref->isInverse, &ref->targetId.nodeId);
+    }
+    for(size_t i = 0; i < pending->list.referencesSize; ++i)
+        UA_ReferenceNode_deleteMembers(&pending->list.references[i]);
+    pending->list.referencesSize = 0;
+    return retval;
+}
+
+static UA_StatusCode
+addPendingReference(UA_Server *server, UA_Session *session,
+                    UA_PendingReferences *pending, const UA_NodeId *target,
+                    const UA_NodeId *referenceTypeId, const UA_NodeId *nodeId,
+                    UA_Boolean isInverse) {
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    if(!UA_NodeId_equal(&pending->target, target)) {
+        retval = flushPendingReferences(server, session, pending);
+        UA_NodeId_deleteMembers(&pending->target);
+        retval |= UA_NodeId_copy(target, &pending->target);
+        if(retval != UA_STATUSCODE_GOOD)
+            return retval;
+    }
+    if(pending->list.referencesSize >= pending->capacity) {
+        size_t capacity = pending->capacity ? pending->capacity * 2 : 16;
+        UA_ReferenceNode *refs =
+            UA_realloc(pending->list.references, sizeof(UA_ReferenceNode) * capacity);
+        if(!refs)
+            return UA_STATUSCODE_BADOUTOFMEMORY;
+        pending->list.references = refs;
+        pending->capacity = capacity;
+    }
+    UA_ReferenceNode *ref = &pending->list.references[pending->list.referencesSize];
+    UA_ReferenceNode_init(ref);
+    retval = UA_NodeId_copy(referenceTypeId, &ref->referenceTypeId);
+    retval |= UA_NodeId_copy(nodeId, &ref->targetId.nodeId);
+    ref->isInverse = isInverse;
+    if(retval != UA_STATUSCODE_GOOD) {
+        UA_ReferenceNode_deleteMembers(ref);
+        return retval;
+    }
+    ++pending->list.referencesSize;
+    return UA_STATUSCODE_GOOD;
+}
+
+static void
+deletePendingReferences(UA_PendingReferences *pending) {
+    for(size_t i = 0; i < pending->list.referencesSize; ++i)
+        UA_ReferenceNode_deleteMembers(&pending->list.references[i]);
+    UA_free(pending->list.references);
+    UA_NodeId_deleteMembers(&pending->target);
+}
+
+/* The type definition of the previous node is reused for consecutive nodes of
+ * the same type */
+typedef struct {
+    UA_NodeClass nodeClass;
+    UA_NodeId typeId;
+    UA_StatusCode result;
+    UA_InstantiationPlan *plan;
+    UA_Boolean hasMembers;
+} UA_TypeCache;
+
+static void
+checkTypeCached(UA_Server *server, UA_Session *session, UA_TypeCache *cache,
+                UA_NodeClass nodeClass, const UA_NodeId *typeId) {
+    if(cache->nodeClass == nodeClass && UA_NodeId_equal(&cache->typeId, typeId))
+        return;
+    UA_NodeId_deleteMembers(&cache->typeId);
+    if(cache->plan)
+        releaseInstantiationPlan(server, cache->plan);
+    cache->plan = NULL;
+    cache->hasMembers = false;
+    cache->nodeClass = nodeClass;
+    cache->result = UA_NodeId_copy(typeId, &cache->typeId);
+    if(cache->result != UA_STATUSCODE_GOOD) {
+        cache->nodeClass = 0;
         return;
     }
 
-    /* Run consistency checks and add the node */
-    UA_assert(node != NULL);
-    result->statusCode = Service_AddNodes_existing(server, session, node, &item->parentNodeId.nodeId,
-                                                   &item->referenceTypeId, &item->typeDefinition.nodeId,
-                                                   instantiationCallback, &result->addedNodeId);
-    if(result->statusCode != UA_STATUSCODE_GOOD) {
-        UA_LOG_INFO_SESSION(server->config.logger, session,
-                            "Could not add node with error code %s",
-                            UA_StatusCode_name(result->statusCode));
+    const UA_Node *typenode;
+    cache->result = checkTypeDefinition(server, nodeClass, typeId, &typenode);
+    if(cache->result != UA_STATUSCODE_GOOD)
+        return;
+    cache->result = getInstantiationPlan(server, session, typenode, &cache->plan);
+    if(cache->result != UA_STATUSCODE_GOOD)
+        return;
+
+    /* Most types have no members to copy. Then the instantiation is skipped. */
+    cache->hasMembers = (cache->plan->membersSize > 0 ||
+                         (typenode->nodeClass == UA_NODECLASS_OBJECTTYPE &&
+                          ((const UA_ObjectTypeNode*)typenode)->lifecycleManagement.constructor));
+}
+
+static void
+deleteTypeCache(UA_Server *server, UA_TypeCache *cache) {
+    UA_NodeId_deleteMembers(&cache->typeId);
+    if(cache->plan)
+        releaseInstantiationPlan(server, cache->plan);
+}
+
+static const UA_NodeId *
+defaultTypeDefinition(const UA_AddNodesItem *item) {
+    static const UA_NodeId basedatavariabletype =
+        {0, UA_NODEIDTYPE_NUMERIC, {UA_NS0ID_BASEDATAVARIABLETYPE}};
+    static const UA_NodeId baseobjecttype =
+        {0, UA_NODEIDTYPE_NUMERIC, {UA_NS0ID_BASEOBJECTTYPE}};
+    if(item->nodeClass != UA_NODECLASS_VARIABLE &&
+       item->nodeClass != UA_NODECLASS_OBJECT)
+        return NULL;
+    if(!UA_NodeId_isNull(&item->typeDefinition.nodeId))
+        return &item->typeDefinition.nodeId;
+    if(item->nodeClass == UA_NODECLASS_VARIABLE)
+        return &basedatavariabletype;
+    return &baseobjecttype;
+}
+
+static void
+removeBatchNode(UA_Server *server, UA_Session *session, UA_Node *node,
+                UA_AddNodesResult *result, UA_StatusCode retval,
+                UA_Boolean deleteReferences) {
+    UA_LOG_INFO_SESSION(server->config.logger, session,
+                        "Could not add node with error code %s",
+                        UA_StatusCode_name(retval));
+    UA_NodeId nodeId; /* the node is freed during removal */
+    if(UA_NodeId_copy(&node->nodeId, &nodeId) == UA_STATUSCODE_GOOD) {
+        if(deleteReferences)
+            deleteNode(server, session, &nodeId, true);
+        else
+            UA_NodeStore_remove(server->nodestore, &nodeId);
+        UA_NodeId_deleteMembers(&nodeId);
     }
+    result->statusCode = retval;
 }
 
-void Service_AddNodes(UA_Server *server, UA_Session *session,
-                      const UA_AddNodesRequest *request,
-                      UA_AddNodesResponse *response) {
-    UA_LOG_DEBUG_SESSION(server->config.logger, session, "Processing AddNodesRequest");
-    if(request->nodesToAddSize <= 0) {
-        response->responseHeader.serviceResult = UA_STATUSCODE_BADNOTHINGTODO;
-        return;
-    }
-    size_t size = request->nodesToAddSize;
+static UA_StatusCode
+addNodes(UA_Server *server, const UA_AddNodesItem *items, size_t itemsSize,
+         UA_Boolean move, UA_InstantiationCallback *instantiationCallback,
+         UA_AddNodesResult *results) {
+    for(size_t i = 0; i < itemsSize; ++i)
+        UA_AddNodesResult_init(&results[i]);
+    if(itemsSize == 0)
+        return UA_STATUSCODE_GOOD;
 
-    response->results = UA_Array_new(size, &UA_TYPES[UA_TYPES_ADDNODESRESULT]);
-    if(!response->results) {
-        response->responseHeader.serviceResult = UA_STATUSCODE_BADOUTOFMEMORY;
-        return;
+    UA_Node **nodes = UA_calloc(itemsSize, sizeof(UA_Node*));
+    UA_Node **batch = UA_malloc(itemsSize * sizeof(UA_Node*));
+    UA_StatusCode *inserted = UA_malloc(itemsSize * sizeof(UA_StatusCode));
+    if(!nodes || !batch || !inserted) {
+        UA_free(nodes);
+        UA_free(batch);
+        UA_free(inserted);
+        return UA_STATUSCODE_BADOUTOFMEMORY;
     }
 
-#ifdef UA_ENABLE_EXTERNAL_NAMESPACES
-#ifdef _MSC_VER
-    UA_Boolean *isExternal = UA_alloca(size);
-    UA_UInt32 *indices = UA_alloca(sizeof(UA_UInt32)*size);
-#else
-    UA_Boolean isExternal[size];
-    UA_UInt32 indices[size];
-#endif
-    memset(isExternal, false, sizeof(UA_Boolean) * size);
-    for(size_t j = 0; j <server->externalNamespacesSize; ++j) {
-        size_t indexSize = 0;
-        for(size_t i = 0;i < size;++i) {
-            if(request->nodesToAdd[i].requestedNewNodeId.nodeId.namespaceIndex !=
-               server->externalNamespaces[j].index)
-                continue;
-            isExternal[i] = true;
-            indices[indexSize] = (UA_UInt32)i;
-            ++indexSize;
+    UA_Session *session = &adminSession;
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    UA_RCU_LOCK();
+
+    /* Create the nodes together with their own references */
+    size_t batchSize = 0;
+    for(size_t i = 0; i < itemsSize; ++i) {
+        const UA_AddNodesItem *item = &items[i];
+        UA_StatusCode res = createNodeFromAttributes(server, item, move, &nodes[i]);
+        if(res == UA_STATUSCODE_GOOD &&
+           nodes[i]->nodeId.namespaceIndex >= server->namespacesSize)
+            res = UA_STATUSCODE_BADNODEIDINVALID;
+        if(res == UA_STATUSCODE_GOOD)
+            res = addBatchNodeReferences(nodes[i], item, defaultTypeDefinition(item));
+        if(res != UA_STATUSCODE_GOOD) {
+            UA_LOG_INFO_SESSION(server->config.logger, session,
+                                "Could not add node with error code %s",
+                                UA_StatusCode_name(res));
+            if(nodes[i])
+                UA_NodeStore_deleteNode(nodes[i]);
+            nodes[i] = NULL;
+            results[i].statusCode = res;
+            continue;
         }
-        if(indexSize == 0)
+        batch[batchSize] = nodes[i];
+        ++batchSize;
+    }
+
+    /* Insert all nodes at once. Parents can be part of the batch. */
+    UA_NodeStore_insertBatch(server->nodestore, batch, batchSize, inserted);
+    for(size_t i = 0, j = 0; i < itemsSize; ++i) {
+        if(!nodes[i])
             continue;
-        UA_ExternalNodeStore *ens = &server->externalNamespaces[j].externalNodeStore;
-        ens->addNodes(ens->ensHandle, &request->requestHeader,
-                      request->nodesToAdd, indices, (UA_UInt32)indexSize,
-                      response->results, response->diagnosticInfos);
+        if(inserted[j] != UA_STATUSCODE_GOOD) {
+            UA_LOG_INFO_SESSION(server->config.logger, session,
+                                "AddNodes: Node could not be added to the nodestore "
+                                "with error code %s", UA_StatusCode_name(inserted[j]));
+            results[i].statusCode = inserted[j];
+            nodes[i] = NULL;
+        }
+        ++j;
     }
-#endif
 
-    response->resultsSize = size;
-    for(size_t i = 0; i < size; ++i) {
-#ifdef UA_ENABLE_EXTERNAL_NAMESPACES
-        if(!isExternal[i])
-#endif
-            Service_AddNodes_single(server, session, &request->nodesToAdd[i],
-                                    &response->results[i], NULL);
+    /* Validate the parent and type references. Consecutive nodes below the
+     * same parent share the check and the edit of the parent node. */
+    UA_PendingReferences parentRefs, typeRefs;
+    memset(&parentRefs, 0, sizeof(UA_PendingReferences));
+    memset(&typeRefs, 0, sizeof(UA_PendingReferences));
+    UA_TypeCache types;
+    memset(&types, 0, sizeof(UA_TypeCache));
+    const UA_AddNodesItem *lastParent = NULL;
+    UA_StatusCode lastParentResult = UA_STATUSCODE_GOOD;
+    const UA_NodeId hasTypeDefinition = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
+    for(size_t i = 0; i < itemsSize && retval == UA_STATUSCODE_GOOD; ++i) {
+        if(!nodes[i])
+            continue;
+        const UA_AddNodesItem *item = &items[i];
+        if(!lastParent || lastParent->nodeClass != item->nodeClass ||
+           !UA_NodeId_equal(&lastParent->parentNodeId.nodeId, &item->parentNodeId.nodeId) ||
+           !UA_NodeId_equal(&lastParent->referenceTypeId, &item->referenceTypeId)) {
+            lastParent = item;
+            lastParentResult = checkParentReference(server, session, item->nodeClass,
+                                                    &item->parentNodeId.nodeId,
+                                                    &item->referenceTypeId);
+        }
+        UA_StatusCode res = lastParentResult;
+        const UA_NodeId *typeDefinition = defaultTypeDefinition(item);
+        if(res == UA_STATUSCODE_GOOD && typeDefinition) {
+            checkTypeCached(server, session, &types, item->nodeClass, typeDefinition);
+            res = types.result;
+        }
+        if(res != UA_STATUSCODE_GOOD) {
+            removeBatchNode(server, session, nodes[i], &results[i], res, false);
+            nodes[i] = NULL;
+            continue;
+        }
+        if(!UA_NodeId_isNull(&item->parentNodeId.nodeId))
+            retval = addPendingReference(server, session, &parentRefs,
+                                         &item->parentNodeId.nodeId, &item->referenceTypeId,
+                                         &nodes[i]->nodeId, false);
+        if(typeDefinition)
+            retval |= addPendingReference(server, session, &typeRefs, typeDefinition,
+                                          &hasTypeDefinition, &nodes[i]->nodeId, true);
+    }
+    retval |= flushPendingReferences(server, session, &parentRefs);
+    retval |= flushPendingReferences(server, session, &typeRefs);
+    deletePendingReferences(&parentRefs);
+    deletePendingReferences(&typeRefs);
+
+    /* Instantiate the members of the type definitions and call the callback */
+    for(size_t i = 0; i < itemsSize; ++i) {
+        if(!nodes[i])
+            continue;
+        const UA_AddNodesItem *item = &items[i];
+        UA_StatusCode res = retval;
+        const UA_NodeId *typeDefinition = defaultTypeDefinition(item);
+        if(res == UA_STATUSCODE_GOOD && typeDefinition) {
+            checkTypeCached(server, session, &types, item->nodeClass, typeDefinition);
+            res = types.result;
+            if(res == UA_STATUSCODE_GOOD && types.hasMembers) {
+                const UA_Node *typenode = UA_NodeStore_get(server->nodestore, typeDefinition);
+                res = UA_STATUSCODE_BADTYPEDEFINITIONINVALID;
+                if(typenode)
+                    res = instantiateChildren(server, session, &nodes[i]->nodeId, typenode,
+                                              types.plan, instantiationCallback);
+            }
+        }
+        if(res == UA_STATUSCODE_GOOD)
+            res = UA_NodeId_copy(&nodes[i]->nodeId, &results[i].addedNodeId);
+        if(res != UA_STATUSCODE_GOOD) {
+            removeBatchNode(server, session, nodes[i], &results[i], res, true);
+            continue;
+        }
+        if(instantiationCallback)
+            instantiationCallback->method(nodes[i]->nodeId, typeDefinition ?
+                                          *typeDefinition : item->typeDefinition.nodeId,
+                                          instantiationCallback->handle);
     }
+    deleteTypeCache(server, &types);
+
+    UA_RCU_UNLOCK();
+    UA_free(nodes);
+    UA_free(batch);
+    UA_free(inserted);
+    return retval;
 }
 
 UA_StatusCode
-__UA_Server_addNode(UA_Server *server, const UA_NodeClass nodeClass,
-                    const UA_NodeId requestedNewNodeId, const UA_NodeId parentNodeId,
-                    const UA_NodeId referenceTypeId, const UA_QualifiedName browseName,
-                    const UA_NodeId typeDefinition, const UA_NodeAttributes *attr,
-                    const UA_DataType *attributeType,
-                    UA_InstantiationCallback *instantiationCallback, UA_NodeId *outNewNodeId) {
-    /* prepare the item */
-    UA_AddNodesItem item;
-    UA_AddNodesItem_init(&item);
-    item.parentNodeId.nodeId = parentNodeId;
-    item.referenceTypeId = referenceTypeId;
-    item.requestedNewNodeId.nodeId = requestedNewNodeId;
-    item.browseName = browseName;
-    item.nodeClass = nodeClass;
-    item.typeDefinition.nodeId = typeDefinition;
-    item.nodeAttributes = (UA_ExtensionObject){
-        .encoding = UA_EXTENSIONOBJECT_DECODED_NODELETE,
-        .content.decoded = {attributeType, (void*)(uintptr_t)attr}};
+UA_Server_addNodes(UA_Server *server, const UA_AddNodesItem *items, size_t itemsSize,
+                   UA_InstantiationCallback *instantiationCallback,
+                   UA_AddNodesResult *results) {
+    return addNodes(server, items, itemsSize, false, instantiationCallback, results);
+}
 
-    /* run the service */
-    UA_AddNodesResult result;
-    UA_AddNodesResult_init(&result);
-    UA_RCU_LOCK();
-    Service_AddNodes_single(server, &adminSession, &item, &result, instantiationCallback);
-    UA_RCU_UNLOCK();
+UA_StatusCode
+UA_Server_addNodesMove(UA_Server *server, UA_AddNodesItem *items, size_t itemsSize,
+                       UA_InstantiationCallback *instantiationCallback,
+                       UA_AddNodesResult *results) {
+    UA_StatusCode retval =
+        addNodes(server, items, itemsSize, true, instantiationCallback, results);
 
-    /* prepare the output */
-    if(outNewNodeId && result.statusCode == UA_STATUSCODE_GOOD)
-        *outNewNodeId = result.addedNodeId;
-    else
-        UA_NodeId_deleteMembers(&result.addedNodeId);
-    return result.statusCode;
+    /* Delete what was not moved into the nodes */
+    for(size_t i = 0; i < itemsSize; ++i) {
+        UA_ExtensionObject *attr = &items[i].nodeAttributes;
+        if(attr->encoding >= UA_EXTENSIONOBJECT_DECODED && attr->content.decoded.type &&
+           attr->content.decoded.data)
+            UA_deleteMembers(attr->content.decoded.data, attr->content.decoded.type);
+    }
+    return retval;
 }
 
 /**************************************************/
@@ -22107,8 +27576,8 @@ UA_Server_addDataSourceVariableNode(UA_Server *server, const UA_NodeId requested
     item.browseName = browseName;
     item.typeDefinition.nodeId = typeDefinition;
     item.parentNodeId.nodeId = parentNodeId;
-    retval |= copyStandardAttributes((UA_Node*)node, &item, (const UA_NodeAttributes*)&editAttr);
-    retval |= copyVariableNodeAttributes(server, node, &item, &editAttr);
+    retval |= copyStandardAttributes((UA_Node*)node, &item, (UA_NodeAttributes*)&editAttr, false);
+    retval |= copyVariableNodeAttributes(server, node, &item, &editAttr, false);
     UA_DataValue_deleteMembers(&node->value.data.value);
     node->valueSource = UA_VALUESOURCE_DATASOURCE;
     node->value.dataSource = dataSource;
@@ -22146,7 +27615,7 @@ UA_Server_addMethodNode(UA_Server *server, const UA_NodeId requestedNewNodeId,
     UA_AddNodesItem_init(&item);
     item.requestedNewNodeId.nodeId = requestedNewNodeId;
     item.browseName = browseName;
-    copyStandardAttributes((UA_Node*)node, &item, (const UA_NodeAttributes*)&attr);
+    copyStandardAttributes((UA_Node*)node, &item, (UA_NodeAttributes*)(uintptr_t)&attr, false);
     node->executable = attr.executable;
     node->userExecutable = attr.userExecutable;
     node->attachedMethod = method;
@@ -22243,20 +27712,25 @@ deleteOneWayReference(UA_Server *server, UA_Session *session, UA_Node *node,
 static UA_StatusCode
 addOneWayReference(UA_Server *server, UA_Session *session,
                    UA_Node *node, const UA_AddReferencesItem *item) {
+    if(UA_Node_findReference(node, &item->referenceTypeId, !item->isForward,
+                             &item->targetNodeId.nodeId) < node->referencesSize)
+        return UA_STATUSCODE_BADDUPLICATEREFERENCENOTALLOWED;
+    UA_StatusCode retval = UA_Node_growReferences(node, 1);
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
     size_t i = node->referencesSize;
-    size_t refssize = (i+1) | 3; // so the realloc is not necessary every time
-    UA_ReferenceNode *new_refs = UA_realloc(node->references, sizeof(UA_ReferenceNode) * refssize);
-    if(!new_refs)
-        return UA_STATUSCODE_BADOUTOFMEMORY;
-    node->references = new_refs;
+    UA_ReferenceNode *new_refs = node->references;
     UA_ReferenceNode_init(&new_refs[i]);
-    UA_StatusCode retval = UA_NodeId_copy(&item->referenceTypeId, &new_refs[i].referenceTypeId);
+    retval = UA_NodeId_copy(&item->referenceTypeId, &new_refs[i].referenceTypeId);
     retval |= UA_ExpandedNodeId_copy(&item->targetNodeId, &new_refs[i].targetId);
     new_refs[i].isInverse = !item->isForward;
-    if(retval == UA_STATUSCODE_GOOD)
+    if(retval == UA_STATUSCODE_GOOD) {
         node->referencesSize = i+1;
-    else
+        UA_Node_indexReferences(node, i);
+        UA_Node_nameReferenceTargets(node, server->nodestore);
+    } else {
         UA_ReferenceNode_deleteMembers(&new_refs[i]);
+    }
     return retval;
 }
 
@@ -22267,6 +27741,14 @@ addReference(UA_Server *server, UA_Session *session,
     if(item->targetServerUri.length > 0)
         return UA_STATUSCODE_BADNOTIMPLEMENTED;
 
+    /* Replace registered aliases of the session */
+    UA_AddReferencesItem resolved = *item;
+    resolved.sourceNodeId = *UA_Session_resolveNodeId(session, &item->sourceNodeId);
+    resolved.referenceTypeId = *UA_Session_resolveNodeId(session, &item->referenceTypeId);
+    resolved.targetNodeId.nodeId =
+        *UA_Session_resolveNodeId(session, &item->targetNodeId.nodeId);
+    item = &resolved;
+
     /* Add the first direction */
 #ifndef UA_ENABLE_EXTERNAL_NAMESPACES
     UA_StatusCode retval = UA_Server_editNode(server, session, &item->sourceNodeId,
@@ -22321,6 +27803,11 @@ addReference(UA_Server *server, UA_Session *session,
                                     (UA_EditNodeCallback)addOneWayReference, &secondItem);
 #endif
 
+    /* The second direction is left over when a node was deleted without
+     * deleting the references to it. Then the reference is complete again. */
+    if(retval == UA_STATUSCODE_BADDUPLICATEREFERENCENOTALLOWED)
+        retval = UA_STATUSCODE_GOOD;
+
     /* remove reference if the second direction failed */
     if(retval != UA_STATUSCODE_GOOD) {
         UA_DeleteReferencesItem deleteItem;
@@ -22333,6 +27820,8 @@ addReference(UA_Server *server, UA_Session *session,
         UA_Server_editNode(server, session, &item->sourceNodeId,
                            (UA_EditNodeCallback)deleteOneWayReference, &deleteItem);
     }
+    subtypeReferenceChanged(server, &item->sourceNodeId, &item->referenceTypeId,
+                            item->isForward, &item->targetNodeId.nodeId);
     return retval;
 }
 
@@ -22408,6 +27897,23 @@ UA_Server_addReference(UA_Server *server, const UA_NodeId sourceId,
     return retval;
 }
 
+static UA_StatusCode
+reserveReferences(UA_Server *server, UA_Session *session, UA_Node *node,
+                  const size_t *referencesSize) {
+    return UA_Node_reserveReferences(node, node->referencesSize + *referencesSize);
+}
+
+UA_StatusCode
+UA_Server_reserveReferences(UA_Server *server, const UA_NodeId nodeId,
+                            size_t referencesSize) {
+    UA_RCU_LOCK();
+    UA_StatusCode retval =
+        UA_Server_editNode(server, &adminSession, &nodeId,
+                           (UA_EditNodeCallback)reserveReferences, &referencesSize);
+    UA_RCU_UNLOCK();
+    return retval;
+}
+
 /****************/
 /* Delete Nodes */
 /****************/
@@ -22428,6 +27934,7 @@ removeReferences(UA_Server *server, UA_Session *session, const UA_Node *node) {
 static UA_StatusCode
 deleteNode(UA_Server *server, UA_Session *session,
            const UA_NodeId *nodeId, UA_Boolean deleteReferences) {
+    nodeId = UA_Session_resolveNodeId(session, nodeId);
     const UA_Node *node = UA_NodeStore_get(server->nodestore, nodeId);
     if(!node)
         return UA_STATUSCODE_BADNODEIDUNKNOWN;
@@ -22445,8 +27952,16 @@ deleteNode(UA_Server *server, UA_Session *session,
 
     /* Remove references to the node (not the references in the node that will
      * be deleted anyway) */
-    if(deleteReferences)
+    if(deleteReferences) {
         removeReferences(server, session, node);
+    } else {
+        /* The references into the node remain. But the node no longer
+         * contributes to the subtypes and instantiation plans. */
+        for(size_t i = 0; i < node->referencesSize; ++i)
+            subtypeReferenceChanged(server, nodeId, &node->references[i].referenceTypeId,
+                                    !node->references[i].isInverse,
+                                    &node->references[i].targetId.nodeId);
+    }
 
     return UA_NodeStore_remove(server->nodestore, nodeId);
 }
@@ -22493,39 +28008,31 @@ UA_Server_deleteNode(UA_Server *server, const UA_NodeId nodeId,
 static UA_StatusCode
 deleteOneWayReference(UA_Server *server, UA_Session *session, UA_Node *node,
                       const UA_DeleteReferencesItem *item) {
-    UA_Boolean edited = false;
-    for(size_t i = node->referencesSize; i > 0; --i) {
-        UA_ReferenceNode *ref = &node->references[i-1];
-        if(!UA_NodeId_equal(&item->targetNodeId.nodeId, &ref->targetId.nodeId))
-            continue;
-        if(!UA_NodeId_equal(&item->referenceTypeId, &ref->referenceTypeId))
-            continue;
-        if(item->isForward == ref->isInverse)
-            continue;
-        UA_ReferenceNode_deleteMembers(ref);
-        /* move the last entry to override the current position */
-        node->references[i-1] = node->references[node->referencesSize-1];
-        --node->referencesSize;
-        edited = true;
-        break;
-    }
-    if(!edited)
+    size_t i = UA_Node_findReference(node, &item->referenceTypeId, !item->isForward,
+                                     &item->targetNodeId.nodeId);
+    if(i == node->referencesSize)
         return UA_STATUSCODE_UNCERTAINREFERENCENOTDELETED;
-    /* we removed the last reference */
-    if(node->referencesSize == 0 && node->references) {
-        UA_free(node->references);
-        node->references = NULL;
-    }
-    return UA_STATUSCODE_GOOD;;
+    UA_Node_removeReference(node, i);
+    return UA_STATUSCODE_GOOD;
 }
 
 static UA_StatusCode
 deleteReference(UA_Server *server, UA_Session *session,
                 const UA_DeleteReferencesItem *item) {
+    /* Replace registered aliases of the session */
+    UA_DeleteReferencesItem resolved = *item;
+    resolved.sourceNodeId = *UA_Session_resolveNodeId(session, &item->sourceNodeId);
+    resolved.referenceTypeId = *UA_Session_resolveNodeId(session, &item->referenceTypeId);
+    resolved.targetNodeId.nodeId =
+        *UA_Session_resolveNodeId(session, &item->targetNodeId.nodeId);
+    item = &resolved;
+
     UA_StatusCode retval = UA_Server_editNode(server, session, &item->sourceNodeId,
                                               (UA_EditNodeCallback)deleteOneWayReference, item);
     if(retval != UA_STATUSCODE_GOOD)
         return retval;
+    subtypeReferenceChanged(server, &item->sourceNodeId, &item->referenceTypeId,
+                            item->isForward, &item->targetNodeId.nodeId);
     if(!item->deleteBidirectional || item->targetNodeId.serverIndex != 0)
         return retval;
     UA_DeleteReferencesItem secondItem;
@@ -22614,6 +28121,8 @@ setDataSource(UA_Server *server, UA_Session *session,
         UA_DataValue_deleteMembers(&node->value.data.value);
     node->value.dataSource = *dataSource;
     node->valueSource = UA_VALUESOURCE_DATASOURCE;
+    if(node->valueCache)
+        UA_ValueCache_clear(node->valueCache);
     return UA_STATUSCODE_GOOD;
 }
 
@@ -22627,6 +28136,45 @@ UA_Server_setVariableNode_dataSource(UA_Server *server, const UA_NodeId nodeId,
     return retval;
 }
 
+static UA_StatusCode
+setValueCache(UA_Server *server, UA_Session *session,
+              UA_VariableNode* node, const UA_Double *maxAge) {
+    if(node->nodeClass != UA_NODECLASS_VARIABLE)
+        return UA_STATUSCODE_BADNODECLASSINVALID;
+    return UA_VariableNode_setValueCache(node, *maxAge);
+}
+
+UA_StatusCode
+UA_Server_setVariableNode_valueCache(UA_Server *server, const UA_NodeId nodeId,
+                                     const UA_Double maxAge) {
+    if(maxAge < 0.0 || maxAge != maxAge)
+        return UA_STATUSCODE_BADINVALIDARGUMENT;
+    UA_RCU_LOCK();
+    UA_StatusCode retval = UA_Server_editNode(server, &adminSession, &nodeId,
+                                              (UA_EditNodeCallback)setValueCache, &maxAge);
+    UA_RCU_UNLOCK();
+    return retval;
+}
+
+UA_StatusCode
+UA_Server_getVariableNode_valueCacheStatistics(UA_Server *server, const UA_NodeId nodeId,
+                                               UA_ValueCacheStatistics *statistics) {
+    UA_RCU_LOCK();
+    UA_StatusCode retval = UA_STATUSCODE_GOOD;
+    const UA_VariableNode *vn =
+        (const UA_VariableNode*)UA_NodeStore_get(server->nodestore, &nodeId);
+    if(!vn)
+        retval = UA_STATUSCODE_BADNODEIDUNKNOWN;
+    else if(vn->nodeClass != UA_NODECLASS_VARIABLE)
+        retval = UA_STATUSCODE_BADNODECLASSINVALID;
+    else if(!vn->valueCache)
+        memset(statistics, 0, sizeof(UA_ValueCacheStatistics));
+    else
+        UA_ValueCache_getStatistics(vn->valueCache, statistics);
+    UA_RCU_UNLOCK();
+    return retval;
+}
+
 /****************************/
 /* Set Lifecycle Management */
 /****************************/
@@ -22694,7 +28242,7 @@ UA_Server_setMethodNode_callback(UA_Server *server, const UA_NodeId methodNodeId
 
 
 static UA_StatusCode
-fillReferenceDescription(UA_NodeStore *ns, const UA_Node *curr, UA_ReferenceNode *ref,
+fillReferenceDescription(UA_NodeStore *ns, const UA_Node *curr, const UA_ReferenceNode *ref,
                          UA_UInt32 mask, UA_ReferenceDescription *descr) {
     UA_ReferenceDescription_init(descr);
     UA_StatusCode retval = UA_NodeId_copy(&curr->nodeId, &descr->nodeId.nodeId);
@@ -22706,17 +28254,20 @@ fillReferenceDescription(UA_NodeStore *ns, const UA_Node *curr, UA_ReferenceNode
         retval |= UA_NodeClass_copy(&curr->nodeClass, &descr->nodeClass);
     if(mask & UA_BROWSERESULTMASK_BROWSENAME)
         retval |= UA_QualifiedName_copy(&curr->browseName, &descr->browseName);
-    if(mask & UA_BROWSERESULTMASK_DISPLAYNAME)
-        retval |= UA_LocalizedText_copy(&curr->displayName, &descr->displayName);
+    if(mask & UA_BROWSERESULTMASK_DISPLAYNAME) {
+        UA_LocalizedText displayName;
+        UA_Node_getDisplayName(curr, &displayName);
+        retval |= UA_LocalizedText_copy(&displayName, &descr->displayName);
+    }
     if(mask & UA_BROWSERESULTMASK_TYPEDEFINITION){
         if(curr->nodeClass == UA_NODECLASS_OBJECT || curr->nodeClass == UA_NODECLASS_VARIABLE) {
-            for(size_t i = 0; i < curr->referencesSize; ++i) {
-                UA_ReferenceNode *refnode = &curr->references[i];
-                if(refnode->referenceTypeId.identifier.numeric == UA_NS0ID_HASTYPEDEFINITION) {
-                    retval |= UA_ExpandedNodeId_copy(&refnode->targetId, &descr->typeDefinition);
-                    break;
-                }
-            }
+            const UA_NodeId hasTypeDefinition = UA_NODEID_NUMERIC(0, UA_NS0ID_HASTYPEDEFINITION);
+            UA_ReferenceIterator it;
+            UA_ReferenceIterator_init(&it, curr, UA_BROWSEDIRECTION_FORWARD,
+                                      &hasTypeDefinition, 1);
+            const UA_ReferenceNode *refnode = UA_ReferenceIterator_next(&it);
+            if(refnode)
+                retval |= UA_ExpandedNodeId_copy(&refnode->targetId, &descr->typeDefinition);
         }
     }
     return retval;
@@ -22776,31 +28327,12 @@ returnRelevantNodeExternal(UA_ExternalNodeStore *ens, const UA_BrowseDescription
 }
 #endif
 
-/* Tests if the node is relevant to the browse request and shall be returned. If
-   so, it is retrieved from the Nodestore. If not, null is returned. */
+/* Tests if the target node of a reference with matching direction and type is
+   relevant to the browse request and shall be returned. If so, it is retrieved
+   from the Nodestore. If not, null is returned. */
 static const UA_Node *
-returnRelevantNode(UA_Server *server, const UA_BrowseDescription *descr, UA_Boolean return_all,
-                   const UA_ReferenceNode *reference, const UA_NodeId *relevant, size_t relevant_count,
-                   UA_Boolean *isExternal) {
-    /* reference in the right direction? */
-    if(reference->isInverse && descr->browseDirection == UA_BROWSEDIRECTION_FORWARD)
-        return NULL;
-    if(!reference->isInverse && descr->browseDirection == UA_BROWSEDIRECTION_INVERSE)
-        return NULL;
-
-    /* is the reference part of the hierarchy of references we look for? */
-    if(!return_all) {
-        UA_Boolean is_relevant = false;
-        for(size_t i = 0; i < relevant_count; ++i) {
-            if(UA_NodeId_equal(&reference->referenceTypeId, &relevant[i])) {
-                is_relevant = true;
-                break;
-            }
-        }
-        if(!is_relevant)
-            return NULL;
-    }
-
+returnRelevantNode(UA_Server *server, const UA_BrowseDescription *descr,
+                   const UA_ReferenceNode *reference, UA_Boolean *isExternal) {
 #ifdef UA_ENABLE_EXTERNAL_NAMESPACES
     /* return the node from an external namespace*/
     for(size_t nsIndex = 0; nsIndex < server->externalNamespacesSize; ++nsIndex) {
@@ -22844,13 +28376,10 @@ Service_Browse_single(UA_Server *server, UA_Session *session,
                       struct ContinuationPointEntry *cp, const UA_BrowseDescription *descr,
                       UA_UInt32 maxrefs, UA_BrowseResult *result) { 
     size_t referencesCount = 0;
-    size_t referencesIndex = 0;
     /* set the browsedescription if a cp is given */
-    UA_UInt32 continuationIndex = 0;
     if(cp) {
         descr = &cp->browseDescription;
         maxrefs = cp->maxReferences;
-        continuationIndex = cp->continuationIndex;
     }
 
     /* is the browsedirection valid? */
@@ -22862,8 +28391,7 @@ Service_Browse_single(UA_Server *server, UA_Session *session,
     }
     
     /* get the references that match the browsedescription */
-    size_t relevant_refs_size = 0;
-    UA_NodeId *relevant_refs = NULL;
+    const UA_TypeClosure *relevant_refs = NULL;
     UA_Boolean all_refs = UA_NodeId_isNull(&descr->referenceTypeId);
     if(!all_refs) {
         const UA_Node *rootRef = UA_NodeStore_get(server->nodestore, &descr->referenceTypeId);
@@ -22872,30 +28400,24 @@ Service_Browse_single(UA_Server *server, UA_Session *session,
             return;
         }
         if(descr->includeSubtypes) {
-            result->statusCode = getTypeHierarchy(server->nodestore, rootRef, false,
-                                                  &relevant_refs, &relevant_refs_size);
-            if(result->statusCode != UA_STATUSCODE_GOOD)
+            relevant_refs = getTypeClosure(server, rootRef);
+            if(!relevant_refs) {
+                result->statusCode = UA_STATUSCODE_BADOUTOFMEMORY;
                 return;
-        } else {
-            relevant_refs = (UA_NodeId*)(uintptr_t)&descr->referenceTypeId;
-            relevant_refs_size = 1;
+            }
         }
     }
 
     /* get the node */
-    const UA_Node *node = UA_NodeStore_get(server->nodestore, &descr->nodeId);
+    const UA_Node *node = UA_Server_getSessionNode(server, session, &descr->nodeId);
     if(!node) {
         result->statusCode = UA_STATUSCODE_BADNODEIDUNKNOWN;
-        if(!all_refs && descr->includeSubtypes)
-            UA_Array_delete(relevant_refs, relevant_refs_size, &UA_TYPES[UA_TYPES_NODEID]);
         return;
     }
 
     /* if the node has no references, just return */
     if(node->referencesSize == 0) {
         result->referencesSize = 0;
-        if(!all_refs && descr->includeSubtypes)
-            UA_Array_delete(relevant_refs, relevant_refs_size, &UA_TYPES[UA_TYPES_NODEID]);
         return;
     }
 
@@ -22905,36 +28427,54 @@ Service_Browse_single(UA_Server *server, UA_Session *session,
         real_maxrefs = node->referencesSize;
     else if(real_maxrefs > node->referencesSize)
         real_maxrefs = node->referencesSize;
-    result->references = UA_Array_new(real_maxrefs, &UA_TYPES[UA_TYPES_REFERENCEDESCRIPTION]);
-    if(!result->references) {
-        result->statusCode = UA_STATUSCODE_BADOUTOFMEMORY;
-        goto cleanup;
-    }
 
-    /* loop over the node's references */
-    size_t skipped = 0;
+    /* loop over the node's references with matching direction and type. The
+     * result array grows as needed. Type-filtered browsing of nodes with many
+     * references usually returns few of them. */
+    UA_ReferenceIterator it;
+    if(relevant_refs)
+        UA_ReferenceIterator_initSubtypes(&it, node, descr->browseDirection, relevant_refs);
+    else
+        UA_ReferenceIterator_init(&it, node, descr->browseDirection,
+                                  &descr->referenceTypeId, all_refs ? 0 : 1);
+    if(cp) {
+        it.group = cp->referenceGroup;
+        it.pos = cp->referencePosition;
+    }
+    size_t resultSize = 0;
     UA_Boolean isExternal = false;
     UA_StatusCode retval = UA_STATUSCODE_GOOD;
-    for(; referencesIndex < node->referencesSize && referencesCount < real_maxrefs; ++referencesIndex) {
+    const UA_ReferenceNode *ref;
+    while(referencesCount < real_maxrefs && (ref = UA_ReferenceIterator_next(&it))) {
         isExternal = false;
-        const UA_Node *current =
-            returnRelevantNode(server, descr, all_refs, &node->references[referencesIndex],
-                               relevant_refs, relevant_refs_size, &isExternal);
+        const UA_Node *current = returnRelevantNode(server, descr, ref, &isExternal);
         if(!current)
             continue;
 
-        if(skipped < continuationIndex) {
-            ++skipped;
-        } else {
-            retval |= fillReferenceDescription(server->nodestore, current,
-                                               &node->references[referencesIndex],
-                                               descr->resultMask,
-                                               &result->references[referencesCount]);
-            ++referencesCount;
+        if(referencesCount == resultSize) {
+            size_t newSize = resultSize > 0 ? resultSize * 2 : 8;
+            if(newSize > real_maxrefs)
+                newSize = real_maxrefs;
+            UA_ReferenceDescription *refs =
+                UA_realloc(result->references, newSize * sizeof(UA_ReferenceDescription));
+            if(!refs) {
+                retval = UA_STATUSCODE_BADOUTOFMEMORY;
+                break;
+            }
+            result->references = refs;
+            resultSize = newSize;
         }
+        retval |= fillReferenceDescription(server->nodestore, current, ref,
+                                           descr->resultMask,
+                                           &result->references[referencesCount]);
+        ++referencesCount;
     }
     result->referencesSize = referencesCount;
 
+    /* are there more references to return? */
+    UA_ReferenceIterator peek = it;
+    UA_Boolean done = (UA_ReferenceIterator_next(&peek) == NULL);
+
     if(referencesCount == 0) {
         UA_free(result->references);
         result->references = NULL;
@@ -22949,23 +28489,21 @@ Service_Browse_single(UA_Server *server, UA_Session *session,
         result->statusCode = retval;
     }
 
- cleanup:
-    if(!all_refs && descr->includeSubtypes)
-        UA_Array_delete(relevant_refs, relevant_refs_size, &UA_TYPES[UA_TYPES_NODEID]);
     if(result->statusCode != UA_STATUSCODE_GOOD)
         return;
 
     /* create, update, delete continuation points */
     if(cp) {
-        if(referencesIndex == node->referencesSize) {
+        if(done) {
             /* all done, remove a finished continuationPoint */
             removeCp(cp, session);
         } else {
             /* update the cp and return the cp identifier */
-            cp->continuationIndex += (UA_UInt32)referencesCount;
+            cp->referenceGroup = it.group;
+            cp->referencePosition = it.pos;
             UA_ByteString_copy(&cp->identifier, &result->continuationPoint);
         }
-    } else if(maxrefs != 0 && referencesCount >= maxrefs) {
+    } else if(maxrefs != 0 && referencesCount >= maxrefs && !done) {
         /* create a cp */
         if(session->availableContinuationPoints <= 0 ||
            !(cp = UA_malloc(sizeof(struct ContinuationPointEntry)))) {
@@ -22974,7 +28512,8 @@ Service_Browse_single(UA_Server *server, UA_Session *session,
         }
         UA_BrowseDescription_copy(descr, &cp->browseDescription);
         cp->maxReferences = maxrefs;
-        cp->continuationIndex = (UA_UInt32)referencesCount;
+        cp->referenceGroup = it.group;
+        cp->referencePosition = it.pos;
         UA_Guid *ident = UA_Guid_new();
         *ident = UA_Guid_random();
         cp->identifier.data = (UA_Byte*)ident;
@@ -23044,6 +28583,73 @@ void Service_Browse(UA_Server *server, UA_Session *session, const UA_BrowseReque
     }
 }
 
+/* Large Browse responses are encoded while the nodes are browsed */
+#define UA_BROWSE_STREAMING_MINSIZE 16
+
+typedef struct {
+    UA_Server *server;
+    UA_Session *session;
+    const UA_BrowseRequest *request;
+} UA_BrowseStream;
+
+/* Encodes the BrowseResponse after the ResponseHeader */
+static UA_StatusCode
+streamBrowseResults(const UA_BrowseStream *s, UA_exchangeEncodeBuffer exchangeCallback,
+                    void *exchangeHandle, UA_ByteString *dst, size_t *offset) {
+    const UA_BrowseRequest *request = s->request;
+    UA_Int32 resultsSize = (UA_Int32)request->nodesToBrowseSize;
+    UA_StatusCode retval = UA_encodeBinary(&resultsSize, &UA_TYPES[UA_TYPES_INT32],
+                                           exchangeCallback, exchangeHandle, dst, offset);
+    for(size_t i = 0; i < request->nodesToBrowseSize && retval == UA_STATUSCODE_GOOD; ++i) {
+        UA_BrowseResult result;
+        UA_BrowseResult_init(&result);
+        Service_Browse_single(s->server, s->session, NULL, &request->nodesToBrowse[i],
+                              request->requestedMaxReferencesPerNode, &result);
+        retval = UA_encodeBinary(&result, &UA_TYPES[UA_TYPES_BROWSERESULT],
+                                 exchangeCallback, exchangeHandle, dst, offset);
+        UA_BrowseResult_deleteMembers(&result);
+    }
+    if(retval != UA_STATUSCODE_GOOD)
+        return retval;
+
+    /* No diagnostic infos */
+    UA_Int32 diagnosticInfosSize = -1;
+    return UA_encodeBinary(&diagnosticInfosSize, &UA_TYPES[UA_TYPES_INT32],
+                           exchangeCallback, exchangeHandle, dst, offset);
+}
+
+UA_Boolean
+sendBrowseResponse(UA_Server *server, UA_Session *session, UA_SecureChannel *channel,
+                   UA_UInt32 requestId, const UA_BrowseRequest *request) {
+    /* Requests with an invalid parameter are answered by the Browse service */
+    if(request->nodesToBrowseSize < UA_BROWSE_STREAMING_MINSIZE ||
+       !UA_NodeId_isNull(&request->view.viewId))
+        return false;
+#ifdef UA_ENABLE_EXTERNAL_NAMESPACES
+    if(server->externalNamespacesSize > 0)
+        return false;
+#endif
+
+    UA_LOG_DEBUG_SESSION(server->config.logger, session,
+                         "Processing BrowseRequest as a stream");
+    UA_ResponseHeader responseHeader;
+    UA_ResponseHeader_init(&responseHeader);
+    responseHeader.requestHandle = request->requestHeader.requestHandle;
+    responseHeader.timestamp = UA_DateTime_now();
+    UA_BrowseStream s = {server, session, request};
+    UA_StatusCode retval =
+        UA_SecureChannel_sendCustomResponse(channel, requestId,
+                                            &UA_TYPES[UA_TYPES_BROWSERESPONSE],
+                                            &responseHeader,
+                                            (UA_SecureChannel_encodeBody)streamBrowseResults,
+                                            &s);
+    if(retval != UA_STATUSCODE_GOOD)
+        UA_LOG_INFO_CHANNEL(server->config.logger, channel,
+                            "Could not send the message over the SecureChannel "
+                            "with StatusCode %s", UA_StatusCode_name(retval));
+    return true;
+}
+
 UA_BrowseResult
 UA_Server_browse(UA_Server *server, UA_UInt32 maxrefs, const UA_BrowseDescription *descr) {
     UA_BrowseResult result;
@@ -23110,26 +28716,7 @@ UA_Server_browseNext(UA_Server *server, UA_Boolean releaseContinuationPoint,
 static void
 walkBrowsePathElementNodeReference(UA_BrowsePathResult *result, size_t *targetsSize,
                                    UA_NodeId **next, size_t *nextSize, size_t *nextCount,
-                                   UA_UInt32 elemDepth, UA_Boolean inverse, UA_Boolean all_refs,
-                                   const UA_NodeId *reftypes, size_t reftypes_count,
-                                   const UA_ReferenceNode *reference) {
-    /* Does the direction of the reference match? */
-    if(reference->isInverse != inverse)
-        return;
-
-    /* Is the node relevant? */
-    if(!all_refs) {
-        UA_Boolean match = false;
-        for(size_t j = 0; j < reftypes_count; ++j) {
-            if(UA_NodeId_equal(&reference->referenceTypeId, &reftypes[j])) {
-                match = true;
-                break;
-            }
-        }
-        if(!match)
-            return;
-    }
-
+                                   UA_UInt32 elemDepth, const UA_ReferenceNode *reference) {
     /* Does the reference point to an external server? Then add to the
      * targets with the right path "depth" */
     if(reference->targetId.serverIndex != 0) {
@@ -23169,23 +28756,21 @@ walkBrowsePathElement(UA_Server *server, UA_Session *session,
                       const UA_QualifiedName *targetName,
                       const UA_NodeId *current, const size_t currentCount,
                       UA_NodeId **next, size_t *nextSize, size_t *nextCount) {
-    /* Get the full list of relevant referencetypes for this path element */
-    UA_NodeId *reftypes = NULL;
-    size_t reftypes_count = 1; // all_refs or no subtypes => 1
-    UA_Boolean all_refs = false;
-    if(UA_NodeId_isNull(&elem->referenceTypeId)) {
-        all_refs = true;
-    } else if(!elem->includeSubtypes) {
-        reftypes = (UA_NodeId*)(uintptr_t)&elem->referenceTypeId; // ptr magic due to const cast
-    } else {
+    /* Get the closure of relevant referencetypes for this path element */
+    const UA_TypeClosure *reftypes = NULL;
+    UA_Boolean all_refs = UA_NodeId_isNull(&elem->referenceTypeId);
+    if(!all_refs && elem->includeSubtypes) {
         const UA_Node *rootRef = UA_NodeStore_get(server->nodestore, &elem->referenceTypeId);
         if(!rootRef || rootRef->nodeClass != UA_NODECLASS_REFERENCETYPE)
             return;
-        UA_StatusCode retval =
-            getTypeHierarchy(server->nodestore, rootRef, false, &reftypes, &reftypes_count);
-        if(retval != UA_STATUSCODE_GOOD)
+        reftypes = getTypeClosure(server, rootRef);
+        if(!reftypes) {
+            result->statusCode = UA_STATUSCODE_BADOUTOFMEMORY;
             return;
+        }
     }
+    const UA_BrowseDirection direction =
+        elem->isInverse ? UA_BROWSEDIRECTION_INVERSE : UA_BROWSEDIRECTION_FORWARD;
 
     /* Iterate over all nodes at the current depth-level */
     for(size_t i = 0; i < currentCount; ++i) {
@@ -23204,19 +28789,24 @@ walkBrowsePathElement(UA_Server *server, UA_Session *session,
                           !UA_String_equal(&targetName->name, &node->browseName.name)))
             continue;
 
-        /* Walk over the references in the node */
-        /* Loop over the nodes references */
-        for(size_t r = 0; r < node->referencesSize &&
-                result->statusCode == UA_STATUSCODE_GOOD; ++r) {
-            UA_ReferenceNode *reference = &node->references[r];
+        /* Walk over the references in the node with matching direction and type */
+        UA_ReferenceIterator it;
+        if(reftypes)
+            UA_ReferenceIterator_initSubtypes(&it, node, direction, reftypes);
+        else
+            UA_ReferenceIterator_init(&it, node, direction, &elem->referenceTypeId,
+                                      all_refs ? 0 : 1);
+
+        /* Only visit the children with the target name if the node has an
+         * index over the BrowseNames of its children */
+        if(direction == UA_BROWSEDIRECTION_FORWARD)
+            UA_ReferenceIterator_setTargetName(&it, &elem->targetName);
+        const UA_ReferenceNode *reference;
+        while(result->statusCode == UA_STATUSCODE_GOOD &&
+              (reference = UA_ReferenceIterator_next(&it)))
             walkBrowsePathElementNodeReference(result, targetsSize, next, nextSize, nextCount,
-                                               elemDepth, elem->isInverse, all_refs,
-                                               reftypes, reftypes_count, reference);
-        }
+                                               elemDepth, reference);
     }
-
-    if(!all_refs && elem->includeSubtypes)
-        UA_Array_delete(reftypes, reftypes_count, &UA_TYPES[UA_TYPES_NODEID]);
 }
 
 /* This assumes that result->targets has enough room for all currentCount elements */
@@ -23360,7 +28950,8 @@ translateBrowsePathToNodeIds(UA_Server *server, UA_Session *session,
     }
 
     /* Copy the starting node into current */
-    result->statusCode = UA_NodeId_copy(&path->startingNode, &current[0]);
+    result->statusCode = UA_NodeId_copy(UA_Session_resolveNodeId(session, &path->startingNode),
+                                        &current[0]);
     if(result->statusCode != UA_STATUSCODE_GOOD) {
         UA_free(result->targets);
         UA_free(current);
@@ -23462,26 +29053,47 @@ void Service_TranslateBrowsePathsToNodeIds(UA_Server *server, UA_Session *sessio
 void Service_RegisterNodes(UA_Server *server, UA_Session *session, const UA_RegisterNodesRequest *request,
                            UA_RegisterNodesResponse *response) {
     UA_LOG_DEBUG_SESSION(server->config.logger, session, "Processing RegisterNodesRequest");
-    //TODO: hang the nodeids to the session if really needed
     response->responseHeader.timestamp = UA_DateTime_now();
-    if(request->nodesToRegisterSize <= 0)
+    if(request->nodesToRegisterSize == 0) {
         response->responseHeader.serviceResult = UA_STATUSCODE_BADNOTHINGTODO;
-    else {
-        response->responseHeader.serviceResult =
-            UA_Array_copy(request->nodesToRegister, request->nodesToRegisterSize,
-                          (void**)&response->registeredNodeIds, &UA_TYPES[UA_TYPES_NODEID]);
-        if(response->responseHeader.serviceResult == UA_STATUSCODE_GOOD)
-            response->registeredNodeIdsSize = request->nodesToRegisterSize;
+        return;
+    }
+    response->registeredNodeIds =
+        UA_Array_new(request->nodesToRegisterSize, &UA_TYPES[UA_TYPES_NODEID]);
+    if(!response->registeredNodeIds) {
+        response->responseHeader.serviceResult = UA_STATUSCODE_BADOUTOFMEMORY;
+        return;
+    }
+    response->registeredNodeIdsSize = request->nodesToRegisterSize;
+
+    /* Hand out aliases that are resolved without hashing the NodeId */
+    for(size_t i = 0; i < request->nodesToRegisterSize; ++i) {
+        UA_StatusCode retval =
+            UA_Session_registerNode(session, &request->nodesToRegister[i],
+                                    &response->registeredNodeIds[i]);
+        if(retval != UA_STATUSCODE_GOOD) {
+            for(size_t j = 0; j < i; ++j)
+                UA_Session_unregisterNode(session, &response->registeredNodeIds[j]);
+            UA_Array_delete(response->registeredNodeIds, response->registeredNodeIdsSize,
+                            &UA_TYPES[UA_TYPES_NODEID]);
+            response->registeredNodeIds = NULL;
+            response->registeredNodeIdsSize = 0;
+            response->responseHeader.serviceResult = retval;
+            return;
+        }
     }
 }
 
 void Service_UnregisterNodes(UA_Server *server, UA_Session *session, const UA_UnregisterNodesRequest *request,
                              UA_UnregisterNodesResponse *response) {
     UA_LOG_DEBUG_SESSION(server->config.logger, session, "Processing UnRegisterNodesRequest");
-    //TODO: remove the nodeids from the session if really needed
     response->responseHeader.timestamp = UA_DateTime_now();
-    if(request->nodesToUnregisterSize==0)
+    if(request->nodesToUnregisterSize == 0) {
         response->responseHeader.serviceResult = UA_STATUSCODE_BADNOTHINGTODO;
+        return;
+    }
+    for(size_t i = 0; i < request->nodesToUnregisterSize; ++i)
+        UA_Session_unregisterNode(session, &request->nodesToUnregister[i]);
 }
 
 /*********************************** amalgamated original file "/home/travis/build/open62541/open62541/src/server/ua_services_call.c" ***********************************/
@@ -23497,18 +29109,18 @@ static const UA_VariableNode *
 getArgumentsVariableNode(UA_Server *server, const UA_MethodNode *ofMethod,
                          UA_String withBrowseName) {
     UA_NodeId hasProperty = UA_NODEID_NUMERIC(0, UA_NS0ID_HASPROPERTY);
-    for(size_t i = 0; i < ofMethod->referencesSize; ++i) {
-        if(ofMethod->references[i].isInverse == false &&
-            UA_NodeId_equal(&hasProperty, &ofMethod->references[i].referenceTypeId)) {
-            const UA_Node *refTarget =
-                UA_NodeStore_get(server->nodestore, &ofMethod->references[i].targetId.nodeId);
-            if(!refTarget)
-                continue;
-            if(refTarget->nodeClass == UA_NODECLASS_VARIABLE &&
-                refTarget->browseName.namespaceIndex == 0 &&
-                UA_String_equal(&withBrowseName, &refTarget->browseName.name)) {
-                return (const UA_VariableNode*) refTarget;
-            }
+    UA_ReferenceIterator it;
+    UA_ReferenceIterator_init(&it, (const UA_Node*)ofMethod, UA_BROWSEDIRECTION_FORWARD,
+                              &hasProperty, 1);
+    const UA_ReferenceNode *ref;
+    while((ref = UA_ReferenceIterator_next(&it))) {
+        const UA_Node *refTarget = UA_NodeStore_get(server->nodestore, &ref->targetId.nodeId);
+        if(!refTarget)
+            continue;
+        if(refTarget->nodeClass == UA_NODECLASS_VARIABLE &&
+            refTarget->browseName.namespaceIndex == 0 &&
+            UA_String_equal(&withBrowseName, &refTarget->browseName.name)) {
+            return (const UA_VariableNode*) refTarget;
         }
     }
     return NULL;
@@ -23544,7 +29156,7 @@ Service_Call_single(UA_Server *server, UA_Session *session,
                     UA_CallMethodResult *result) {
     /* Get/verify the method node */
     const UA_MethodNode *methodCalled =
-        (const UA_MethodNode*)UA_NodeStore_get(server->nodestore, &request->methodId);
+        (const UA_MethodNode*)UA_Server_getSessionNode(server, session, &request->methodId);
     if(!methodCalled) {
         result->statusCode = UA_STATUSCODE_BADMETHODINVALID;
         return;
@@ -23560,7 +29172,7 @@ Service_Call_single(UA_Server *server, UA_Session *session,
 
     /* Get/verify the object node */
     const UA_ObjectNode *withObject =
-        (const UA_ObjectNode*)UA_NodeStore_get(server->nodestore, &request->objectId);
+        (const UA_ObjectNode*)UA_Server_getSessionNode(server, session, &request->objectId);
     if(!withObject) {
         result->statusCode = UA_STATUSCODE_BADNODEIDINVALID;
         return;
@@ -23576,12 +29188,11 @@ Service_Call_single(UA_Server *server, UA_Session *session,
      * a hasComponent (or subtype) reference */
     UA_Boolean found = false;
     UA_NodeId hasComponentNodeId = UA_NODEID_NUMERIC(0,UA_NS0ID_HASCOMPONENT);
-    UA_NodeId hasSubTypeNodeId = UA_NODEID_NUMERIC(0,UA_NS0ID_HASSUBTYPE);
     for(size_t i = 0; i < methodCalled->referencesSize; ++i) {
         if(methodCalled->references[i].isInverse &&
            UA_NodeId_equal(&methodCalled->references[i].targetId.nodeId, &withObject->nodeId)) {
-            found = isNodeInTree(server->nodestore, &methodCalled->references[i].referenceTypeId,
-                                 &hasComponentNodeId, &hasSubTypeNodeId, 1);
+            found = isSubtypeOf(server, &methodCalled->references[i].referenceTypeId,
+                                &hasComponentNodeId);
             if(found)
                 break;
         }
@@ -23827,8 +29438,12 @@ void UA_MoniteredItem_SampleCallback(UA_Server *server, UA_MonitoredItem *monito
     rvid.indexRange = monitoredItem->indexRange;
     UA_DataValue value;
     UA_DataValue_init(&value);
+    /* Monitored items of a data source node with a value cache share the
+     * values read within one sampling interval. Accept only values younger
+     * than half the interval. Otherwise a sample job firing slightly early
+     * gets back the value of its own last sample. */
     Service_Read_single(server, sub->session, monitoredItem->timestampsToReturn,
-                        &rvid, &value);
+                        monitoredItem->samplingInterval / 2.0, &rvid, &value);
 
     /* Stack-allocate some memory for the value encoding */
     UA_Byte *stackValueEncoding = UA_alloca(UA_VALUENCODING_MAXSTACK);
@@ -24489,7 +30104,7 @@ Service_CreateMonitoredItems_single(UA_Server *server, UA_Session *session,
      * be repaired inside the data source. */
     UA_DataValue v;
     UA_DataValue_init(&v);
-    Service_Read_single(server, session, timestampsToReturn, &request->itemToMonitor, &v);
+    Service_Read_single(server, session, timestampsToReturn, 0.0, &request->itemToMonitor, &v);
     if(v.hasStatus && (v.status >> 30) > 1 &&
        v.status != UA_STATUSCODE_BADRESOURCEUNAVAILABLE &&
        v.status != UA_STATUSCODE_BADCOMMUNICATIONERROR &&
@@ -24521,8 +30136,10 @@ Service_CreateMonitoredItems_single(UA_Server *server, UA_Session *session,
         result->statusCode = UA_STATUSCODE_BADOUTOFMEMORY;
         return;
     }
-    UA_StatusCode retval = UA_NodeId_copy(&request->itemToMonitor.nodeId,
-                                          &newMon->monitoredNodeId);
+    /* Registered nodes are monitored under their original NodeId */
+    UA_StatusCode retval =
+        UA_NodeId_copy(UA_Session_resolveNodeId(session, &request->itemToMonitor.nodeId),
+                       &newMon->monitoredNodeId);
     if(retval != UA_STATUSCODE_GOOD) {
         result->statusCode = retval;
         MonitoredItem_delete(server, newMon);
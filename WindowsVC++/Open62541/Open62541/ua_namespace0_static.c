@@ -0,0 +1,1045 @@
+/* Generated by gen_namespace0.c. Do not edit. */
+
+#ifdef UA_ENABLE_MULTITHREADING
+# error The constant namespace 0 requires the single-threaded nodestore
+#endif
+
+static const UA_ReferenceNode ns0_array0[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array1[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array2[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 28u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array3[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array4[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 28u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array5[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array6[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 28u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array7[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array8[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 28u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array9[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 26u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array10[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 26u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array11[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array12[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array13[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array14[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array15[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array16[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array17[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array18[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array19[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array20[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array21[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 862u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 338u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array22[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array23[17] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 1u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 26u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 12u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 13u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 14u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 15u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 16u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 17u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 18u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 19u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 20u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 21u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 22u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 23u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 25u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 29u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 90u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array24[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array25[4] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 10u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 11u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array26[6] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 26u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 4u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 6u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 8u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 28u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array27[5] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 5u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 7u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 9u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array28[2] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 852u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array29[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 33u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 91u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array30[11] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 31u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 37u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 38u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 39u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 41u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 50u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 51u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 52u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 53u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 54u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array31[4] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 31u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 34u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 36u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array32[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 33u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 44u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array33[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 33u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array34[2] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 33u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 48u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array35[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array36[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array37[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array38[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array39[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array40[4] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 34u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 46u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 47u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 56u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array41[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 34u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array42[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 44u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array43[2] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 44u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 49u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array44[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 36u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array45[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 47u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array46[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array47[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array48[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array49[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array50[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array51[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 44u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array52[6] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 77u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2004u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2020u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2013u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 88u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array53[10] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 84u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 85u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 91u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 90u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 89u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 88u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3048u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 87u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array54[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 63u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 68u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 89u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array55[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 62u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3051u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2138u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array56[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 62u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array57[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 78u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 80u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array58[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 77u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array59[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 77u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array60[4] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 85u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 87u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array61[2] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 84u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array62[7] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 84u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 91u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 90u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 89u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 88u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3048u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array63[2] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 84u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array64[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array65[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 62u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array66[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array67[3] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 31u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array68[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 22u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array69[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 29u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array70[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 22u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array71[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array72[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array73[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array74[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 63u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array75[2] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, {0, NULL}, 0u}},
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, false, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, {0, NULL}, 0u}},
+};
+
+static const UA_ReferenceNode ns0_array76[1] = {
+    {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, true, {{.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 63u}, {0, NULL}, 0u}},
+};
+
+static const struct {
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n1;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n2;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n3;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n4;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n5;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n6;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n7;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n8;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n9;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n10;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n11;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n12;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n13;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n14;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n15;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n16;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n17;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n18;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n19;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n20;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n21;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n22;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n23;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n24;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n25;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n26;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n27;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n28;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n29;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n31;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n32;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n33;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n34;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n35;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n36;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n37;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n38;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n39;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n40;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n41;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n44;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n45;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n46;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n47;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n48;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n49;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n50;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n51;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n52;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n53;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n54;
+    struct { UA_NodeStoreEntry *orig; UA_ReferenceTypeNode node; } n56;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectTypeNode node; } n58;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectTypeNode node; } n61;
+    struct { UA_NodeStoreEntry *orig; UA_VariableTypeNode node; } n62;
+    struct { UA_NodeStoreEntry *orig; UA_VariableTypeNode node; } n63;
+    struct { UA_NodeStoreEntry *orig; UA_VariableTypeNode node; } n68;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectTypeNode node; } n77;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n78;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n80;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n84;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n85;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n86;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n87;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n88;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n89;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n90;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n91;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n338;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n852;
+    struct { UA_NodeStoreEntry *orig; UA_DataTypeNode node; } n862;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectTypeNode node; } n2004;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectTypeNode node; } n2013;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectTypeNode node; } n2020;
+    struct { UA_NodeStoreEntry *orig; UA_VariableTypeNode node; } n2138;
+    struct { UA_NodeStoreEntry *orig; UA_ObjectNode node; } n3048;
+    struct { UA_NodeStoreEntry *orig; UA_VariableTypeNode node; } n3051;
+} ns0Nodes = {
+    .n1 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 1u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {7, (UA_Byte*)"Boolean"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"Boolean"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"Boolean"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array0,
+        .isAbstract = false}},
+    .n2 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {5, (UA_Byte*)"SByte"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"SByte"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"SByte"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array1,
+        .isAbstract = false}},
+    .n3 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {4, (UA_Byte*)"Byte"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {4, (UA_Byte*)"Byte"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {4, (UA_Byte*)"Byte"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array2,
+        .isAbstract = false}},
+    .n4 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 4u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {5, (UA_Byte*)"Int16"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Int16"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Int16"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array3,
+        .isAbstract = false}},
+    .n5 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 5u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"UInt16"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"UInt16"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"UInt16"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array4,
+        .isAbstract = false}},
+    .n6 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 6u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {5, (UA_Byte*)"Int32"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Int32"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Int32"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array5,
+        .isAbstract = false}},
+    .n7 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 7u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"UInt32"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"UInt32"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"UInt32"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array6,
+        .isAbstract = false}},
+    .n8 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 8u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {5, (UA_Byte*)"Int64"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Int64"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Int64"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array7,
+        .isAbstract = false}},
+    .n9 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 9u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"UInt64"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"UInt64"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"UInt64"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array8,
+        .isAbstract = false}},
+    .n10 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 10u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {5, (UA_Byte*)"Float"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Float"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Float"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array9,
+        .isAbstract = false}},
+    .n11 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 11u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"Double"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"Double"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"Double"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array10,
+        .isAbstract = false}},
+    .n12 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 12u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"String"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"String"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"String"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array11,
+        .isAbstract = false}},
+    .n13 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 13u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {8, (UA_Byte*)"DateTime"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"DateTime"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"DateTime"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array12,
+        .isAbstract = false}},
+    .n14 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 14u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {4, (UA_Byte*)"Guid"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {4, (UA_Byte*)"Guid"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {4, (UA_Byte*)"Guid"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array13,
+        .isAbstract = false}},
+    .n15 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 15u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {10, (UA_Byte*)"ByteString"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"ByteString"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"ByteString"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array14,
+        .isAbstract = false}},
+    .n16 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 16u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {10, (UA_Byte*)"XmlElement"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"XmlElement"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"XmlElement"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array15,
+        .isAbstract = false}},
+    .n17 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 17u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"NodeId"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"NodeId"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"NodeId"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array16,
+        .isAbstract = false}},
+    .n18 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 18u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {14, (UA_Byte*)"ExpandedNodeId"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"ExpandedNodeId"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"ExpandedNodeId"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array17,
+        .isAbstract = false}},
+    .n19 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 19u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {10, (UA_Byte*)"StatusCode"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"StatusCode"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"StatusCode"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array18,
+        .isAbstract = false}},
+    .n20 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 20u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {13, (UA_Byte*)"QualifiedName"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"QualifiedName"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"QualifiedName"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array19,
+        .isAbstract = false}},
+    .n21 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 21u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {13, (UA_Byte*)"LocalizedText"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"LocalizedText"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"LocalizedText"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array20,
+        .isAbstract = false}},
+    .n22 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 22u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {9, (UA_Byte*)"Structure"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"Structure"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"Structure"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array21,
+        .isAbstract = true}},
+    .n23 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 23u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {9, (UA_Byte*)"DataValue"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"DataValue"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"DataValue"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array22,
+        .isAbstract = false}},
+    .n24 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {12, (UA_Byte*)"BaseDataType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"BaseDataType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"BaseDataType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 17, .references = (UA_ReferenceNode*)ns0_array23,
+        .isAbstract = true}},
+    .n25 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 25u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {14, (UA_Byte*)"DiagnosticInfo"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"DiagnosticInfo"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"DiagnosticInfo"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array24,
+        .isAbstract = false}},
+    .n26 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 26u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {6, (UA_Byte*)"Number"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"Number"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {6, (UA_Byte*)"Number"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 4, .references = (UA_ReferenceNode*)ns0_array25,
+        .isAbstract = true}},
+    .n27 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 27u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {7, (UA_Byte*)"Integer"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"Integer"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"Integer"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 6, .references = (UA_ReferenceNode*)ns0_array26,
+        .isAbstract = true}},
+    .n28 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 28u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {8, (UA_Byte*)"UInteger"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"UInteger"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"UInteger"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 5, .references = (UA_ReferenceNode*)ns0_array27,
+        .isAbstract = true}},
+    .n29 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 29u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {11, (UA_Byte*)"Enumeration"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"Enumeration"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"Enumeration"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 2, .references = (UA_ReferenceNode*)ns0_array28,
+        .isAbstract = true}},
+    .n31 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 31u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {10, (UA_Byte*)"References"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"References"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"References"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array29,
+        .isAbstract = true, .symmetric = true, .inverseName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"References"}}}},
+    .n32 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 32u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {25, (UA_Byte*)"NonHierarchicalReferences"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {25, (UA_Byte*)"NonHierarchicalReferences"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {25, (UA_Byte*)"NonHierarchicalReferences"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 11, .references = (UA_ReferenceNode*)ns0_array30,
+        .isAbstract = true, .symmetric = false, .inverseName = {{0, NULL}, {0, NULL}}}},
+    .n33 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 33u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {22, (UA_Byte*)"HierarchicalReferences"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {22, (UA_Byte*)"HierarchicalReferences"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {22, (UA_Byte*)"HierarchicalReferences"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 4, .references = (UA_ReferenceNode*)ns0_array31,
+        .isAbstract = true, .symmetric = false, .inverseName = {{0, NULL}, {0, NULL}}}},
+    .n34 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 34u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {8, (UA_Byte*)"HasChild"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"HasChild"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"HasChild"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array32,
+        .isAbstract = false, .symmetric = false, .inverseName = {{0, NULL}, {0, NULL}}}},
+    .n35 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 35u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {9, (UA_Byte*)"Organizes"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"Organizes"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"Organizes"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array33,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"OrganizedBy"}}}},
+    .n36 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 36u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {14, (UA_Byte*)"HasEventSource"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"HasEventSource"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"HasEventSource"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 2, .references = (UA_ReferenceNode*)ns0_array34,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"EventSourceOf"}}}},
+    .n37 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 37u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {16, (UA_Byte*)"HasModellingRule"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"HasModellingRule"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"HasModellingRule"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array35,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {15, (UA_Byte*)"ModellingRuleOf"}}}},
+    .n38 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 38u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {11, (UA_Byte*)"HasEncoding"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"HasEncoding"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"HasEncoding"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array36,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"EncodingOf"}}}},
+    .n39 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 39u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {14, (UA_Byte*)"HasDescription"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"HasDescription"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"HasDescription"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array37,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"DescriptionOf"}}}},
+    .n40 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 40u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {17, (UA_Byte*)"HasTypeDefinition"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {17, (UA_Byte*)"HasTypeDefinition"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {17, (UA_Byte*)"HasTypeDefinition"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array38,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"TypeDefinitionOf"}}}},
+    .n41 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 41u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {14, (UA_Byte*)"GeneratesEvent"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"GeneratesEvent"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"GeneratesEvent"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array39,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"GeneratedBy"}}}},
+    .n44 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 44u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {10, (UA_Byte*)"Aggregates"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"Aggregates"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"Aggregates"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 4, .references = (UA_ReferenceNode*)ns0_array40,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"AggregatedBy"}}}},
+    .n45 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 45u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {10, (UA_Byte*)"HasSubtype"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"HasSubtype"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"HasSubtype"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array41,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"HasSupertype"}}}},
+    .n46 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 46u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {11, (UA_Byte*)"HasProperty"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"HasProperty"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"HasProperty"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array42,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"PropertyOf"}}}},
+    .n47 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 47u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {12, (UA_Byte*)"HasComponent"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"HasComponent"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"HasComponent"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 2, .references = (UA_ReferenceNode*)ns0_array43,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"ComponentOf"}}}},
+    .n48 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 48u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {11, (UA_Byte*)"HasNotifier"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"HasNotifier"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"HasNotifier"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array44,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"NotifierOf"}}}},
+    .n49 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 49u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {19, (UA_Byte*)"HasOrderedComponent"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {19, (UA_Byte*)"HasOrderedComponent"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {19, (UA_Byte*)"HasOrderedComponent"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array45,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {18, (UA_Byte*)"OrderedComponentOf"}}}},
+    .n50 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 50u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {14, (UA_Byte*)"HasModelParent"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"HasModelParent"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"HasModelParent"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array46,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"ModelParentOf"}}}},
+    .n51 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 51u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {9, (UA_Byte*)"FromState"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"FromState"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"FromState"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array47,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"ToTransition"}}}},
+    .n52 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 52u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {7, (UA_Byte*)"ToState"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"ToState"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"ToState"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array48,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"FromTransition"}}}},
+    .n53 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 53u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {8, (UA_Byte*)"HasCause"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"HasCause"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"HasCause"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array49,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"MayBeCausedBy"}}}},
+    .n54 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 54u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {9, (UA_Byte*)"HasEffect"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"HasEffect"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"HasEffect"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array50,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {15, (UA_Byte*)"MayBeEffectedBy"}}}},
+    .n56 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 56u}, .nodeClass = UA_NODECLASS_REFERENCETYPE,
+        .browseName = {0, {26, (UA_Byte*)"HasHistoricalConfiguration"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {26, (UA_Byte*)"HasHistoricalConfiguration"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {26, (UA_Byte*)"HasHistoricalConfiguration"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array51,
+        .isAbstract = false, .symmetric = false, .inverseName = {{5, (UA_Byte*)"en_US"}, {25, (UA_Byte*)"HistoricalConfigurationOf"}}}},
+    .n58 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 58u}, .nodeClass = UA_NODECLASS_OBJECTTYPE,
+        .browseName = {0, {14, (UA_Byte*)"BaseObjectType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"BaseObjectType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"BaseObjectType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 6, .references = (UA_ReferenceNode*)ns0_array52,
+        .isAbstract = false}},
+    .n61 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 61u}, .nodeClass = UA_NODECLASS_OBJECTTYPE,
+        .browseName = {0, {10, (UA_Byte*)"FolderType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"FolderType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"FolderType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 10, .references = (UA_ReferenceNode*)ns0_array53,
+        .isAbstract = false}},
+    .n62 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 62u}, .nodeClass = UA_NODECLASS_VARIABLETYPE,
+        .browseName = {0, {16, (UA_Byte*)"BaseVariableType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"BaseVariableType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"BaseVariableType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array54,
+        .dataType = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, .valueRank = -2, .arrayDimensionsSize = 0, .arrayDimensions = NULL,
+        .valueSource = UA_VALUESOURCE_DATA, .value.data.value = {.hasValue = 0, .hasStatus = 0, .hasSourceTimestamp = 0, .hasServerTimestamp = 0, .hasSourcePicoseconds = 0, .hasServerPicoseconds = 0, .value = {.type = NULL}, .status = 0x00000000u, .sourceTimestamp = 0, .sourcePicoseconds = 0, .serverTimestamp = 0, .serverPicoseconds = 0},
+        .isAbstract = true}},
+    .n63 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 63u}, .nodeClass = UA_NODECLASS_VARIABLETYPE,
+        .browseName = {0, {20, (UA_Byte*)"BaseDataVariableType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {20, (UA_Byte*)"BaseDataVariableType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {20, (UA_Byte*)"BaseDataVariableType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array55,
+        .dataType = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, .valueRank = -2, .arrayDimensionsSize = 0, .arrayDimensions = NULL,
+        .valueSource = UA_VALUESOURCE_DATA, .value.data.value = {.hasValue = 0, .hasStatus = 0, .hasSourceTimestamp = 0, .hasServerTimestamp = 0, .hasSourcePicoseconds = 0, .hasServerPicoseconds = 0, .value = {.type = NULL}, .status = 0x00000000u, .sourceTimestamp = 0, .sourcePicoseconds = 0, .serverTimestamp = 0, .serverPicoseconds = 0},
+        .isAbstract = false}},
+    .n68 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 68u}, .nodeClass = UA_NODECLASS_VARIABLETYPE,
+        .browseName = {0, {12, (UA_Byte*)"PropertyType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"PropertyType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {12, (UA_Byte*)"PropertyType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array56,
+        .dataType = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 24u}, .valueRank = -2, .arrayDimensionsSize = 0, .arrayDimensions = NULL,
+        .valueSource = UA_VALUESOURCE_DATA, .value.data.value = {.hasValue = 0, .hasStatus = 0, .hasSourceTimestamp = 0, .hasServerTimestamp = 0, .hasSourcePicoseconds = 0, .hasServerPicoseconds = 0, .value = {.type = NULL}, .status = 0x00000000u, .sourceTimestamp = 0, .sourcePicoseconds = 0, .serverTimestamp = 0, .serverPicoseconds = 0},
+        .isAbstract = false}},
+    .n77 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 77u}, .nodeClass = UA_NODECLASS_OBJECTTYPE,
+        .browseName = {0, {17, (UA_Byte*)"ModellingRuleType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {17, (UA_Byte*)"ModellingRuleType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {17, (UA_Byte*)"ModellingRuleType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array57,
+        .isAbstract = false}},
+    .n78 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 78u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {9, (UA_Byte*)"Mandatory"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"Mandatory"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"Mandatory"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array58,
+        .eventNotifier = 0}},
+    .n80 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 80u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {8, (UA_Byte*)"Optional"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"Optional"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {8, (UA_Byte*)"Optional"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array59,
+        .eventNotifier = 0}},
+    .n84 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 84u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {4, (UA_Byte*)"Root"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {4, (UA_Byte*)"Root"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {4, (UA_Byte*)"Root"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 4, .references = (UA_ReferenceNode*)ns0_array60,
+        .eventNotifier = 0}},
+    .n85 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 85u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {7, (UA_Byte*)"Objects"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"Objects"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {7, (UA_Byte*)"Objects"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 2, .references = (UA_ReferenceNode*)ns0_array61,
+        .eventNotifier = 0}},
+    .n86 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 86u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {5, (UA_Byte*)"Types"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Types"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Types"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 7, .references = (UA_ReferenceNode*)ns0_array62,
+        .eventNotifier = 0}},
+    .n87 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 87u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {5, (UA_Byte*)"Views"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Views"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {5, (UA_Byte*)"Views"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 2, .references = (UA_ReferenceNode*)ns0_array63,
+        .eventNotifier = 0}},
+    .n88 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 88u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {11, (UA_Byte*)"ObjectTypes"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"ObjectTypes"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"ObjectTypes"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array64,
+        .eventNotifier = 0}},
+    .n89 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 89u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {13, (UA_Byte*)"VariableTypes"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"VariableTypes"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"VariableTypes"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array65,
+        .eventNotifier = 0}},
+    .n90 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 90u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {9, (UA_Byte*)"DataTypes"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"DataTypes"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"DataTypes"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array66,
+        .eventNotifier = 0}},
+    .n91 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 91u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {14, (UA_Byte*)"ReferenceTypes"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"ReferenceTypes"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {14, (UA_Byte*)"ReferenceTypes"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 3, .references = (UA_ReferenceNode*)ns0_array67,
+        .eventNotifier = 0}},
+    .n338 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 338u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {9, (UA_Byte*)"BuildInfo"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"BuildInfo"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {9, (UA_Byte*)"BuildInfo"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array68,
+        .isAbstract = false}},
+    .n852 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 852u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {11, (UA_Byte*)"ServerState"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"ServerState"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {11, (UA_Byte*)"ServerState"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array69,
+        .isAbstract = false}},
+    .n862 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 862u}, .nodeClass = UA_NODECLASS_DATATYPE,
+        .browseName = {0, {20, (UA_Byte*)"ServerStatusDataType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {20, (UA_Byte*)"ServerStatusDataType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {20, (UA_Byte*)"ServerStatusDataType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array70,
+        .isAbstract = false}},
+    .n2004 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2004u}, .nodeClass = UA_NODECLASS_OBJECTTYPE,
+        .browseName = {0, {10, (UA_Byte*)"ServerType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"ServerType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"ServerType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array71,
+        .isAbstract = false}},
+    .n2013 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2013u}, .nodeClass = UA_NODECLASS_OBJECTTYPE,
+        .browseName = {0, {22, (UA_Byte*)"ServerCapatilitiesType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {22, (UA_Byte*)"ServerCapatilitiesType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {22, (UA_Byte*)"ServerCapatilitiesType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array72,
+        .isAbstract = false}},
+    .n2020 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2020u}, .nodeClass = UA_NODECLASS_OBJECTTYPE,
+        .browseName = {0, {21, (UA_Byte*)"ServerDiagnosticsType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {21, (UA_Byte*)"ServerDiagnosticsType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {21, (UA_Byte*)"ServerDiagnosticsType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array73,
+        .isAbstract = false}},
+    .n2138 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 2138u}, .nodeClass = UA_NODECLASS_VARIABLETYPE,
+        .browseName = {0, {16, (UA_Byte*)"ServerStatusType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"ServerStatusType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {16, (UA_Byte*)"ServerStatusType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array74,
+        .dataType = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 862u}, .valueRank = -1, .arrayDimensionsSize = 0, .arrayDimensions = NULL,
+        .valueSource = UA_VALUESOURCE_DATA, .value.data.value = {.hasValue = 0, .hasStatus = 0, .hasSourceTimestamp = 0, .hasServerTimestamp = 0, .hasSourcePicoseconds = 0, .hasServerPicoseconds = 0, .value = {.type = NULL}, .status = 0x00000000u, .sourceTimestamp = 0, .sourcePicoseconds = 0, .serverTimestamp = 0, .serverPicoseconds = 0},
+        .isAbstract = false}},
+    .n3048 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3048u}, .nodeClass = UA_NODECLASS_OBJECT,
+        .browseName = {0, {10, (UA_Byte*)"EventTypes"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"EventTypes"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {10, (UA_Byte*)"EventTypes"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 2, .references = (UA_ReferenceNode*)ns0_array75,
+        .eventNotifier = 0}},
+    .n3051 = {NULL, {.nodeId = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 3051u}, .nodeClass = UA_NODECLASS_VARIABLETYPE,
+        .browseName = {0, {13, (UA_Byte*)"BuildInfoType"}},
+        .displayName = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"BuildInfoType"}},
+        .description = {{5, (UA_Byte*)"en_US"}, {13, (UA_Byte*)"BuildInfoType"}},
+        .writeMask = 0u, .userWriteMask = 0u, .referencesSize = 1, .references = (UA_ReferenceNode*)ns0_array76,
+        .dataType = {.namespaceIndex = 0, .identifierType = UA_NODEIDTYPE_NUMERIC, .identifier.numeric = 338u}, .valueRank = -1, .arrayDimensionsSize = 0, .arrayDimensions = NULL,
+        .valueSource = UA_VALUESOURCE_DATA, .value.data.value = {.hasValue = 0, .hasStatus = 0, .hasSourceTimestamp = 0, .hasServerTimestamp = 0, .hasSourcePicoseconds = 0, .hasServerPicoseconds = 0, .value = {.type = NULL}, .status = 0x00000000u, .sourceTimestamp = 0, .sourcePicoseconds = 0, .serverTimestamp = 0, .serverPicoseconds = 0},
+        .isAbstract = false}},
+};
+
+static const UA_Node * const ns0NodeList[77] = {
+    (const UA_Node*)&ns0Nodes.n1.node,
+    (const UA_Node*)&ns0Nodes.n2.node,
+    (const UA_Node*)&ns0Nodes.n3.node,
+    (const UA_Node*)&ns0Nodes.n4.node,
+    (const UA_Node*)&ns0Nodes.n5.node,
+    (const UA_Node*)&ns0Nodes.n6.node,
+    (const UA_Node*)&ns0Nodes.n7.node,
+    (const UA_Node*)&ns0Nodes.n8.node,
+    (const UA_Node*)&ns0Nodes.n9.node,
+    (const UA_Node*)&ns0Nodes.n10.node,
+    (const UA_Node*)&ns0Nodes.n11.node,
+    (const UA_Node*)&ns0Nodes.n12.node,
+    (const UA_Node*)&ns0Nodes.n13.node,
+    (const UA_Node*)&ns0Nodes.n14.node,
+    (const UA_Node*)&ns0Nodes.n15.node,
+    (const UA_Node*)&ns0Nodes.n16.node,
+    (const UA_Node*)&ns0Nodes.n17.node,
+    (const UA_Node*)&ns0Nodes.n18.node,
+    (const UA_Node*)&ns0Nodes.n19.node,
+    (const UA_Node*)&ns0Nodes.n20.node,
+    (const UA_Node*)&ns0Nodes.n21.node,
+    (const UA_Node*)&ns0Nodes.n22.node,
+    (const UA_Node*)&ns0Nodes.n23.node,
+    (const UA_Node*)&ns0Nodes.n24.node,
+    (const UA_Node*)&ns0Nodes.n25.node,
+    (const UA_Node*)&ns0Nodes.n26.node,
+    (const UA_Node*)&ns0Nodes.n27.node,
+    (const UA_Node*)&ns0Nodes.n28.node,
+    (const UA_Node*)&ns0Nodes.n29.node,
+    (const UA_Node*)&ns0Nodes.n31.node,
+    (const UA_Node*)&ns0Nodes.n32.node,
+    (const UA_Node*)&ns0Nodes.n33.node,
+    (const UA_Node*)&ns0Nodes.n34.node,
+    (const UA_Node*)&ns0Nodes.n35.node,
+    (const UA_Node*)&ns0Nodes.n36.node,
+    (const UA_Node*)&ns0Nodes.n37.node,
+    (const UA_Node*)&ns0Nodes.n38.node,
+    (const UA_Node*)&ns0Nodes.n39.node,
+    (const UA_Node*)&ns0Nodes.n40.node,
+    (const UA_Node*)&ns0Nodes.n41.node,
+    (const UA_Node*)&ns0Nodes.n44.node,
+    (const UA_Node*)&ns0Nodes.n45.node,
+    (const UA_Node*)&ns0Nodes.n46.node,
+    (const UA_Node*)&ns0Nodes.n47.node,
+    (const UA_Node*)&ns0Nodes.n48.node,
+    (const UA_Node*)&ns0Nodes.n49.node,
+    (const UA_Node*)&ns0Nodes.n50.node,
+    (const UA_Node*)&ns0Nodes.n51.node,
+    (const UA_Node*)&ns0Nodes.n52.node,
+    (const UA_Node*)&ns0Nodes.n53.node,
+    (const UA_Node*)&ns0Nodes.n54.node,
+    (const UA_Node*)&ns0Nodes.n56.node,
+    (const UA_Node*)&ns0Nodes.n58.node,
+    (const UA_Node*)&ns0Nodes.n61.node,
+    (const UA_Node*)&ns0Nodes.n62.node,
+    (const UA_Node*)&ns0Nodes.n63.node,
+    (const UA_Node*)&ns0Nodes.n68.node,
+    (const UA_Node*)&ns0Nodes.n77.node,
+    (const UA_Node*)&ns0Nodes.n78.node,
+    (const UA_Node*)&ns0Nodes.n80.node,
+    (const UA_Node*)&ns0Nodes.n84.node,
+    (const UA_Node*)&ns0Nodes.n85.node,
+    (const UA_Node*)&ns0Nodes.n86.node,
+    (const UA_Node*)&ns0Nodes.n87.node,
+    (const UA_Node*)&ns0Nodes.n88.node,
+    (const UA_Node*)&ns0Nodes.n89.node,
+    (const UA_Node*)&ns0Nodes.n90.node,
+    (const UA_Node*)&ns0Nodes.n91.node,
+    (const UA_Node*)&ns0Nodes.n338.node,
+    (const UA_Node*)&ns0Nodes.n852.node,
+    (const UA_Node*)&ns0Nodes.n862.node,
+    (const UA_Node*)&ns0Nodes.n2004.node,
+    (const UA_Node*)&ns0Nodes.n2013.node,
+    (const UA_Node*)&ns0Nodes.n2020.node,
+    (const UA_Node*)&ns0Nodes.n2138.node,
+    (const UA_Node*)&ns0Nodes.n3048.node,
+    (const UA_Node*)&ns0Nodes.n3051.node,
+};
+
+static UA_StatusCode
+addStaticNamespace0(UA_NodeStore *ns) {
+    return UA_NodeStore_insertConst(ns, &ns0Nodes, sizeof(ns0Nodes),
+                                    ns0NodeList, 77);
+}